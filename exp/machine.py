@@ -18,6 +18,7 @@ import numpy as np
 import re
 import shutil
 import datetime
+import itertools
 
 matplotlib.use('Agg')
 import pylab
@@ -192,12 +193,24 @@ CACHING_TYPE_FIFO = 1
 CACHING_TYPE_LRU = 2
 CACHING_TYPE_LFU = 3
 CACHING_TYPE_ARC = 4
+CACHING_TYPE_CLOCK = 5
+CACHING_TYPE_CLOCK_PRO = 6
+CACHING_TYPE_WTINYLFU = 7
+CACHING_TYPE_LIRS = 8
+CACHING_TYPE_2Q = 9
+CACHING_TYPE_GREEDY_DUAL = 10
 
 CACHING_TYPES_STRINGS = {
     1 : "fifo",
     2 : "lru",
     3 : "lfu",
     4 : "arc",
+    5 : "clock",
+    6 : "clock-pro",
+    7 : "w-tinylfu",
+    8 : "lirs",
+    9 : "2q",
+    10 : "greedy-dual",
 }
 
 CACHING_TYPES = [
@@ -207,6 +220,19 @@ CACHING_TYPES = [
 #    CACHING_TYPE_ARC
 ]
 
+## DEVICE TYPES
+DEVICE_TYPE_CACHE = 1
+DEVICE_TYPE_DRAM = 2
+DEVICE_TYPE_NVM = 3
+DEVICE_TYPE_SSD = 4
+
+DEVICE_TYPES_STRINGS = {
+    1 : "cache",
+    2 : "dram",
+    3 : "nvm",
+    4 : "ssd",
+}
+
 ## TRACE TYPES
 TRACE_TYPE_TPCC = 1
 
@@ -242,10 +268,12 @@ DEFAULT_OPERATION_COUNT = 100000 * SCALE_FACTOR
 ## EXPERIMENTS
 LATENCY_EXPERIMENT = 1
 SIZE_EXPERIMENT = 2
+POLICY_EXPERIMENT = 3
 
 ## EVAL DIRS
 LATENCY_DIR = BASE_DIR + "/results/latency"
 SIZE_DIR = BASE_DIR + "/results/size"
+POLICY_DIR = BASE_DIR + "/results/policy"
 
 ## PLOT DIRS
 LEGEND_PLOT_DIR = BASE_DIR + "/images/legend/"
@@ -268,10 +296,21 @@ SIZE_EXP_SIZE_TYPES = SIZE_TYPES
 SIZE_EXP_LATENCY_TYPES = [DEFAULT_LATENCY_TYPE]
 SIZE_EXP_CACHING_TYPES = [DEFAULT_CACHING_TYPE]
 
+## POLICY EXPERIMENT
+POLICY_EXP_TRACE_TYPES = [DEFAULT_TRACE_TYPE]
+POLICY_EXP_HIERARCHY_TYPES = [HIERARCHY_TYPE_DRAM_NVM, HIERARCHY_TYPE_DRAM_NVM_SSD]
+POLICY_EXP_SIZE_TYPES = [DEFAULT_SIZE_TYPE]
+POLICY_EXP_LATENCY_TYPES = [DEFAULT_LATENCY_TYPE]
+POLICY_EXP_TIERS = [DEVICE_TYPE_DRAM, DEVICE_TYPE_NVM]
+POLICY_EXP_CACHING_TYPES = [CACHING_TYPE_FIFO, CACHING_TYPE_LRU, CACHING_TYPE_LFU, CACHING_TYPE_ARC,
+                            CACHING_TYPE_CLOCK, CACHING_TYPE_CLOCK_PRO, CACHING_TYPE_WTINYLFU,
+                            CACHING_TYPE_LIRS, CACHING_TYPE_2Q, CACHING_TYPE_GREEDY_DUAL]
+
 ## CSV FILES
 
 LATENCY_CSV = "latency.csv"
 SIZE_CSV = "size.csv"
+POLICY_CSV = "policy.csv"
 
 ###################################################################################
 # UTILS
@@ -735,6 +774,78 @@ def size_eval():
                         write_stat(result_file, size_type, stat)
 
 
+# POLICY -- EVAL
+def policy_eval():
+
+    # CLEAN UP RESULT DIR
+    clean_up_dir(POLICY_DIR)
+    LOG.info("POLICY EVAL")
+
+    # Every combination of per-tier caching types
+    policy_mixes = list(itertools.product(POLICY_EXP_CACHING_TYPES,
+                                          repeat=len(POLICY_EXP_TIERS)))
+
+    # ETA
+    l1 = len(POLICY_EXP_TRACE_TYPES)
+    l2 = len(POLICY_EXP_SIZE_TYPES)
+    l3 = len(POLICY_EXP_LATENCY_TYPES)
+    l4 = len(POLICY_EXP_HIERARCHY_TYPES)
+    l5 = len(policy_mixes)
+    print_eta(l1, l2, l3, l4, l5)
+
+    for trace_type in POLICY_EXP_TRACE_TYPES:
+        LOG.info(MAJOR_STRING)
+
+        for size_type in POLICY_EXP_SIZE_TYPES:
+            LOG.info(MINOR_STRING)
+
+            for latency_type in POLICY_EXP_LATENCY_TYPES:
+                LOG.info(SUB_MINOR_STRING)
+
+                for hierarchy_type in POLICY_EXP_HIERARCHY_TYPES:
+
+                    # Get result file
+                    result_dir_list = [TRACE_TYPES_STRINGS[trace_type],
+                                       str(size_type),
+                                       str(latency_type),
+                                       HIERARCHY_TYPES_STRINGS[hierarchy_type]]
+                    result_file = get_result_file(POLICY_DIR, result_dir_list, POLICY_CSV)
+
+                    best_mix = None
+                    best_stat = 0
+
+                    for policy_mix in policy_mixes:
+                        tier_caching_types = dict(zip(POLICY_EXP_TIERS, policy_mix))
+                        mix_string = "-".join(DEVICE_TYPES_STRINGS[tier] + ":" +
+                                              CACHING_TYPES_STRINGS[tier_caching_types[tier]]
+                                              for tier in POLICY_EXP_TIERS)
+
+                        LOG.info(" > trace_type: " + TRACE_TYPES_STRINGS[trace_type] +
+                              " size_type: " + str(size_type) +
+                              " latency_type: " + str(latency_type) +
+                              " hierarchy_type: " + HIERARCHY_TYPES_STRINGS[hierarchy_type] +
+                              " policy_mix: " + mix_string +
+                              "\n"
+                        )
+
+                        # Run experiment
+                        stat = run_experiment(stat_offset=THROUGHPUT_OFFSET,
+                                              trace_type=trace_type,
+                                              hierarchy_type=hierarchy_type,
+                                              latency_type=latency_type,
+                                              size_type=size_type,
+                                              tier_caching_types=tier_caching_types)
+
+                        # Write stat
+                        write_stat(result_file, mix_string, stat)
+
+                        if best_mix is None or stat > best_stat:
+                            best_mix = mix_string
+                            best_stat = stat
+
+                    LOG.info("BEST POLICY MIX: " + best_mix +
+                             " (" + str(best_stat) + " ops/s)")
+
 ###################################################################################
 # TEST
 ###################################################################################
@@ -780,7 +891,8 @@ def run_experiment(
     size_type=DEFAULT_SIZE_TYPE,
     caching_type=DEFAULT_CACHING_TYPE,
     trace_type=DEFAULT_TRACE_TYPE,
-    migration_frequency=DEFAULT_MIGRATION_FREQUENCY):
+    migration_frequency=DEFAULT_MIGRATION_FREQUENCY,
+    tier_caching_types=None):
 
     # subprocess.call(["rm -f " + OUTPUT_FILE], shell=True)
     PROGRAM_OUTPUT_FILE_NAME = "machine.txt"
@@ -794,6 +906,11 @@ def run_experiment(
                     "-m", str(migration_frequency),
                     "-o", str(DEFAULT_OPERATION_COUNT)
                 ]
+
+    # Caching type of each tier (size type capacity)
+    for tier in sorted(tier_caching_types or {}):
+        arg_list += ["--tier", str(tier) + ":" + str(tier_caching_types[tier]) + ":0"]
+
     arg_string = ' '.join(arg_list[0:])
     LOG.info(arg_string)
 
@@ -833,6 +950,7 @@ if __name__ == '__main__':
     evaluation_group = parser.add_argument_group('evaluation_group')
     evaluation_group.add_argument("-a", "--latency_eval", help="eval latency", action='store_true')
     evaluation_group.add_argument("-b", "--size_eval", help="eval size", action='store_true')
+    evaluation_group.add_argument("-c", "--policy_eval", help="eval per-tier policy mixes", action='store_true')
 
     ## PLOTTING GROUP
     plotting_group = parser.add_argument_group('plotting_group')
@@ -849,6 +967,9 @@ if __name__ == '__main__':
     if args.size_eval:
         size_eval()
 
+    if args.policy_eval:
+        policy_eval()
+
     ## PLOTTING GROUP
 
     if args.latency_plot:
@@ -22,7 +22,8 @@ namespace machine {
 CACHE_TEMPLATE_ARGUMENT
 CACHE_TEMPLATE_TYPE::Cache(size_t capacity)
 : cache_policy_(Policy(capacity)),
-  capacity_{capacity} {
+  capacity_{capacity},
+  stream_table_() {
 
   PL_ASSERT(capacity_ > 0);
 
@@ -45,6 +46,7 @@ Block CACHE_TEMPLATE_TYPE::Put(const Key& key,
       victim_key = cache_policy_.Victim(key);
       DLOG(INFO) << "Victim: " << victim_key;
       victim_value = Get(victim_key, false);
+      cache_policy_.Evict(victim_key);
       Erase(victim_key);
     }
 
@@ -100,10 +102,23 @@ void CACHE_TEMPLATE_TYPE::Insert(const Key& key,
                                  const Value& value) {
 
   cache_policy_.Insert(key);
+  cache_policy_.SetStatus(key, static_cast<size_t>(value));
   cache_items_map.emplace(std::make_pair(key, value));
 
 }
 
+CACHE_TEMPLATE_ARGUMENT
+void CACHE_TEMPLATE_TYPE::GetKeys(std::vector<Key>& keys) const {
+
+  operation_guard{cache_mutex_};
+
+  keys.reserve(keys.size() + cache_items_map.size());
+  for(auto& cache_item : cache_items_map){
+    keys.push_back(cache_item.first);
+  }
+
+}
+
 CACHE_TEMPLATE_ARGUMENT
 void CACHE_TEMPLATE_TYPE::Erase(const Key& key) {
 
@@ -117,6 +132,7 @@ void CACHE_TEMPLATE_TYPE::Update(const Key& key,
                                  const Value& value) {
 
   cache_policy_.Touch(key);
+  cache_policy_.SetStatus(key, static_cast<size_t>(value));
   cache_items_map[key] = value;
 
 }
@@ -147,22 +163,62 @@ void CACHE_TEMPLATE_TYPE::Print() const {
 
 }
 
+CACHE_TEMPLATE_ARGUMENT
+void CACHE_TEMPLATE_TYPE::SetEvictionCost(const uint64_t& clean_cost,
+                                          const uint64_t& dirty_cost) {
+
+  operation_guard{cache_mutex_};
+  cache_policy_.SetEvictionCost(clean_cost, dirty_cost);
+
+}
+
 CACHE_TEMPLATE_ARGUMENT
 bool CACHE_TEMPLATE_TYPE::IsSequential(const size_t& next) {
 
   bool status = false;
-  size_t distance = abs(current_block_ - next);
-  DLOG(INFO) << "CURRENT: " << current_block_ << " NEXT: " << next << "\n";
+  auto stream = stream_table_.Access(next, status);
+  DLOG(INFO) << "STREAM: " << stream << " NEXT: " << next << "\n";
+
+  return status;
+}
+
+CACHE_TEMPLATE_ARGUMENT
+void CACHE_TEMPLATE_TYPE::Serialize(std::vector<uint64_t>& buffer) const {
 
-  if(distance == 1){
-    status = true;
+  operation_guard{cache_mutex_};
+
+  stream_table_.Serialize(buffer);
+  buffer.push_back(cache_items_map.size());
+  for(auto& cache_item : cache_items_map){
+    buffer.push_back(static_cast<uint64_t>(cache_item.first));
+    buffer.push_back(static_cast<uint64_t>(cache_item.second));
   }
-  else {
-    status = false;
+
+  cache_policy_.Serialize(buffer);
+
+}
+
+CACHE_TEMPLATE_ARGUMENT
+void CACHE_TEMPLATE_TYPE::Deserialize(const uint64_t*& cursor,
+                                      const uint64_t* end) {
+
+  operation_guard{cache_mutex_};
+
+  stream_table_.Deserialize(cursor, end);
+  CheckSnapshotSize(cursor, end, 1);
+  auto entry_count = *cursor++;
+  CheckSnapshotSize(cursor, end, entry_count, 2);
+
+  cache_items_map.clear();
+  cache_items_map.reserve(entry_count);
+  for(uint64_t entry_itr = 0; entry_itr < entry_count; entry_itr++){
+    auto key = static_cast<Key>(*cursor++);
+    auto value = static_cast<Value>(*cursor++);
+    cache_items_map.emplace(key, value);
   }
 
-  current_block_ = next;
-  return status;
+  cache_policy_.Deserialize(cursor, end);
+
 }
 
 // Instantiations
@@ -179,5 +235,23 @@ template class Cache<int, int, FIFOCachePolicy<int>>;
 // ARC
 template class Cache<int, int, ARCCachePolicy<int>>;
 
+// CLOCK
+template class Cache<int, int, CLOCKCachePolicy<int>>;
+
+// CLOCK-PRO
+template class Cache<int, int, CLOCKProCachePolicy<int>>;
+
+// W-TINYLFU
+template class Cache<int, int, WTinyLFUCachePolicy<int>>;
+
+// LIRS
+template class Cache<int, int, LIRSCachePolicy<int>>;
+
+// 2Q
+template class Cache<int, int, TwoQCachePolicy<int>>;
+
+// GREEDY-DUAL
+template class Cache<int, int, GreedyDualCachePolicy<int>>;
+
 }  // End machine namespace
 
@@ -0,0 +1,80 @@
+// CHECKPOINT SOURCE
+
+#include <algorithm>
+#include <iomanip>
+
+#include "checkpoint.h"
+
+namespace machine {
+
+void CheckpointTracker::RecordCheckpoint(const double& start_time,
+                                         const double& end_time,
+                                         const size_t& block_count){
+
+  auto duration = end_time - start_time;
+
+  end_time_ = std::max(end_time_, end_time);
+  checkpoint_count_++;
+  block_count_ += block_count;
+  total_duration_ += duration;
+  max_duration_ = std::max(max_duration_, duration);
+
+}
+
+void CheckpointTracker::RecordLatency(const double& issue_time,
+                                      const double& latency){
+
+  if(issue_time < end_time_){
+    overlap_count_++;
+    overlap_latency_ += latency;
+  }
+  else {
+    other_count_++;
+    other_latency_ += latency;
+  }
+
+}
+
+size_t CheckpointTracker::GetCheckpointCount() const {
+  return checkpoint_count_;
+}
+
+void CheckpointTracker::ResetStats(){
+  checkpoint_count_ = 0;
+  block_count_ = 0;
+  total_duration_ = 0;
+  max_duration_ = 0;
+  overlap_count_ = 0;
+  overlap_latency_ = 0;
+  other_count_ = 0;
+  other_latency_ = 0;
+}
+
+std::ostream& operator<< (std::ostream& os,
+                          const CheckpointTracker& checkpointer){
+
+  auto checkpoint_count = std::max<size_t>(checkpointer.checkpoint_count_, 1);
+  auto overlap_count = std::max<size_t>(checkpointer.overlap_count_, 1);
+  auto other_count = std::max<size_t>(checkpointer.other_count_, 1);
+
+  os << "CHECKPOINTS: \n";
+  os << std::setw(10) << "COUNT" << " :: "
+      << checkpointer.checkpoint_count_ << "\n";
+  os << std::setw(10) << "BLOCKS" << " :: "
+      << checkpointer.block_count_ << "\n";
+  os << std::setw(10) << "MEAN" << " :: "
+      << checkpointer.total_duration_ / checkpoint_count << " ns\n";
+  os << std::setw(10) << "MAX" << " :: "
+      << checkpointer.max_duration_ << " ns\n";
+  os << "FOREGROUND (ops, mean latency ns): \n";
+  os << std::setw(10) << "DURING" << " :: "
+      << checkpointer.overlap_count_ << " "
+      << checkpointer.overlap_latency_ / overlap_count << "\n";
+  os << std::setw(10) << "OUTSIDE" << " :: "
+      << checkpointer.other_count_ << " "
+      << checkpointer.other_latency_ / other_count << "\n";
+
+  return os;
+}
+
+}  // End machine namespace
@@ -1,12 +1,17 @@
 // CONFIGURATION SOURCE
 
 #include <algorithm>
+#include <fstream>
 #include <iomanip>
 #include <mutex>
+#include <set>
+#include <sstream>
 
 #include "configuration.h"
 #include "cache.h"
 #include "device.h"
+#include "wear.h"
+#include "stream_table.h"
 
 namespace machine {
 
@@ -21,10 +26,96 @@ void Usage() {
       "   -f --file_name                      :  file name\n"
       "   -m --migration_frequency            :  migration frequency\n"
       "   -o --operation_count                :  operation count\n"
-      "   -v --verbose                        :  verbose\n";
+      "   -w --warmup_ops                     :  warm-up operation count\n"
+      "      --config_file                    :  file of options, one per line\n"
+      "      --tier                           :  device:caching type:blocks\n"
+      "      --topology                       :  file of tiers, top first\n"
+      "      --inclusion_type                 :  1 inclusive, 2 exclusive\n"
+      "      --clients                        :  concurrent clients\n"
+      "      --device_model                   :  device:channels:MB/s:queue depth\n"
+      "      --ftl_overprovisioning           :  SSD spare capacity (0 is no FTL)\n"
+      "      --ftl_block_pages                :  pages per SSD erase block\n"
+      "      --nvm_endurance                  :  writes per NVM cell\n"
+      "      --nvm_wear_threshold             :  NVM writes before moving to DRAM\n"
+      "      --readahead                      :  max readahead window (blocks)\n"
+      "      --streams                        :  sequential streams per tier\n"
+      "      --dram_promotion                 :  accesses before moving to DRAM\n"
+      "      --cache_promotion                :  accesses before moving to CACHE\n"
+      "      --promotion_window               :  accesses per promotion window\n"
+      "      --migration_queue                :  background migrations in flight\n"
+      "      --migration_bandwidth            :  background migration MB/s\n"
+      "      --flush_interval                 :  operations between flusher runs\n"
+      "      --flush_high_watermark           :  dirty ratio that starts flushing\n"
+      "      --flush_low_watermark            :  dirty ratio flushing stops at\n"
+      "      --checkpoint_interval            :  operations between checkpoints\n"
+      "      --log_device                     :  log device (0 is no log)\n"
+      "      --log_commit_interval            :  group commit delay (ns)\n"
+      "      --log_record_size                :  bytes per log record\n"
+      "      --rebalance_epoch                :  operations per rebalancing epoch\n"
+      "      --rebalance_budget               :  blocks migrated per epoch\n"
+      "   -v --verbose                        :  verbose\n"
+      "   -g --generator                      :  synthesize workload\n"
+      "      --read_ratio                     :  read ratio\n"
+      "      --scan_ratio                     :  scan ratio (of reads)\n"
+      "      --flush_ratio                    :  flush ratio (of updates)\n"
+      "      --key_count                      :  record count\n"
+      "      --zipf_theta                     :  zipf theta\n"
+      "      --records_per_page               :  records per page\n"
+      "      --scan_length                    :  records per scan\n"
+      "      --insert_ratio                   :  insert ratio (of writes)\n"
+      "      --key_distribution               :  key distribution\n"
+      "      --hot_set_ratio                  :  hotspot key fraction\n"
+      "      --hot_operation_ratio            :  hotspot operation fraction\n"
+      "      --save_snapshot                  :  snapshot file to write\n"
+      "      --snapshot_operation             :  operation to snapshot after\n"
+      "      --load_snapshot                  :  snapshot file to resume from\n";
   exit(EXIT_FAILURE);
 }
 
+// Long-only options
+enum LongOption {
+  OPTION_READ_RATIO = 256,
+  OPTION_SCAN_RATIO,
+  OPTION_FLUSH_RATIO,
+  OPTION_KEY_COUNT,
+  OPTION_ZIPF_THETA,
+  OPTION_RECORDS_PER_PAGE,
+  OPTION_SCAN_LENGTH,
+  OPTION_INSERT_RATIO,
+  OPTION_KEY_DISTRIBUTION,
+  OPTION_HOT_SET_RATIO,
+  OPTION_HOT_OPERATION_RATIO,
+  OPTION_SAVE_SNAPSHOT,
+  OPTION_SNAPSHOT_OPERATION,
+  OPTION_LOAD_SNAPSHOT,
+  OPTION_CLIENTS,
+  OPTION_DEVICE_MODEL,
+  OPTION_CONFIG_FILE,
+  OPTION_TIER,
+  OPTION_TOPOLOGY,
+  OPTION_INCLUSION_TYPE,
+  OPTION_FTL_OVERPROVISIONING,
+  OPTION_FTL_BLOCK_PAGES,
+  OPTION_NVM_ENDURANCE,
+  OPTION_NVM_WEAR_THRESHOLD,
+  OPTION_READAHEAD,
+  OPTION_STREAMS,
+  OPTION_DRAM_PROMOTION,
+  OPTION_CACHE_PROMOTION,
+  OPTION_PROMOTION_WINDOW,
+  OPTION_MIGRATION_QUEUE,
+  OPTION_MIGRATION_BANDWIDTH,
+  OPTION_FLUSH_INTERVAL,
+  OPTION_FLUSH_HIGH_WATERMARK,
+  OPTION_FLUSH_LOW_WATERMARK,
+  OPTION_CHECKPOINT_INTERVAL,
+  OPTION_LOG_DEVICE,
+  OPTION_LOG_COMMIT_INTERVAL,
+  OPTION_LOG_RECORD_SIZE,
+  OPTION_REBALANCE_EPOCH,
+  OPTION_REBALANCE_BUDGET
+};
+
 static struct option opts[] = {
     {"hierarchy_type", optional_argument, NULL, 'a'},
     {"size_type", optional_argument, NULL, 's'},
@@ -33,12 +124,59 @@ static struct option opts[] = {
     {"file_name", optional_argument, NULL, 'f'},
     {"migration_frequency", optional_argument, NULL, 'm'},
     {"operation_count", optional_argument, NULL, 'o'},
+    {"warmup_ops", required_argument, NULL, 'w'},
+    {"clients", required_argument, NULL, OPTION_CLIENTS},
+    {"device_model", required_argument, NULL, OPTION_DEVICE_MODEL},
+    {"config_file", required_argument, NULL, OPTION_CONFIG_FILE},
+    {"tier", required_argument, NULL, OPTION_TIER},
+    {"topology", required_argument, NULL, OPTION_TOPOLOGY},
+    {"inclusion_type", required_argument, NULL, OPTION_INCLUSION_TYPE},
+    {"ftl_overprovisioning", required_argument, NULL, OPTION_FTL_OVERPROVISIONING},
+    {"ftl_block_pages", required_argument, NULL, OPTION_FTL_BLOCK_PAGES},
+    {"nvm_endurance", required_argument, NULL, OPTION_NVM_ENDURANCE},
+    {"nvm_wear_threshold", required_argument, NULL, OPTION_NVM_WEAR_THRESHOLD},
+    {"readahead", required_argument, NULL, OPTION_READAHEAD},
+    {"streams", required_argument, NULL, OPTION_STREAMS},
+    {"dram_promotion", required_argument, NULL, OPTION_DRAM_PROMOTION},
+    {"cache_promotion", required_argument, NULL, OPTION_CACHE_PROMOTION},
+    {"promotion_window", required_argument, NULL, OPTION_PROMOTION_WINDOW},
+    {"migration_queue", required_argument, NULL, OPTION_MIGRATION_QUEUE},
+    {"migration_bandwidth", required_argument, NULL, OPTION_MIGRATION_BANDWIDTH},
+    {"flush_interval", required_argument, NULL, OPTION_FLUSH_INTERVAL},
+    {"flush_high_watermark", required_argument, NULL, OPTION_FLUSH_HIGH_WATERMARK},
+    {"flush_low_watermark", required_argument, NULL, OPTION_FLUSH_LOW_WATERMARK},
+    {"checkpoint_interval", required_argument, NULL, OPTION_CHECKPOINT_INTERVAL},
+    {"log_device", required_argument, NULL, OPTION_LOG_DEVICE},
+    {"log_commit_interval", required_argument, NULL, OPTION_LOG_COMMIT_INTERVAL},
+    {"log_record_size", required_argument, NULL, OPTION_LOG_RECORD_SIZE},
+    {"rebalance_epoch", required_argument, NULL, OPTION_REBALANCE_EPOCH},
+    {"rebalance_budget", required_argument, NULL, OPTION_REBALANCE_BUDGET},
     {"verbose", optional_argument, NULL, 'v'},
+    {"generator", no_argument, NULL, 'g'},
+    {"read_ratio", required_argument, NULL, OPTION_READ_RATIO},
+    {"scan_ratio", required_argument, NULL, OPTION_SCAN_RATIO},
+    {"flush_ratio", required_argument, NULL, OPTION_FLUSH_RATIO},
+    {"key_count", required_argument, NULL, OPTION_KEY_COUNT},
+    {"zipf_theta", required_argument, NULL, OPTION_ZIPF_THETA},
+    {"records_per_page", required_argument, NULL, OPTION_RECORDS_PER_PAGE},
+    {"scan_length", required_argument, NULL, OPTION_SCAN_LENGTH},
+    {"insert_ratio", required_argument, NULL, OPTION_INSERT_RATIO},
+    {"key_distribution", required_argument, NULL, OPTION_KEY_DISTRIBUTION},
+    {"hot_set_ratio", required_argument, NULL, OPTION_HOT_SET_RATIO},
+    {"hot_operation_ratio", required_argument, NULL, OPTION_HOT_OPERATION_RATIO},
+    {"save_snapshot", required_argument, NULL, OPTION_SAVE_SNAPSHOT},
+    {"snapshot_operation", required_argument, NULL, OPTION_SNAPSHOT_OPERATION},
+    {"load_snapshot", required_argument, NULL, OPTION_LOAD_SNAPSHOT},
     {NULL, 0, NULL, 0}
 };
 
 static void ValidateHierarchyType(const configuration &state) {
-  if (state.hierarchy_type < 1 || state.hierarchy_type > 4) {
+  if (state.hierarchy_type == HIERARCHY_TYPE_TOPOLOGY &&
+      state.topology.empty() == false) {
+    printf("%30s : %s\n", "caching_type",
+           HierarchyTypeToString(state.hierarchy_type).c_str());
+  }
+  else if (state.hierarchy_type < 1 || state.hierarchy_type > 4) {
     printf("Invalid hierarchy_type :: %d\n", state.hierarchy_type);
     exit(EXIT_FAILURE);
   }
@@ -60,7 +198,8 @@ static void ValidateSizeType(const configuration &state) {
 }
 
 static void ValidateCachingType(const configuration &state) {
-  if (state.caching_type < 1 || state.caching_type > 4) {
+  if (state.caching_type <= CACHING_TYPE_INVALID ||
+      state.caching_type > CACHING_TYPE_MAX) {
     printf("Invalid caching_type :: %d\n", state.caching_type);
     exit(EXIT_FAILURE);
   }
@@ -97,12 +236,361 @@ static void ValidateNVMWriteLatency(const configuration &state){
   printf("%30s : %lu\n", "nvm_write_latency", state.nvm_write_latency);
 }
 
+static void ValidateRatio(const char *name, const double &ratio) {
+  if (ratio < 0 || ratio > 1) {
+    printf("Invalid %s :: %lf\n", name, ratio);
+    exit(EXIT_FAILURE);
+  }
+  else {
+    printf("%30s : %.2lf\n", name, ratio);
+  }
+}
+
+static void ValidateGenerator(configuration &state){
+  if(state.generator_mode == false) {
+    return;
+  }
+
+  printf("%30s : %d\n", "generator", state.generator_mode);
+  ValidateRatio("read_ratio", state.read_ratio);
+  ValidateRatio("scan_ratio", state.scan_ratio);
+  ValidateRatio("flush_ratio", state.flush_ratio);
+  ValidateRatio("insert_ratio", state.insert_ratio);
+
+  if (state.distribution_type < 1 || state.distribution_type > 4) {
+    printf("Invalid key_distribution :: %d\n", state.distribution_type);
+    exit(EXIT_FAILURE);
+  }
+  printf("%30s : %s\n", "key_distribution",
+         DistributionTypeToString(state.distribution_type).c_str());
+
+  if (state.distribution_type == DISTRIBUTION_TYPE_HOTSPOT) {
+    ValidateRatio("hot_set_ratio", state.hot_set_ratio);
+    ValidateRatio("hot_operation_ratio", state.hot_operation_ratio);
+  }
+
+  if (state.key_count == 0 || state.records_per_page == 0) {
+    printf("Invalid key_count :: %lu records_per_page :: %lu\n",
+           state.key_count, state.records_per_page);
+    exit(EXIT_FAILURE);
+  }
+  printf("%30s : %lu\n", "key_count", state.key_count);
+  printf("%30s : %lu\n", "records_per_page", state.records_per_page);
+
+  if (state.zipf_theta < 0) {
+    printf("Invalid zipf_theta :: %lf\n", state.zipf_theta);
+    exit(EXIT_FAILURE);
+  }
+  printf("%30s : %.2lf\n", "zipf_theta", state.zipf_theta);
+  printf("%30s : %lu\n", "scan_length", state.scan_length);
+
+  // Synthetic stream never ends
+  if (state.operation_count == 0) {
+    state.operation_count = 1000 * 1000;
+  }
+}
+
+static void ValidateSnapshot(const configuration &state){
+  if(state.save_snapshot_file.empty() == false) {
+    if(state.snapshot_operation == 0) {
+      printf("Invalid snapshot_operation :: %lu\n", state.snapshot_operation);
+      exit(EXIT_FAILURE);
+    }
+    printf("%30s : %s\n", "save_snapshot", state.save_snapshot_file.c_str());
+    printf("%30s : %lu\n", "snapshot_operation", state.snapshot_operation);
+  }
+
+  if(state.load_snapshot_file.empty() == false) {
+    printf("%30s : %s\n", "load_snapshot", state.load_snapshot_file.c_str());
+  }
+}
+
 static void ValidateOperationCount(const configuration &state){
   if(state.operation_count > 0) {
     printf("%30s : %lu\n", "operation_count", state.operation_count);
   }
 }
 
+static void ValidateClientCount(const configuration &state){
+  if(state.client_count == 0) {
+    printf("Invalid clients :: %lu\n", state.client_count);
+    exit(EXIT_FAILURE);
+  }
+  else {
+    printf("%30s : %lu\n", "clients", state.client_count);
+  }
+}
+
+static void ParseDeviceModel(configuration &state, const char* spec){
+  int device_type = 0;
+  DeviceServiceModel model;
+
+  if(sscanf(spec, "%d:%lu:%lf:%lu",
+            &device_type,
+            &model.channel_count,
+            &model.bandwidth,
+            &model.queue_depth) != 4) {
+    printf("Invalid device_model :: %s\n", spec);
+    exit(EXIT_FAILURE);
+  }
+
+  state.service_models[(DeviceType) device_type] = model;
+}
+
+static void ValidateDeviceModels(const configuration &state){
+  for(auto& entry : state.service_models){
+    auto device_type = entry.first;
+    auto& model = entry.second;
+    auto declared_type = (device_type >= DEVICE_TYPE_CUSTOM &&
+        device_type < DEVICE_TYPE_CUSTOM + (int) state.topology.size());
+    if(device_type <= DEVICE_TYPE_INVALID ||
+        (device_type > DEVICE_TYPE_SSD && declared_type == false) ||
+        model.channel_count == 0 ||
+        model.bandwidth < 0) {
+      printf("Invalid device_model :: %d\n", device_type);
+      exit(EXIT_FAILURE);
+    }
+    else {
+      printf("%30s : %s %lu channels %.0f MB/s %lu queue depth\n",
+             "device_model",
+             DeviceTypeToString(device_type).c_str(),
+             model.channel_count,
+             model.bandwidth,
+             model.queue_depth);
+    }
+  }
+}
+
+static void ParseTierModel(configuration &state, const char* spec){
+  int device_type = 0;
+  int caching_type = 0;
+  TierModel model;
+
+  if(sscanf(spec, "%d:%d:%lu",
+            &device_type,
+            &caching_type,
+            &model.size) != 3) {
+    printf("Invalid tier :: %s\n", spec);
+    exit(EXIT_FAILURE);
+  }
+
+  model.caching_type = (CachingType) caching_type;
+  state.tier_models[(DeviceType) device_type] = model;
+}
+
+// Caching type of a tier, the global one unless the tier overrides it
+static CachingType GetTierCachingType(const configuration &state,
+                                      const DeviceType& device_type){
+  auto tier_itr = state.tier_models.find(device_type);
+  if(tier_itr == state.tier_models.end()){
+    return state.caching_type;
+  }
+  return tier_itr->second.caching_type;
+}
+
+static void ValidateTierModels(const configuration &state){
+  auto last_device_type = GetLastDevice(state.hierarchy_type);
+
+  if(state.tier_models.empty() == false && state.topology.empty() == false) {
+    printf("Invalid tier :: set the tiers in the topology file\n");
+    exit(EXIT_FAILURE);
+  }
+
+  for(auto& entry : state.tier_models){
+    auto device_type = entry.first;
+    auto& model = entry.second;
+    if(device_type <= DEVICE_TYPE_INVALID ||
+        device_type > DEVICE_TYPE_SSD ||
+        model.caching_type <= CACHING_TYPE_INVALID ||
+        model.caching_type > CACHING_TYPE_MAX) {
+      printf("Invalid tier :: %d\n", device_type);
+      exit(EXIT_FAILURE);
+    }
+    // The last device holds every block
+    else if(device_type == last_device_type && model.size != 0) {
+      printf("Invalid tier :: %s is the last device\n",
+             DeviceTypeToString(device_type).c_str());
+      exit(EXIT_FAILURE);
+    }
+    else {
+      printf("%30s : %s %s %lu blocks\n",
+             "tier",
+             DeviceTypeToString(device_type).c_str(),
+             CachingTypeToString(model.caching_type).c_str(),
+             model.size);
+    }
+  }
+}
+
+static void ValidateInclusionType(const configuration &state){
+  if(state.inclusion_type != INCLUSION_TYPE_INCLUSIVE &&
+      state.inclusion_type != INCLUSION_TYPE_EXCLUSIVE) {
+    printf("Invalid inclusion_type :: %d\n", state.inclusion_type);
+    exit(EXIT_FAILURE);
+  }
+  else {
+    printf("%30s : %s\n", "inclusion_type",
+           InclusionTypeToString(state.inclusion_type).c_str());
+  }
+}
+
+static void ValidateFlashTranslationLayer(const configuration &state){
+  if(state.ftl_overprovisioning < 0 || state.ftl_pages_per_block == 0) {
+    printf("Invalid ftl :: %.2f %lu\n",
+           state.ftl_overprovisioning,
+           state.ftl_pages_per_block);
+    exit(EXIT_FAILURE);
+  }
+  else if(state.ftl_overprovisioning > 0) {
+    printf("%30s : %.2f\n", "ftl_overprovisioning", state.ftl_overprovisioning);
+    printf("%30s : %lu\n", "ftl_block_pages", state.ftl_pages_per_block);
+  }
+}
+
+static void ValidateNVMWear(const configuration &state){
+  if(state.nvm_endurance <= 0) {
+    printf("Invalid nvm_endurance :: %.0f\n", state.nvm_endurance);
+    exit(EXIT_FAILURE);
+  }
+  else {
+    printf("%30s : %.0f\n", "nvm_endurance", state.nvm_endurance);
+  }
+
+  if(state.nvm_wear_threshold > 0) {
+    printf("%30s : %lu\n", "nvm_wear_threshold", state.nvm_wear_threshold);
+  }
+}
+
+static void ValidateReadahead(const configuration &state){
+  if(state.readahead_window > 0) {
+    printf("%30s : %lu\n", "readahead", state.readahead_window);
+  }
+}
+
+static void ValidateStreamCount(const configuration &state){
+  if(state.stream_count == 0) {
+    printf("Invalid streams :: %lu\n", state.stream_count);
+    exit(EXIT_FAILURE);
+  }
+  else {
+    printf("%30s : %lu\n", "streams", state.stream_count);
+  }
+}
+
+static void ValidatePromotion(const configuration &state){
+  if(state.promotion_window == 0) {
+    printf("Invalid promotion_window :: %lu\n", state.promotion_window);
+    exit(EXIT_FAILURE);
+  }
+  else {
+    printf("%30s : %lu\n", "promotion_window", state.promotion_window);
+  }
+
+  if(state.dram_promotion_threshold > 0) {
+    printf("%30s : %lu\n", "dram_promotion", state.dram_promotion_threshold);
+  }
+  if(state.cache_promotion_threshold > 0) {
+    printf("%30s : %lu\n", "cache_promotion", state.cache_promotion_threshold);
+  }
+}
+
+static void ValidateMigrationQueue(const configuration &state){
+  if(state.migration_bandwidth < 0) {
+    printf("Invalid migration_bandwidth :: %.2lf\n", state.migration_bandwidth);
+    exit(EXIT_FAILURE);
+  }
+
+  if(state.migration_queue_depth > 0) {
+    printf("%30s : %lu\n", "migration_queue", state.migration_queue_depth);
+    printf("%30s : %.2lf\n", "migration_bandwidth", state.migration_bandwidth);
+  }
+}
+
+static void ValidateFlusher(const configuration &state){
+  if(state.flush_high_watermark == 0) {
+    return;
+  }
+
+  if(state.flush_interval == 0) {
+    printf("Invalid flush_interval :: %lu\n", state.flush_interval);
+    exit(EXIT_FAILURE);
+  }
+  else if(state.flush_high_watermark < 0 || state.flush_high_watermark > 1) {
+    printf("Invalid flush_high_watermark :: %.2lf\n",
+           state.flush_high_watermark);
+    exit(EXIT_FAILURE);
+  }
+  else if(state.flush_low_watermark < 0 ||
+      state.flush_low_watermark >= state.flush_high_watermark) {
+    printf("Invalid flush_low_watermark :: %.2lf\n",
+           state.flush_low_watermark);
+    exit(EXIT_FAILURE);
+  }
+  else {
+    printf("%30s : %lu\n", "flush_interval", state.flush_interval);
+    printf("%30s : %.2lf\n", "flush_high_watermark",
+           state.flush_high_watermark);
+    printf("%30s : %.2lf\n", "flush_low_watermark",
+           state.flush_low_watermark);
+  }
+}
+
+static void ValidateCheckpointInterval(const configuration &state){
+  if(state.checkpoint_interval > 0) {
+    printf("%30s : %lu\n", "checkpoint_interval", state.checkpoint_interval);
+  }
+}
+
+static void ValidateLogDevice(const configuration &state){
+  if(state.log_device_type == DEVICE_TYPE_INVALID) {
+    return;
+  }
+
+  // The log lives on a persistent device
+  if(state.log_device_type != DEVICE_TYPE_NVM &&
+      state.log_device_type != DEVICE_TYPE_SSD) {
+    printf("Invalid log_device :: %d\n", state.log_device_type);
+    exit(EXIT_FAILURE);
+  }
+  else if(state.log_commit_interval < 0) {
+    printf("Invalid log_commit_interval :: %.2lf\n",
+           state.log_commit_interval);
+    exit(EXIT_FAILURE);
+  }
+  else if(state.log_record_size == 0) {
+    printf("Invalid log_record_size :: %lu\n", state.log_record_size);
+    exit(EXIT_FAILURE);
+  }
+  else {
+    printf("%30s : %s\n", "log_device",
+           DeviceTypeToString(state.log_device_type).c_str());
+    printf("%30s : %.2lf\n", "log_commit_interval",
+           state.log_commit_interval);
+    printf("%30s : %lu\n", "log_record_size", state.log_record_size);
+  }
+}
+
+static void ValidateRebalancer(const configuration &state){
+  if(state.rebalance_epoch == 0) {
+    return;
+  }
+
+  if(state.rebalance_budget == 0) {
+    printf("Invalid rebalance_budget :: %lu\n", state.rebalance_budget);
+    exit(EXIT_FAILURE);
+  }
+  else {
+    printf("%30s : %lu\n", "rebalance_epoch", state.rebalance_epoch);
+    printf("%30s : %lu\n", "rebalance_budget", state.rebalance_budget);
+  }
+}
+
+static void ValidateWarmupOperationCount(const configuration &state){
+  if(state.warmup_operation_count > 0) {
+    printf("%30s : %lu\n", "warmup_ops", state.warmup_operation_count);
+  }
+}
+
 void SetupNVMLatency(configuration &state){
 
   switch(state.latency_type){
@@ -145,25 +633,75 @@ void SetupNVMLatency(configuration &state){
 }
 
 
+static Device GetTierDevice(const configuration &state,
+                            const DeviceType& device_type,
+                            const DeviceType& last_device_type){
+
+  auto caching_type = GetTierCachingType(state, device_type);
+
+  auto tier_itr = state.tier_models.find(device_type);
+  if(tier_itr != state.tier_models.end() && tier_itr->second.size != 0){
+    return Device(device_type, caching_type, tier_itr->second.size);
+  }
+
+  return DeviceFactory::GetDevice(device_type,
+                                  state.size_type,
+                                  caching_type,
+                                  last_device_type);
+}
+
+// Tiers of the topology file: the last one holds every block
+static void ConstructTopologyDeviceList(configuration &state){
+
+  const size_t last_device_size = 1024 * 1024 * 250;
+
+  state.devices.clear();
+  state.memory_devices.clear();
+  state.storage_devices.clear();
+
+  for(auto& tier : state.topology){
+    auto size = tier.size;
+    if(size == 0){
+      size = last_device_size;
+    }
+
+    Device device(tier.device_type, tier.caching_type, size);
+    device.volatile_device = tier.volatile_device;
+    device.memory_device = tier.memory_device;
+
+    state.devices.push_back(device);
+    if(device.memory_device == true){
+      state.memory_devices.push_back(device);
+    }
+    if(device.volatile_device == false){
+      state.storage_devices.push_back(device);
+    }
+  }
+
+}
+
 void ConstructDeviceList(configuration &state){
 
+  // Fresh media for the new hierarchy
+  ResetFlashTranslationLayer();
+  GetNVMWear().Reset();
+
+  if(state.topology.empty() == false){
+    ConstructTopologyDeviceList(state);
+    BuildTierChain(state.devices);
+    SetEvictionCosts(state.devices);
+    return;
+  }
+
   auto last_device_type = GetLastDevice(state.hierarchy_type);
-  Device cache_device = DeviceFactory::GetDevice(DEVICE_TYPE_CACHE,
-                                                 state.size_type,
-                                                 state.caching_type,
-                                                 last_device_type);
-  Device dram_device = DeviceFactory::GetDevice(DEVICE_TYPE_DRAM,
-                                                state.size_type,
-                                                state.caching_type,
-                                                last_device_type);
-  Device nvm_device = DeviceFactory::GetDevice(DEVICE_TYPE_NVM,
-                                               state.size_type,
-                                               state.caching_type,
-                                               last_device_type);
-  Device ssd_device = DeviceFactory::GetDevice(DEVICE_TYPE_SSD,
-                                               state.size_type,
-                                               state.caching_type,
-                                               last_device_type);
+  Device cache_device = GetTierDevice(state, DEVICE_TYPE_CACHE,
+                                      last_device_type);
+  Device dram_device = GetTierDevice(state, DEVICE_TYPE_DRAM,
+                                     last_device_type);
+  Device nvm_device = GetTierDevice(state, DEVICE_TYPE_NVM,
+                                    last_device_type);
+  Device ssd_device = GetTierDevice(state, DEVICE_TYPE_SSD,
+                                    last_device_type);
 
   switch (state.hierarchy_type) {
     case HIERARCHY_TYPE_NVM: {
@@ -194,8 +732,180 @@ void ConstructDeviceList(configuration &state){
       break;
   }
 
+  BuildTierChain(state.devices);
+  SetEvictionCosts(state.devices);
+
+}
+
+
+// Read the tiers of a topology file, top first. Each line holds
+//   name kind caching_type blocks read_ns write_ns [channels]
+// where kind is volatile or persistent (memory tiers read in place) or
+// storage (blocks are copied into memory first). The built-in device
+// names keep their behavior and default latencies, other names declare
+// new devices.
+static void ParseTopology(configuration &state, const std::string& file_name){
+  std::ifstream input(file_name);
+  if(input.good() == false) {
+    printf("Invalid topology :: %s\n", file_name.c_str());
+    exit(EXIT_FAILURE);
+  }
+
+  state.topology.clear();
+  size_t custom_device_count = 0;
+
+  std::string line;
+  while(std::getline(input, line)) {
+    std::istringstream line_stream(line);
+    TierSpec tier;
+    std::string kind;
+    int caching_type = 0;
+    if(!(line_stream >> tier.name) || tier.name[0] == '#') {
+      continue;
+    }
+
+    if(!(line_stream >> kind >> caching_type >> tier.size
+         >> tier.read_latency >> tier.write_latency)) {
+      printf("Invalid topology :: %s\n", line.c_str());
+      exit(EXIT_FAILURE);
+    }
+    line_stream >> tier.channel_count;
+
+    if(kind == "volatile") {
+      tier.volatile_device = true;
+      tier.memory_device = true;
+    }
+    else if(kind == "persistent") {
+      tier.memory_device = true;
+    }
+    else if(kind != "storage") {
+      printf("Invalid topology :: %s is not a tier kind\n", kind.c_str());
+      exit(EXIT_FAILURE);
+    }
+    tier.caching_type = (CachingType) caching_type;
+
+    // Built-in devices keep their type
+    for(auto device_type : {DEVICE_TYPE_CACHE, DEVICE_TYPE_DRAM,
+      DEVICE_TYPE_NVM, DEVICE_TYPE_SSD}) {
+      if(tier.name == DeviceTypeToString(device_type)) {
+        tier.device_type = device_type;
+      }
+    }
+    if(tier.device_type == DEVICE_TYPE_INVALID) {
+      tier.device_type = (DeviceType) (DEVICE_TYPE_CUSTOM + custom_device_count++);
+      SetDeviceTypeName(tier.device_type, tier.name);
+    }
+
+    state.topology.push_back(tier);
+  }
+}
+
+static void ValidateTopology(configuration &state){
+  if(state.topology.empty() == true) {
+    return;
+  }
+
+  auto invalid_topology = [](const std::string& reason) {
+    printf("Invalid topology :: %s\n", reason.c_str());
+    exit(EXIT_FAILURE);
+  };
+
+  if(state.topology.size() < 2) {
+    invalid_topology("fewer than two tiers");
+  }
+  if(state.topology.front().memory_device == false) {
+    invalid_topology("the top tier is a storage tier");
+  }
+  if(state.topology.back().volatile_device == true) {
+    invalid_topology("the last tier is volatile");
+  }
+
+  std::set<DeviceType> device_types;
+  for(size_t tier_itr = 0; tier_itr < state.topology.size(); tier_itr++) {
+    auto& tier = state.topology[tier_itr];
+    auto last_tier = (tier_itr + 1 == state.topology.size());
+
+    if(device_types.insert(tier.device_type).second == false) {
+      invalid_topology(tier.name + " is declared twice");
+    }
+    if(tier.caching_type <= CACHING_TYPE_INVALID ||
+        tier.caching_type > CACHING_TYPE_MAX) {
+      invalid_topology(tier.name + " has no caching type");
+    }
+    if(tier.size == 0 && last_tier == false) {
+      invalid_topology(tier.name + " has no capacity");
+    }
+    if(tier.device_type >= DEVICE_TYPE_CUSTOM &&
+        (tier.read_latency <= 0 || tier.write_latency <= 0)) {
+      invalid_topology(tier.name + " has no latency");
+    }
+    // Blocks are copied from storage into the lowest memory tier
+    if(tier_itr > 0 && tier.memory_device == true &&
+        state.topology[tier_itr - 1].memory_device == false) {
+      invalid_topology(tier.name + " is a memory tier below storage");
+    }
+
+    printf("%30s : %s %s %s %lu blocks %.0f/%.0f ns\n",
+           "topology",
+           tier.name.c_str(),
+           tier.volatile_device ? "volatile" :
+               (tier.memory_device ? "persistent" : "storage"),
+           CachingTypeToString(tier.caching_type).c_str(),
+           tier.size,
+           tier.read_latency,
+           tier.write_latency);
+  }
+
+  state.hierarchy_type = HIERARCHY_TYPE_TOPOLOGY;
+}
+
+// Read "name value" lines of a config file as long options. Blank lines
+// and lines starting with '#' are skipped.
+static void ReadConfigFile(const std::string& file_name,
+                           std::vector<std::string>& arguments){
+  std::ifstream input(file_name);
+  if(input.good() == false) {
+    printf("Invalid config_file :: %s\n", file_name.c_str());
+    exit(EXIT_FAILURE);
+  }
+
+  std::string line;
+  while(std::getline(input, line)) {
+    std::istringstream line_stream(line);
+    std::string name;
+    std::string value;
+    if(!(line_stream >> name) || name[0] == '#') {
+      continue;
+    }
+
+    if(line_stream >> value) {
+      arguments.push_back("--" + name + "=" + value);
+    }
+    else {
+      arguments.push_back("--" + name);
+    }
+  }
 }
 
+// Splice the options of config files in place of --config_file, so that
+// options given after it on the command line take precedence
+static void ExpandConfigFiles(int argc, char *argv[],
+                              std::vector<std::string>& arguments){
+  const std::string option = "--config_file";
+
+  for(int arg_itr = 0; arg_itr < argc; arg_itr++) {
+    std::string argument = argv[arg_itr];
+    if(argument == option && arg_itr + 1 < argc) {
+      ReadConfigFile(argv[++arg_itr], arguments);
+    }
+    else if(argument.compare(0, option.size() + 1, option + "=") == 0) {
+      ReadConfigFile(argument.substr(option.size() + 1), arguments);
+    }
+    else {
+      arguments.push_back(argument);
+    }
+  }
+}
 
 void ParseArguments(int argc, char *argv[], configuration &state) {
 
@@ -209,12 +919,62 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
   state.migration_frequency = 3;
   state.file_name = "";
   state.operation_count = 0;
+  state.warmup_operation_count = 0;
+  state.client_count = 1;
+  state.inclusion_type = INCLUSION_TYPE_INCLUSIVE;
+  state.ftl_overprovisioning = 0.25;
+  state.ftl_pages_per_block = 64;
+  state.nvm_endurance = 1e7;
+  state.nvm_wear_threshold = 0;
+  state.readahead_window = 0;
+  state.stream_count = stream_table_size;
+  state.dram_promotion_threshold = 0;
+  state.cache_promotion_threshold = 0;
+  state.promotion_window = 64 * 1024;
+  state.migration_queue_depth = 0;
+  state.migration_bandwidth = 0;
+  state.flush_interval = 1024;
+  state.flush_high_watermark = 0;
+  state.flush_low_watermark = 0.1;
+  state.checkpoint_interval = 0;
+  state.log_device_type = DEVICE_TYPE_INVALID;
+  state.log_commit_interval = 0;
+  state.log_record_size = 256;
+  state.rebalance_epoch = 0;
+  state.rebalance_budget = 64;
+
+  state.generator_mode = false;
+  state.read_ratio = 0.5;
+  state.scan_ratio = 0;
+  state.flush_ratio = 0;
+  state.key_count = 1000 * 1000;
+  state.zipf_theta = 0.99;
+  state.records_per_page = 4;
+  state.scan_length = 100;
+  state.insert_ratio = 0;
+  state.distribution_type = DISTRIBUTION_TYPE_ZIPF;
+  state.hot_set_ratio = 0.2;
+  state.hot_operation_ratio = 0.8;
+
+  state.save_snapshot_file = "";
+  state.snapshot_operation = 0;
+  state.load_snapshot_file = "";
+
+  std::vector<std::string> arguments;
+  ExpandConfigFiles(argc, argv, arguments);
+  std::vector<char*> argument_list;
+  for(auto& argument : arguments) {
+    argument_list.push_back(&argument[0]);
+  }
+  argument_list.push_back(nullptr);
+  argc = arguments.size();
+  argv = argument_list.data();
 
   // Parse args
   while (1) {
     int idx = 0;
     int c = getopt_long(argc, argv,
-                        "a:c:f:m:l:o:s:vh",
+                        "a:c:f:m:l:o:s:w:vgh",
                         opts, &idx);
 
     if (c == -1) break;
@@ -241,9 +1001,135 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
       case 's':
         state.size_type = (SizeType)atoi(optarg);
         break;
+      case 'w':
+        state.warmup_operation_count = atol(optarg);
+        break;
       case 'v':
         state.verbose = atoi(optarg);
         break;
+      case 'g':
+        state.generator_mode = true;
+        break;
+      case OPTION_READ_RATIO:
+        state.read_ratio = atof(optarg);
+        break;
+      case OPTION_SCAN_RATIO:
+        state.scan_ratio = atof(optarg);
+        break;
+      case OPTION_FLUSH_RATIO:
+        state.flush_ratio = atof(optarg);
+        break;
+      case OPTION_KEY_COUNT:
+        state.key_count = atol(optarg);
+        break;
+      case OPTION_ZIPF_THETA:
+        state.zipf_theta = atof(optarg);
+        break;
+      case OPTION_RECORDS_PER_PAGE:
+        state.records_per_page = atol(optarg);
+        break;
+      case OPTION_SCAN_LENGTH:
+        state.scan_length = atol(optarg);
+        break;
+      case OPTION_INSERT_RATIO:
+        state.insert_ratio = atof(optarg);
+        break;
+      case OPTION_KEY_DISTRIBUTION:
+        state.distribution_type = (DistributionType)atoi(optarg);
+        break;
+      case OPTION_HOT_SET_RATIO:
+        state.hot_set_ratio = atof(optarg);
+        break;
+      case OPTION_HOT_OPERATION_RATIO:
+        state.hot_operation_ratio = atof(optarg);
+        break;
+      case OPTION_SAVE_SNAPSHOT:
+        state.save_snapshot_file = optarg;
+        break;
+      case OPTION_SNAPSHOT_OPERATION:
+        state.snapshot_operation = atol(optarg);
+        break;
+      case OPTION_LOAD_SNAPSHOT:
+        state.load_snapshot_file = optarg;
+        break;
+      case OPTION_CLIENTS:
+        state.client_count = atol(optarg);
+        break;
+      case OPTION_DEVICE_MODEL:
+        ParseDeviceModel(state, optarg);
+        break;
+      case OPTION_CONFIG_FILE:
+        // Expanded before parsing
+        break;
+      case OPTION_TIER:
+        ParseTierModel(state, optarg);
+        break;
+      case OPTION_TOPOLOGY:
+        ParseTopology(state, optarg);
+        break;
+      case OPTION_INCLUSION_TYPE:
+        state.inclusion_type = (InclusionType)atoi(optarg);
+        break;
+      case OPTION_FTL_OVERPROVISIONING:
+        state.ftl_overprovisioning = atof(optarg);
+        break;
+      case OPTION_FTL_BLOCK_PAGES:
+        state.ftl_pages_per_block = atol(optarg);
+        break;
+      case OPTION_NVM_ENDURANCE:
+        state.nvm_endurance = atof(optarg);
+        break;
+      case OPTION_NVM_WEAR_THRESHOLD:
+        state.nvm_wear_threshold = atol(optarg);
+        break;
+      case OPTION_READAHEAD:
+        state.readahead_window = atol(optarg);
+        break;
+      case OPTION_STREAMS:
+        state.stream_count = atol(optarg);
+        break;
+      case OPTION_DRAM_PROMOTION:
+        state.dram_promotion_threshold = atol(optarg);
+        break;
+      case OPTION_CACHE_PROMOTION:
+        state.cache_promotion_threshold = atol(optarg);
+        break;
+      case OPTION_PROMOTION_WINDOW:
+        state.promotion_window = atol(optarg);
+        break;
+      case OPTION_MIGRATION_QUEUE:
+        state.migration_queue_depth = atol(optarg);
+        break;
+      case OPTION_MIGRATION_BANDWIDTH:
+        state.migration_bandwidth = atof(optarg);
+        break;
+      case OPTION_FLUSH_INTERVAL:
+        state.flush_interval = atol(optarg);
+        break;
+      case OPTION_FLUSH_HIGH_WATERMARK:
+        state.flush_high_watermark = atof(optarg);
+        break;
+      case OPTION_FLUSH_LOW_WATERMARK:
+        state.flush_low_watermark = atof(optarg);
+        break;
+      case OPTION_CHECKPOINT_INTERVAL:
+        state.checkpoint_interval = atol(optarg);
+        break;
+      case OPTION_LOG_DEVICE:
+        state.log_device_type = (DeviceType)atoi(optarg);
+        break;
+      case OPTION_LOG_COMMIT_INTERVAL:
+        state.log_commit_interval = atof(optarg);
+        break;
+      case OPTION_LOG_RECORD_SIZE:
+        state.log_record_size = atol(optarg);
+        break;
+      case OPTION_REBALANCE_EPOCH:
+        state.rebalance_epoch = atol(optarg);
+        break;
+      case OPTION_REBALANCE_BUDGET:
+        state.rebalance_budget = atol(optarg);
+        break;
       case 'h':
         Usage();
         break;
@@ -259,6 +1145,7 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
   printf("//                               MACHINE                                      //\n");
   printf("//===----------------------------------------------------------------------===//\n");
 
+  ValidateTopology(state);
   ValidateHierarchyType(state);
   ValidateSizeType(state);
   ValidateLatencyType(state);
@@ -268,7 +1155,27 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
   SetupNVMLatency(state);
   ValidateNVMReadLatency(state);
   ValidateNVMWriteLatency(state);
+  ValidateGenerator(state);
+  ValidateSnapshot(state);
   ValidateOperationCount(state);
+  ValidateWarmupOperationCount(state);
+  ValidateClientCount(state);
+  ValidateDeviceModels(state);
+  ValidateTierModels(state);
+  ValidateInclusionType(state);
+  ValidateFlashTranslationLayer(state);
+  ValidateNVMWear(state);
+  ValidateReadahead(state);
+  ValidateStreamCount(state);
+  ValidatePromotion(state);
+  ValidateMigrationQueue(state);
+  ValidateFlusher(state);
+  ValidateCheckpointInterval(state);
+  ValidateLogDevice(state);
+  ValidateRebalancer(state);
+
+  // Stream tables are sized when the tiers are built
+  stream_table_size = state.stream_count;
 
   printf("//===----------------------------------------------------------------------===//\n");
 
@@ -1,9 +1,16 @@
 // DEVICE SOURCE
 
+#include <algorithm>
+#include <memory>
+#include <queue>
+
 #include "macros.h"
 #include "device.h"
 #include "configuration.h"
+#include "ftl.h"
+#include "migration.h"
 #include "stats.h"
+#include "wear.h"
 
 namespace machine {
 
@@ -12,6 +19,68 @@ std::map<DeviceType, double> seq_read_latency;
 std::map<DeviceType, double> seq_write_latency;
 std::map<DeviceType, double> rnd_read_latency;
 std::map<DeviceType, double> rnd_write_latency;
+std::map<DeviceType, DeviceServiceModel> device_service_model;
+
+// Requests in flight at a device
+struct DeviceServiceState {
+  // time each channel becomes free
+  std::vector<double> channel_free_time;
+
+  // time the shared transfer bandwidth becomes free
+  double transfer_free_time = 0;
+
+  // completion times of admitted requests (with a queue depth)
+  std::priority_queue<double, std::vector<double>, std::greater<double>> admitted;
+};
+
+std::map<DeviceType, DeviceServiceState> device_service_state;
+
+// Device time of the serial replay (issue time in the event engine)
+double device_clock = 0;
+
+// Background accesses overlap with the foreground
+bool background_access = false;
+double background_clock = 0;
+
+// Bytes moved per access
+const size_t device_block_size = 4096;
+
+// SSD flash (off when there is no overprovisioning)
+std::unique_ptr<FlashTranslationLayer> ssd_ftl;
+double ftl_overprovisioning = 0;
+size_t ftl_pages_per_block = 0;
+
+// NAND block erase (ns)
+const double ssd_erase_latency = 2 * 1000 * 1000;
+
+// NVM write counts
+WearTracker nvm_wear;
+
+// Background migrations and write-backs (off without a queue depth)
+std::unique_ptr<MigrationQueue> migration_queue;
+size_t migration_queue_depth = 0;
+double migration_bandwidth = 0;
+double migration_start_time = 0;
+
+// Device accesses of the current operation
+std::vector<DeviceAccess>* device_access_recorder = nullptr;
+
+// Promotions leave a copy in the lower tier unless exclusive
+InclusionType inclusion_type = INCLUSION_TYPE_INCLUSIVE;
+
+// Links of a tier in the hierarchy
+struct TierLink {
+  bool present = false;
+  size_t offset = 0;
+  DeviceType upper = DEVICE_TYPE_INVALID;
+  DeviceType lower = DEVICE_TYPE_INVALID;
+  DeviceType persistent_lower = DEVICE_TYPE_INVALID;
+  bool volatile_device = false;
+};
+
+// Tier chain indexed by device type
+std::vector<TierLink> tier_chain;
+std::vector<DeviceType> tier_device_types;
 
 // Machine stats
 Stats machine_stats;
@@ -49,6 +118,278 @@ void BootstrapDeviceMetrics(const configuration &state){
   rnd_read_latency[DEVICE_TYPE_SSD] = 100 * 100;
   rnd_write_latency[DEVICE_TYPE_SSD] = 400 * 100;
 
+  // SERVICE MODEL (channels, bandwidth, queue depth)
+
+  device_service_model[DEVICE_TYPE_CACHE] = {64, 0, 0};
+  device_service_model[DEVICE_TYPE_DRAM] = {32, 0, 0};
+  device_service_model[DEVICE_TYPE_NVM] = {8, 0, 0};
+  device_service_model[DEVICE_TYPE_SSD] = {32, 0, 0};
+
+  // TOPOLOGY (declared tiers override the defaults)
+
+  for(auto& tier : state.topology){
+    auto device_type = tier.device_type;
+    if(tier.read_latency > 0){
+      seq_read_latency[device_type] = tier.read_latency;
+      rnd_read_latency[device_type] = tier.read_latency;
+    }
+    if(tier.write_latency > 0){
+      seq_write_latency[device_type] = tier.write_latency;
+      rnd_write_latency[device_type] = tier.write_latency;
+    }
+    if(tier.channel_count > 0){
+      device_service_model[device_type] = {tier.channel_count, 0, 0};
+    }
+    else if(device_service_model.count(device_type) == 0){
+      device_service_model[device_type] = {1, 0, 0};
+    }
+  }
+
+  for(auto& entry : state.service_models){
+    device_service_model[entry.first] = entry.second;
+  }
+
+  // INCLUSION
+
+  inclusion_type = state.inclusion_type;
+
+  // MIGRATION QUEUE
+
+  migration_queue_depth = state.migration_queue_depth;
+  migration_bandwidth = state.migration_bandwidth;
+
+  ResetDeviceServiceState();
+
+  // FLASH TRANSLATION LAYER
+
+  ftl_overprovisioning = state.ftl_overprovisioning;
+  ftl_pages_per_block = state.ftl_pages_per_block;
+  ResetFlashTranslationLayer();
+
+}
+
+double GetSequentialWriteLatency(const DeviceType& device_type){
+  return seq_write_latency[device_type];
+}
+
+void ResetFlashTranslationLayer(){
+  ssd_ftl.reset();
+  if(ftl_overprovisioning > 0){
+    ssd_ftl.reset(new FlashTranslationLayer(ftl_overprovisioning,
+                                            ftl_pages_per_block,
+                                            seq_read_latency[DEVICE_TYPE_SSD],
+                                            seq_write_latency[DEVICE_TYPE_SSD],
+                                            ssd_erase_latency));
+  }
+}
+
+FlashTranslationLayer* GetFlashTranslationLayer(){
+  return ssd_ftl.get();
+}
+
+WearTracker& GetNVMWear(){
+  return nvm_wear;
+}
+
+void BootstrapFlashPage(const size_t& block_id){
+  if(ssd_ftl != nullptr){
+    ssd_ftl->Bootstrap(block_id);
+  }
+}
+
+// Program a block into the SSD flash and return the garbage collection
+// stall it triggers
+static double WriteFlashPage(const size_t& block_id){
+  if(ssd_ftl == nullptr){
+    return 0;
+  }
+
+  auto flash_write = ssd_ftl->Write(block_id);
+  machine_stats.RecordFlashWrite(flash_write.relocated_page_count,
+                                 flash_write.erased_block_count,
+                                 flash_write.stall);
+  return flash_write.stall;
+}
+
+size_t GetDeviceParallelism(const DeviceType& device_type){
+  return device_service_model[device_type].channel_count;
+}
+
+void SetDeviceClock(const double& time){
+  device_clock = time;
+}
+
+double GetDeviceClock(){
+  return device_clock;
+}
+
+void BeginBackgroundAccess(){
+  background_access = true;
+  background_clock = device_clock;
+}
+
+double EndBackgroundAccess(){
+  background_access = false;
+  return background_clock;
+}
+
+double WaitForDevice(const double& ready_time){
+  if(ready_time <= device_clock){
+    return 0;
+  }
+
+  // The event engine reaches the wait after the accesses recorded before
+  // it, so it waits until ready_time rather than for the stall
+  auto stall = ready_time - device_clock;
+  if(device_access_recorder != nullptr){
+    device_access_recorder->push_back({DEVICE_TYPE_INVALID, stall, ready_time});
+    return stall;
+  }
+
+  device_clock = ready_time;
+  return stall;
+}
+
+void ResetDeviceServiceState(){
+  device_service_state.clear();
+  device_clock = 0;
+
+  migration_queue.reset();
+  if(migration_queue_depth > 0){
+    migration_queue.reset(new MigrationQueue(migration_queue_depth,
+                                             migration_bandwidth,
+                                             device_block_size));
+  }
+}
+
+MigrationQueue* GetMigrationQueue(){
+  return migration_queue.get();
+}
+
+bool BeginMigration(double& total_duration){
+
+  // Synchronous, or already part of a background access
+  if(migration_queue == nullptr || background_access == true){
+    return false;
+  }
+
+  // Wait for a slot in a full queue
+  auto admission_time = migration_queue->Admit(device_clock);
+  auto stall = WaitForDevice(admission_time);
+  if(stall > 0){
+    migration_queue->RecordFullStall(stall);
+    total_duration += stall;
+  }
+
+  background_access = true;
+  background_clock = migration_queue->GetStartTime(admission_time);
+  migration_start_time = background_clock;
+  return true;
+}
+
+void EndMigration(const size_t& block_id){
+  background_access = false;
+  migration_queue->Complete(block_id, migration_start_time, background_clock);
+}
+
+double WaitForMigration(const size_t& block_id){
+
+  double ready_time = 0;
+  if(migration_queue == nullptr ||
+      migration_queue->IsInFlight(block_id, device_clock, ready_time) == false){
+    return 0;
+  }
+
+  auto stall = WaitForDevice(ready_time);
+  migration_queue->RecordInFlightStall(stall);
+  return stall;
+}
+
+double ServeDeviceRequest(const DeviceType& device_type,
+                          const double& arrival_time,
+                          const double& latency){
+
+  auto& model = device_service_model[device_type];
+  auto& service = device_service_state[device_type];
+  auto start_time = arrival_time;
+
+  // Wait for a slot in the device queue
+  if(model.queue_depth != 0){
+    while(service.admitted.size() >= model.queue_depth){
+      start_time = std::max(start_time, service.admitted.top());
+      service.admitted.pop();
+    }
+    while(service.admitted.empty() == false &&
+        service.admitted.top() <= start_time){
+      service.admitted.pop();
+    }
+  }
+
+  // Take the channel freed last among the idle ones, so that a chain of
+  // background accesses keeps to one channel, or wait for the earliest
+  if(service.channel_free_time.size() != model.channel_count){
+    service.channel_free_time.assign(model.channel_count, 0);
+  }
+  auto channel = service.channel_free_time.end();
+  for(auto channel_itr = service.channel_free_time.begin();
+      channel_itr != service.channel_free_time.end();
+      channel_itr++){
+    if(*channel_itr <= start_time &&
+        (channel == service.channel_free_time.end() ||
+            *channel_itr > *channel)){
+      channel = channel_itr;
+    }
+  }
+  if(channel == service.channel_free_time.end()){
+    channel = std::min_element(service.channel_free_time.begin(),
+                               service.channel_free_time.end());
+  }
+  start_time = std::max(start_time, *channel);
+  auto completion_time = start_time + latency;
+
+  // Transfers are serialized on the device bandwidth
+  if(model.bandwidth > 0){
+    auto transfer_time = (device_block_size * 1000) / model.bandwidth;
+    auto transfer_start = std::max(start_time, service.transfer_free_time);
+    service.transfer_free_time = transfer_start + transfer_time;
+    completion_time = std::max(completion_time, service.transfer_free_time);
+  }
+
+  *channel = completion_time;
+  if(model.queue_depth != 0){
+    service.admitted.push(completion_time);
+  }
+
+  return completion_time;
+}
+
+void SetDeviceAccessRecorder(std::vector<DeviceAccess>* recorder){
+  device_access_recorder = recorder;
+}
+
+// The event engine serves recorded accesses later in simulated time,
+// the serial replay serves them right away on the device clock.
+// Background accesses are served right away and cost the caller nothing.
+static size_t ServeDeviceAccess(const DeviceType& device_type,
+                                const double& latency){
+  if(background_access == true){
+    background_clock = ServeDeviceRequest(device_type,
+                                          background_clock,
+                                          latency);
+    return 0;
+  }
+
+  if(device_access_recorder != nullptr){
+    device_access_recorder->push_back({device_type, latency});
+    return latency;
+  }
+
+  auto completion_time = ServeDeviceRequest(device_type,
+                                            device_clock,
+                                            latency);
+  auto service_time = completion_time - device_clock;
+  device_clock = completion_time;
+  return service_time;
 }
 
 bool IsSequential(std::vector<Device>& devices,
@@ -73,28 +414,35 @@ size_t GetWriteLatency(std::vector<Device>& devices,
   // Increment stats
   machine_stats.IncrementWriteCount(device_type);
 
+  // Track NVM wear
+  if(device_type == DEVICE_TYPE_NVM){
+    nvm_wear.RecordWrite(block_id);
+  }
+
   // Check if sequential or random?
   bool is_sequential = IsSequential(devices, device_type, block_id);
 
   switch(device_type){
-    case DEVICE_TYPE_CACHE:
-    case DEVICE_TYPE_DRAM:
-    case DEVICE_TYPE_NVM:
-    case DEVICE_TYPE_SSD: {
-      if(is_sequential == true){
-        return seq_write_latency[device_type];
-      }
-      else {
-        return rnd_write_latency[device_type];
-      }
-    }
-
     case DEVICE_TYPE_INVALID:
       return 0;
 
     default: {
-      std::cout << "Get invalid device";
-      exit(EXIT_FAILURE);
+      if(rnd_write_latency.count(device_type) == 0){
+        std::cout << "Get invalid device";
+        exit(EXIT_FAILURE);
+      }
+
+      auto latency = rnd_write_latency[device_type];
+      if(is_sequential == true){
+        latency = seq_write_latency[device_type];
+      }
+
+      // Garbage collection stalls the write that triggers it
+      if(device_type == DEVICE_TYPE_SSD){
+        latency += WriteFlashPage(block_id);
+      }
+
+      return ServeDeviceAccess(device_type, latency);
     }
   }
 }
@@ -112,24 +460,21 @@ size_t GetReadLatency(std::vector<Device>& devices,
   bool is_sequential = IsSequential(devices, device_type, block_id);
 
   switch(device_type){
-    case DEVICE_TYPE_CACHE:
-    case DEVICE_TYPE_DRAM:
-    case DEVICE_TYPE_NVM:
-    case DEVICE_TYPE_SSD: {
-      if(is_sequential == true){
-        return seq_read_latency[device_type];
-      }
-      else {
-        return rnd_read_latency[device_type];
-      }
-    }
-
     case DEVICE_TYPE_INVALID:
       return 0;
 
     default: {
-      std::cout << "Get invalid device";
-      exit(EXIT_FAILURE);
+      if(rnd_read_latency.count(device_type) == 0){
+        std::cout << "Get invalid device";
+        exit(EXIT_FAILURE);
+      }
+
+      if(is_sequential == true){
+        return ServeDeviceAccess(device_type, seq_read_latency[device_type]);
+      }
+      else {
+        return ServeDeviceAccess(device_type, rnd_read_latency[device_type]);
+      }
     }
   }
 }
@@ -151,6 +496,18 @@ bool LocateInDevice(Device device,
   return false;
 }
 
+// Check residency without touching the replacement policy
+bool IsResident(StorageCache& device_cache, const size_t& block_id){
+  try{
+    device_cache.Get(block_id, false);
+    return true;
+  }
+  catch(const std::range_error& not_found){
+    // Nothing to do here!
+  }
+  return false;
+}
+
 DeviceType LocateInDevices(std::vector<Device> devices,
                            const size_t& block_id){
 
@@ -164,11 +521,100 @@ DeviceType LocateInDevices(std::vector<Device> devices,
   return DeviceType::DEVICE_TYPE_INVALID;
 }
 
+// TIER CHAIN
+
+void BuildTierChain(const std::vector<Device>& devices){
+
+  tier_chain.clear();
+  tier_device_types.clear();
+
+  for(auto& device : devices){
+    size_t device_type = device.device_type;
+    if(tier_chain.size() <= device_type){
+      tier_chain.resize(device_type + 1);
+    }
+    tier_device_types.push_back(device.device_type);
+  }
+
+  // Walk up from the last tier to find the persistent tier below each one
+  auto persistent_lower = DeviceType::DEVICE_TYPE_INVALID;
+  for(size_t device_itr = devices.size(); device_itr-- > 0;){
+    auto& link = tier_chain[devices[device_itr].device_type];
+    link.present = true;
+    link.offset = device_itr;
+    link.volatile_device = devices[device_itr].volatile_device;
+    link.persistent_lower = persistent_lower;
+    if(device_itr > 0){
+      link.upper = devices[device_itr - 1].device_type;
+    }
+    if(device_itr + 1 < devices.size()){
+      link.lower = devices[device_itr + 1].device_type;
+    }
+    if(link.volatile_device == false){
+      persistent_lower = devices[device_itr].device_type;
+    }
+  }
+
+}
+
+const std::vector<DeviceType>& GetTierDeviceTypes(){
+  return tier_device_types;
+}
+
+static const TierLink& GetTierLink(const DeviceType& device_type){
+  static const TierLink missing_link;
+  if((size_t) device_type >= tier_chain.size()){
+    return missing_link;
+  }
+  return tier_chain[device_type];
+}
+
+DeviceType GetUpperDevice(DeviceType source){
+  return GetTierLink(source).upper;
+}
+
+DeviceType GetPersistentLowerDevice(DeviceType source){
+  return GetTierLink(source).persistent_lower;
+}
+
+bool IsVolatileTier(DeviceType device_type){
+  return GetTierLink(device_type).volatile_device;
+}
+
+void SetEvictionCosts(std::vector<Device>& devices){
+
+  for(size_t device_itr = 0; device_itr + 1 < devices.size(); device_itr++){
+    auto lower = devices[device_itr + 1].device_type;
+    auto refetch_cost = rnd_read_latency[lower];
+    auto write_back_cost = rnd_write_latency[lower];
+
+    // Exclusive tiers write clean victims down too, unless the tier below
+    // is the last one (it holds every block)
+    auto clean_cost = refetch_cost;
+    if(inclusion_type == INCLUSION_TYPE_EXCLUSIVE &&
+        device_itr + 2 < devices.size()){
+      clean_cost += write_back_cost;
+    }
+
+    devices[device_itr].cache.SetEvictionCost(
+        static_cast<uint64_t>(clean_cost),
+        static_cast<uint64_t>(refetch_cost + write_back_cost));
+  }
+
+}
+
 // GET DEVICE OFFSET
 
 size_t GetDeviceOffset(std::vector<Device>& devices,
                        const DeviceType& device_type){
 
+  // The tier chain knows the offset in the hierarchy (or a prefix of it)
+  auto& link = GetTierLink(device_type);
+  if(link.present == true && link.offset < devices.size() &&
+      devices[link.offset].device_type == device_type){
+    return link.offset;
+  }
+
   size_t device_itr = 0;
   for(auto device : devices){
     if(device.device_type == device_type){
@@ -185,7 +631,13 @@ size_t GetDeviceOffset(std::vector<Device>& devices,
 
 bool DeviceExists(std::vector<Device>& devices,
                   const DeviceType& device_type){
-  for(auto device : devices){
+  auto& link = GetTierLink(device_type);
+  if(link.present == true && link.offset < devices.size() &&
+      devices[link.offset].device_type == device_type){
+    return true;
+  }
+
+  for(auto& device : devices){
     if(device.device_type == device_type){
       return true;
     }
@@ -210,44 +662,13 @@ bool IsSequential(std::vector<Device>& devices,
 
 DeviceType GetLowerDevice(std::vector<Device>& devices,
                           DeviceType source){
-  DeviceType destination = DeviceType::DEVICE_TYPE_INVALID;
-  auto dram_exists = DeviceExists(devices, DeviceType::DEVICE_TYPE_DRAM);
-  auto nvm_exists = DeviceExists(devices, DeviceType::DEVICE_TYPE_NVM);
-
-  switch(source){
-    case DEVICE_TYPE_CACHE: {
-      if(dram_exists == true) {
-        destination = DEVICE_TYPE_DRAM;
-      }
-      else {
-        destination = DEVICE_TYPE_NVM;
-      }
-      break;
-    }
-
-    case DEVICE_TYPE_DRAM: {
-      if(nvm_exists == true) {
-        destination = DEVICE_TYPE_NVM;
-      }
-      else {
-        destination = DEVICE_TYPE_SSD;
-      }
-      break;
-    }
-
-    case DEVICE_TYPE_NVM: {
-      destination = DEVICE_TYPE_SSD;
-      break;
-    }
-
-    default:
-    case DEVICE_TYPE_INVALID: {
-      std::cout << "Get invalid device";
-      exit(EXIT_FAILURE);
-    }
+  auto device_offset = GetDeviceOffset(devices, source);
+  if(device_offset + 1 >= devices.size()){
+    std::cout << "Get invalid device";
+    exit(EXIT_FAILURE);
   }
 
-  return destination;
+  return devices[device_offset + 1].device_type;
 }
 
 std::string CleanStatus(const size_t& block_status){
@@ -288,6 +709,23 @@ void Copy(std::vector<Device>& devices,
   auto last_device_type = devices.back().device_type;
   auto device_cache = devices[device_offset].cache;
   auto final_block_status = block_status;
+
+  // Exclusive promotion: take the block out of the lower tier (keeping
+  // its dirty status) so that the victim of the destination can move
+  // into the freed slot. The last device keeps every block.
+  auto is_promotion = (source != DeviceType::DEVICE_TYPE_INVALID &&
+      source != last_device_type &&
+      GetDeviceOffset(devices, source) > device_offset);
+  if(inclusion_type == INCLUSION_TYPE_EXCLUSIVE && is_promotion == true){
+    auto source_cache = devices[GetDeviceOffset(devices, source)].cache;
+    if(IsResident(source_cache, block_id) == true){
+      if(source_cache.Get(block_id, false) == DIRTY_BLOCK){
+        final_block_status = DIRTY_BLOCK;
+      }
+      source_cache.Erase(block_id);
+    }
+  }
+
   if(last_device_type == destination){
     final_block_status = CLEAN_BLOCK;
   }
@@ -314,28 +752,40 @@ void MoveVictim(std::vector<Device>& devices,
                 double& total_duration){
 
   bool victim_exists = (block_id != INVALID_KEY);
-  bool memory_device = (source == DeviceType::DEVICE_TYPE_CACHE ||
-      source == DeviceType::DEVICE_TYPE_DRAM ||
-      source == DeviceType::DEVICE_TYPE_NVM);
+  bool lower_exists = (GetTierLink(source).lower != DEVICE_TYPE_INVALID);
   bool is_dirty = (block_status == DIRTY_BLOCK);
 
   if(victim_exists == true) {
     DLOG(INFO) << "Move victim   : " << block_id << "\n";
-    DLOG(INFO) << "Memory device : " << memory_device << "\n";
+    DLOG(INFO) << "Lower device  : " << lower_exists << "\n";
     DLOG(INFO) << CleanStatus(block_status) << "\n";
   }
 
-  // Check if we have a dirty victim in DRAM
-  if(victim_exists && memory_device && is_dirty){
+  // Exclusive tiers also demote clean victims, unless the lower tier
+  // already holds them (the last device holds every block)
+  auto is_demoted = is_dirty;
+  if(inclusion_type == INCLUSION_TYPE_EXCLUSIVE &&
+      victim_exists && lower_exists && is_dirty == false){
+    auto lower_offset = GetDeviceOffset(devices, GetTierLink(source).lower);
+    is_demoted = (lower_offset + 1 < devices.size() &&
+        IsResident(devices[lower_offset].cache, block_id) == false);
+  }
+
+  // Check if we have a victim to move above the last tier
+  if(victim_exists && lower_exists && is_demoted){
     auto destination = GetLowerDevice(devices, source);
 
-    // Copy to device
+    // Copy to device (in the background with a migration queue)
+    auto background = BeginMigration(total_duration);
     Copy(devices,
          destination,
          source,
          block_id,
          block_status,
          total_duration);
+    if(background == true){
+      EndMigration(block_id);
+    }
   }
 
 }
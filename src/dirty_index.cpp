@@ -0,0 +1,68 @@
+// DIRTY INDEX SOURCE
+
+#include "dirty_index.h"
+
+namespace machine {
+
+const size_t word_bit_count = 64;
+
+void DirtyIndex::Set(const size_t& block_id){
+
+  auto word_itr = block_id / word_bit_count;
+  uint64_t mask = 1ULL << (block_id % word_bit_count);
+
+  if(word_itr >= words_.size()){
+    words_.resize(word_itr + 1, 0);
+  }
+
+  if((words_[word_itr] & mask) == 0){
+    words_[word_itr] |= mask;
+    count_++;
+  }
+
+}
+
+void DirtyIndex::Clear(const size_t& block_id){
+
+  auto word_itr = block_id / word_bit_count;
+  uint64_t mask = 1ULL << (block_id % word_bit_count);
+
+  if(word_itr < words_.size() && (words_[word_itr] & mask) != 0){
+    words_[word_itr] &= ~mask;
+    count_--;
+  }
+
+}
+
+bool DirtyIndex::Test(const size_t& block_id) const {
+
+  auto word_itr = block_id / word_bit_count;
+  uint64_t mask = 1ULL << (block_id % word_bit_count);
+
+  return (word_itr < words_.size() && (words_[word_itr] & mask) != 0);
+}
+
+size_t DirtyIndex::GetCount() const {
+  return count_;
+}
+
+void DirtyIndex::GetBlocks(std::vector<size_t>& blocks) const {
+
+  blocks.reserve(blocks.size() + count_);
+  for(size_t word_itr = 0; word_itr < words_.size(); word_itr++){
+    auto word = words_[word_itr];
+    while(word != 0){
+      auto bit = __builtin_ctzll(word);
+      blocks.push_back(word_itr * word_bit_count + bit);
+      word &= word - 1;
+    }
+  }
+
+}
+
+void DirtyIndex::Reset(){
+  words_.clear();
+  count_ = 0;
+}
+
+}  // End machine namespace
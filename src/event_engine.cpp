@@ -0,0 +1,179 @@
+// EVENT ENGINE SOURCE
+
+#include <iomanip>
+
+#include "event_engine.h"
+#include "stats.h"
+
+namespace machine {
+
+extern Stats machine_stats;
+
+EventEngine::EventEngine(const size_t& client_count)
+: clients_(client_count) {
+
+  // Simulated time starts over
+  ResetDeviceServiceState();
+
+  for(auto device_type : {DEVICE_TYPE_CACHE, DEVICE_TYPE_DRAM,
+    DEVICE_TYPE_NVM, DEVICE_TYPE_SSD}){
+    device_queues_[device_type].servers = GetDeviceParallelism(device_type);
+  }
+
+  // Devices declared by a topology file
+  for(auto device_type : GetTierDeviceTypes()){
+    device_queues_[device_type].servers = GetDeviceParallelism(device_type);
+  }
+
+}
+
+void EventEngine::Schedule(const double& time, const size_t& client_id){
+  events_.push({time, sequence_++, client_id});
+}
+
+void EventEngine::Submit(const size_t& client_id,
+                         const DeviceAccess& access){
+
+  auto& device_queue = device_queues_[access.device_type];
+  auto completion_time = ServeDeviceRequest(access.device_type,
+                                            current_time_,
+                                            access.latency);
+
+  auto wait_time = completion_time - current_time_ - access.latency;
+  device_queue.request_count++;
+  device_queue.wait_time += wait_time;
+  device_queue.busy_time += access.latency;
+  if(wait_time > device_queue.max_wait_time){
+    device_queue.max_wait_time = wait_time;
+  }
+
+  Schedule(completion_time, client_id);
+
+}
+
+void EventEngine::Complete(const size_t& client_id){
+
+  auto& client = clients_[client_id];
+  client.stage++;
+
+}
+
+void EventEngine::Advance(const size_t& client_id,
+                          const std::function<bool()>& issue_operation){
+
+  auto& client = clients_[client_id];
+
+  while(true){
+
+    // Next device access of the outstanding operation
+    while(client.stage < client.accesses.size()){
+      auto& access = client.accesses[client.stage];
+
+      // Wait without a device, unless the earlier accesses outlasted it
+      if(access.device_type == DEVICE_TYPE_INVALID){
+        if(access.ready_time > current_time_){
+          Schedule(access.ready_time, client_id);
+          return;
+        }
+      }
+      else if(access.latency > 0){
+        Submit(client_id, access);
+        return;
+      }
+      client.stage++;
+    }
+
+    // Operation done
+    if(client.active == true){
+      machine_stats.RecordLatency(current_time_ - client.start_time);
+      completed_operation_count_++;
+    }
+
+    // Issue the next operation and record its device accesses
+    client.accesses.clear();
+    client.stage = 0;
+    SetDeviceClock(current_time_);
+    SetDeviceAccessRecorder(&client.accesses);
+    client.active = issue_operation();
+    SetDeviceAccessRecorder(nullptr);
+
+    if(client.active == false){
+      return;
+    }
+    client.start_time = current_time_;
+  }
+
+}
+
+void EventEngine::Run(const std::function<bool()>& issue_operation){
+
+  for(size_t client_id = 0; client_id < clients_.size(); client_id++){
+    Advance(client_id, issue_operation);
+  }
+
+  while(events_.empty() == false){
+    auto event = events_.top();
+    events_.pop();
+
+    current_time_ = event.time;
+    Complete(event.client_id);
+    Advance(event.client_id, issue_operation);
+  }
+
+}
+
+void EventEngine::ResetStats(){
+
+  reset_time_ = current_time_;
+  completed_operation_count_ = 0;
+
+  for(auto& entry : device_queues_){
+    auto& device_queue = entry.second;
+    device_queue.request_count = 0;
+    device_queue.wait_time = 0;
+    device_queue.busy_time = 0;
+    device_queue.max_wait_time = 0;
+  }
+
+}
+
+double EventEngine::GetCurrentTime() const {
+  return current_time_;
+}
+
+double EventEngine::GetElapsedTime() const {
+  return current_time_ - reset_time_;
+}
+
+std::ostream& operator<< (std::ostream& os, const EventEngine& engine){
+
+  auto elapsed_time = engine.GetElapsedTime();
+
+  os << "CLIENTS : " << engine.clients_.size() << "\n";
+  os << "COMPLETED OPS : " << engine.completed_operation_count_ << "\n";
+  os << "DEVICE QUEUES (channels, requests, mean wait ns, utilization, max wait ns): \n";
+  for(auto& entry : engine.device_queues_){
+    auto& device_queue = entry.second;
+    double mean_wait = 0;
+    double utilization = 0;
+    if(device_queue.request_count > 0){
+      mean_wait = device_queue.wait_time / device_queue.request_count;
+    }
+    if(elapsed_time > 0){
+      utilization = device_queue.busy_time /
+          (elapsed_time * device_queue.servers);
+    }
+    os << std::setw(10) << DeviceTypeToString(entry.first) << " :: "
+        << device_queue.servers << " "
+        << device_queue.request_count << " "
+        << std::fixed << std::setprecision(2) << mean_wait << " "
+        << utilization << " "
+        << device_queue.max_wait_time << "\n";
+    os.unsetf(std::ios_base::floatfield);
+    os << std::setprecision(6);
+  }
+
+  return os;
+}
+
+}  // End machine namespace
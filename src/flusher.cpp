@@ -0,0 +1,88 @@
+// FLUSHER SOURCE
+
+#include <algorithm>
+#include <iomanip>
+
+#include "flusher.h"
+
+namespace machine {
+
+DirtyFlusher::DirtyFlusher(const size_t& interval,
+                           const double& high_watermark,
+                           const double& low_watermark)
+: interval_(interval),
+  high_watermark_(high_watermark),
+  low_watermark_(low_watermark),
+  operation_count_(0) {
+  // Nothing to do here!
+}
+
+bool DirtyFlusher::Tick(){
+  operation_count_++;
+  if(operation_count_ == interval_){
+    operation_count_ = 0;
+    return true;
+  }
+  return false;
+}
+
+void DirtyFlusher::Plan(const DeviceType& device_type,
+                        std::vector<size_t>& dirty_blocks,
+                        const size_t& capacity,
+                        std::vector<size_t>& flush_blocks){
+
+  auto dirty_count = dirty_blocks.size();
+  if(dirty_count <= high_watermark_ * capacity){
+    return;
+  }
+
+  size_t target_count = low_watermark_ * capacity;
+  auto flush_count = dirty_count - target_count;
+
+  // Resume the sweep where the last batch stopped
+  std::sort(dirty_blocks.begin(), dirty_blocks.end());
+  auto& cursor = cursor_[device_type];
+  auto start = std::lower_bound(dirty_blocks.begin(),
+                                dirty_blocks.end(),
+                                cursor) - dirty_blocks.begin();
+
+  for(size_t flush_itr = 0; flush_itr < flush_count; flush_itr++){
+    auto block_itr = (start + flush_itr) % dirty_count;
+    flush_blocks.push_back(dirty_blocks[block_itr]);
+  }
+  cursor = flush_blocks.back() + 1;
+
+  // Keep the batch ascending across the wrap-around
+  std::sort(flush_blocks.begin(), flush_blocks.end());
+
+  auto& stats = stats_[device_type];
+  stats.batch_count++;
+  stats.block_count += flush_count;
+  for(size_t flush_itr = 0; flush_itr < flush_count; flush_itr++){
+    if(flush_itr == 0 ||
+        flush_blocks[flush_itr] != flush_blocks[flush_itr - 1] + 1){
+      stats.run_count++;
+    }
+  }
+
+}
+
+void DirtyFlusher::ResetStats(){
+  stats_.clear();
+}
+
+std::ostream& operator<< (std::ostream& os, const DirtyFlusher& flusher){
+
+  os << "FLUSHER (batches, blocks, runs): \n";
+  for(auto& entry : flusher.stats_){
+    auto& stats = entry.second;
+    os << std::setw(10) << DeviceTypeToString(entry.first) << " :: "
+        << stats.batch_count << " "
+        << stats.block_count << " "
+        << stats.run_count << "\n";
+  }
+
+  return os;
+}
+
+}  // End machine namespace
@@ -0,0 +1,258 @@
+// FLASH TRANSLATION LAYER SOURCE
+
+#include <cmath>
+#include <limits>
+
+#include "ftl.h"
+#include "snapshot.h"
+
+namespace machine {
+
+const size_t invalid_page = std::numeric_limits<size_t>::max();
+
+// Free erase blocks held back for relocating valid pages
+const size_t reserved_block_count = 1;
+
+FlashTranslationLayer::FlashTranslationLayer(const double& overprovisioning,
+                                             const size_t& pages_per_block,
+                                             const double& page_read_latency,
+                                             const double& page_write_latency,
+                                             const double& erase_latency)
+: overprovisioning_(overprovisioning),
+  pages_per_block_(pages_per_block),
+  page_read_latency_(page_read_latency),
+  page_write_latency_(page_write_latency),
+  erase_latency_(erase_latency),
+  active_block_(0),
+  write_offset_(pages_per_block) {
+  // Nothing to do here!
+}
+
+void FlashTranslationLayer::AddBlock(){
+  free_blocks_.push_back(valid_page_count_.size());
+  valid_page_count_.push_back(0);
+  free_block_.push_back(true);
+  reverse_mapping_.resize(reverse_mapping_.size() + pages_per_block_,
+                          invalid_page);
+}
+
+size_t FlashTranslationLayer::GetTargetBlockCount() const {
+
+  auto logical_page_count = mapping_.size();
+  size_t block_count = std::ceil(logical_page_count * (1 + overprovisioning_) /
+                                 pages_per_block_);
+  block_count += reserved_block_count + 1;
+
+  return block_count;
+}
+
+void FlashTranslationLayer::Grow(){
+
+  auto block_count = GetTargetBlockCount();
+  while(valid_page_count_.size() < block_count){
+    AddBlock();
+  }
+
+}
+
+bool FlashTranslationLayer::CollectGarbage(FlashWrite& flash_write){
+
+  // Greedy: closed block with the fewest valid pages
+  size_t victim = invalid_page;
+  size_t victim_valid_page_count = pages_per_block_;
+  for(size_t block = 0; block < valid_page_count_.size(); block++){
+    if(free_block_[block] == true || block == active_block_){
+      continue;
+    }
+    if(valid_page_count_[block] < victim_valid_page_count){
+      victim = block;
+      victim_valid_page_count = valid_page_count_[block];
+    }
+  }
+
+  // Every block is fully valid
+  if(victim == invalid_page){
+    return false;
+  }
+
+  // Relocate valid pages
+  collecting_ = true;
+  auto first_page = victim * pages_per_block_;
+  for(size_t page = first_page; page < first_page + pages_per_block_; page++){
+    auto logical_page = reverse_mapping_[page];
+    if(logical_page == invalid_page){
+      continue;
+    }
+    reverse_mapping_[page] = invalid_page;
+    Program(logical_page, flash_write);
+    flash_write.relocated_page_count++;
+    flash_write.stall += page_read_latency_ + page_write_latency_;
+  }
+  collecting_ = false;
+
+  // Erase
+  valid_page_count_[victim] = 0;
+  free_block_[victim] = true;
+  free_blocks_.push_back(victim);
+  flash_write.erased_block_count++;
+  flash_write.stall += erase_latency_;
+
+  return true;
+}
+
+void FlashTranslationLayer::OpenBlock(FlashWrite& flash_write){
+
+  if(collecting_ == false){
+    while(free_blocks_.size() <= reserved_block_count){
+      if(CollectGarbage(flash_write) == false){
+        break;
+      }
+    }
+  }
+
+  // Nothing left to reclaim
+  if(free_blocks_.empty()){
+    AddBlock();
+  }
+
+  active_block_ = free_blocks_.back();
+  free_blocks_.pop_back();
+  free_block_[active_block_] = false;
+  write_offset_ = 0;
+
+}
+
+void FlashTranslationLayer::Program(const size_t& logical_page,
+                                    FlashWrite& flash_write){
+
+  if(write_offset_ == pages_per_block_){
+    OpenBlock(flash_write);
+  }
+
+  auto physical_page = active_block_ * pages_per_block_ + write_offset_;
+  write_offset_++;
+
+  reverse_mapping_[physical_page] = logical_page;
+  valid_page_count_[active_block_]++;
+  mapping_[logical_page] = physical_page;
+
+}
+
+void FlashTranslationLayer::Bootstrap(const size_t& logical_page){
+
+  if(mapping_.count(logical_page) != 0){
+    return;
+  }
+
+  mapping_[logical_page] = invalid_page;
+  Grow();
+
+  FlashWrite flash_write;
+  Program(logical_page, flash_write);
+
+}
+
+FlashWrite FlashTranslationLayer::Write(const size_t& logical_page){
+
+  FlashWrite flash_write;
+
+  // Invalidate the old copy
+  auto mapping_itr = mapping_.find(logical_page);
+  if(mapping_itr != mapping_.end()){
+    auto physical_page = mapping_itr->second;
+    reverse_mapping_[physical_page] = invalid_page;
+    valid_page_count_[physical_page / pages_per_block_]--;
+  }
+  else {
+    mapping_[logical_page] = invalid_page;
+    Grow();
+  }
+
+  Program(logical_page, flash_write);
+
+  return flash_write;
+}
+
+size_t FlashTranslationLayer::GetLogicalPageCount() const {
+  return mapping_.size();
+}
+
+size_t FlashTranslationLayer::GetBlockCount() const {
+  return valid_page_count_.size();
+}
+
+void FlashTranslationLayer::Serialize(std::vector<uint64_t>& buffer) const {
+  buffer.push_back(active_block_);
+  buffer.push_back(write_offset_);
+  buffer.push_back(valid_page_count_.size());
+  buffer.insert(buffer.end(), valid_page_count_.begin(), valid_page_count_.end());
+  buffer.push_back(free_blocks_.size());
+  buffer.insert(buffer.end(), free_blocks_.begin(), free_blocks_.end());
+  buffer.insert(buffer.end(), reverse_mapping_.begin(), reverse_mapping_.end());
+}
+
+void FlashTranslationLayer::Deserialize(const uint64_t*& cursor,
+                                        const uint64_t* end){
+
+  CheckSnapshotSize(cursor, end, 3);
+  active_block_ = *cursor++;
+  write_offset_ = *cursor++;
+  auto block_count = *cursor++;
+
+  // A fresh FTL has no blocks and opens one on the first write
+  CheckSnapshotRange("ftl_write_offset", write_offset_, pages_per_block_ + 1);
+  if(block_count > 0){
+    CheckSnapshotRange("ftl_active_block", active_block_, block_count);
+  }
+
+  // Checked against the mapping below
+  CheckSnapshotSize(cursor, end, block_count);
+  auto valid_page_counts = cursor;
+  cursor += block_count;
+
+  CheckSnapshotSize(cursor, end, 1);
+  auto free_block_count = *cursor++;
+  CheckSnapshotSize(cursor, end, free_block_count);
+  free_blocks_.assign(cursor, cursor + free_block_count);
+  cursor += free_block_count;
+  free_block_.assign(block_count, false);
+  for(auto& block : free_blocks_){
+    CheckSnapshotRange("ftl_free_block", block, block_count);
+    CheckSnapshotField("ftl_free_block_repeat", free_block_[block], false);
+    free_block_[block] = true;
+  }
+
+  // Rebuild the logical mapping from the physical pages
+  CheckSnapshotSize(cursor, end, block_count, pages_per_block_);
+  auto page_count = block_count * pages_per_block_;
+  reverse_mapping_.assign(cursor, cursor + page_count);
+  cursor += page_count;
+  mapping_.clear();
+  mapping_.reserve(page_count);
+  valid_page_count_.assign(block_count, 0);
+  for(size_t page = 0; page < page_count; page++){
+    auto logical_page = reverse_mapping_[page];
+    if(logical_page == invalid_page){
+      continue;
+    }
+    CheckSnapshotField("ftl_logical_page_repeat",
+                       mapping_.count(logical_page), 0);
+    mapping_[logical_page] = page;
+    valid_page_count_[page / pages_per_block_]++;
+  }
+
+  for(size_t block = 0; block < block_count; block++){
+    CheckSnapshotField("ftl_valid_pages", valid_page_counts[block],
+                       valid_page_count_[block]);
+  }
+
+  // The layout must hold the logical pages with the configured spare
+  // capacity (relocations into a full flash may have added blocks)
+  auto target_block_count = GetTargetBlockCount();
+  if(block_count < target_block_count){
+    CheckSnapshotField("ftl_block_count", block_count, target_block_count);
+  }
+
+}
+
+}  // End machine namespace
@@ -0,0 +1,162 @@
+// GENERATOR SOURCE
+
+#include <algorithm>
+
+#include "generator.h"
+#include "configuration.h"
+
+namespace machine {
+
+// keys generated per batch
+const size_t key_batch_size = 1024;
+
+WorkloadGenerator::WorkloadGenerator(const configuration& state)
+: key_count_(state.key_count),
+  records_per_page_(state.records_per_page),
+  scan_length_(state.scan_length),
+  read_ratio_(state.read_ratio),
+  scan_ratio_(state.scan_ratio),
+  flush_ratio_(state.flush_ratio),
+  insert_ratio_(state.insert_ratio),
+  distribution_type_(state.distribution_type),
+  scan_page_(0),
+  scan_last_page_(0),
+  flush_pending_(false),
+  flush_page_(0),
+  log_enabled_(state.log_device_type != DEVICE_TYPE_INVALID),
+  commit_pending_(false),
+  zipf_generator_(state.key_count, state.zipf_theta, generator_seed),
+  scrambled_zipf_generator_(state.key_count, state.zipf_theta, generator_seed),
+  hotspot_generator_(state.key_count,
+                     state.hot_set_ratio,
+                     state.hot_operation_ratio,
+                     generator_seed),
+  latest_generator_(state.key_count, state.zipf_theta, generator_seed),
+  operation_generator_(generator_seed),
+  key_batch_(key_batch_size),
+  key_batch_itr_(key_batch_size) {
+  // Nothing to do here!
+}
+
+void WorkloadGenerator::FillKeys(){
+
+  switch(distribution_type_){
+    case DISTRIBUTION_TYPE_ZIPF:
+      zipf_generator_.Fill(key_batch_.data(), key_batch_size);
+      break;
+
+    case DISTRIBUTION_TYPE_SCRAMBLED_ZIPF:
+      scrambled_zipf_generator_.Fill(key_batch_.data(), key_batch_size);
+      break;
+
+    case DISTRIBUTION_TYPE_HOTSPOT:
+      hotspot_generator_.Fill(key_batch_.data(), key_batch_size);
+      break;
+
+    case DISTRIBUTION_TYPE_LATEST:
+      latest_generator_.Fill(key_batch_.data(), key_batch_size);
+      break;
+
+    case DISTRIBUTION_TYPE_INVALID:
+    default:
+      exit(EXIT_FAILURE);
+  }
+
+  key_batch_itr_ = 0;
+}
+
+size_t WorkloadGenerator::GetNextKey(){
+
+  if(key_batch_itr_ == key_batch_size){
+    FillKeys();
+  }
+
+  return key_batch_[key_batch_itr_++];
+}
+
+void WorkloadGenerator::InsertKey(){
+
+  key_count_++;
+
+  zipf_generator_.SetItemCount(key_count_);
+  scrambled_zipf_generator_.SetItemCount(key_count_);
+  hotspot_generator_.SetItemCount(key_count_);
+  latest_generator_.SetItemCount(key_count_);
+
+}
+
+size_t WorkloadGenerator::GetPage(const size_t& record) const {
+  return record / records_per_page_;
+}
+
+size_t WorkloadGenerator::GetPageCount() const {
+  return GetPage(key_count_ - 1) + 1;
+}
+
+void WorkloadGenerator::GetNextOperation(char& operation_type,
+                                         size_t& block_id){
+
+  // Finish pending scan
+  if(scan_page_ < scan_last_page_){
+    scan_page_++;
+    operation_type = 'r';
+    block_id = scan_page_;
+    return;
+  }
+
+  // Commit the last update
+  if(commit_pending_ == true){
+    commit_pending_ = false;
+    operation_type = 't';
+    block_id = flush_page_;
+    return;
+  }
+
+  // Flush the last updated page
+  if(flush_pending_ == true){
+    flush_pending_ = false;
+    operation_type = 'f';
+    block_id = flush_page_;
+    return;
+  }
+
+  // Distributions generate records in [1, key_count]
+  auto record = GetNextKey() - 1;
+  auto page = GetPage(record);
+
+  auto coin = operation_generator_.NextUniform();
+
+  // READ
+  if(coin < read_ratio_){
+    operation_type = 'r';
+    block_id = page;
+
+    // Scan a range of records starting at the chosen one
+    if(operation_generator_.NextUniform() < scan_ratio_){
+      auto last_record = std::min(record + scan_length_, key_count_) - 1;
+      scan_page_ = page;
+      scan_last_page_ = GetPage(last_record);
+    }
+    return;
+  }
+
+  // INSERT appends a record to the key space
+  if(operation_generator_.NextUniform() < insert_ratio_){
+    record = key_count_;
+    page = GetPage(record);
+    InsertKey();
+  }
+
+  // UPDATE
+  operation_type = 'w';
+  block_id = page;
+
+  if(operation_generator_.NextUniform() < flush_ratio_){
+    flush_pending_ = true;
+  }
+  flush_page_ = page;
+  commit_pending_ = log_enabled_;
+
+}
+
+}  // End machine namespace
@@ -6,10 +6,17 @@
 #include <cmath>
 
 #include "policy.h"
+#include "stream_table.h"
 
+#include "policy_2q.h"
 #include "policy_arc.h"
+#include "policy_clock.h"
+#include "policy_clock_pro.h"
+#include "policy_wtinylfu.h"
 #include "policy_fifo.h"
+#include "policy_greedy_dual.h"
 #include "policy_lfu.h"
+#include "policy_lirs.h"
 #include "policy_lru.h"
 
 namespace machine {
@@ -40,10 +47,24 @@ class Cache {
 
   size_t CurrentCapacity() const;
 
+  // append the resident keys
+  void GetKeys(std::vector<Key>& keys) const;
+
   void Print() const;
 
   bool IsSequential(const size_t& next);
 
+  // cost of evicting a clean and a dirty element (ns)
+  void SetEvictionCost(const uint64_t& clean_cost,
+                       const uint64_t& dirty_cost);
+
+  // append entries and policy metadata to a snapshot
+  void Serialize(std::vector<uint64_t>& buffer) const;
+
+  // restore entries and policy metadata from a snapshot
+  void Deserialize(const uint64_t*& cursor,
+                   const uint64_t* end);
+
  protected:
 
   void Insert(const Key& key, const Value& value);
@@ -61,7 +82,8 @@ class Cache {
 
   size_t capacity_;
 
-  size_t current_block_;
+  // concurrent sequential streams seen by this tier
+  StreamTable stream_table_;
 
 };
 
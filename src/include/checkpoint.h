@@ -0,0 +1,50 @@
+// CHECKPOINT HEADER
+
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+
+namespace machine {
+
+// Checkpoints flush every dirty block at once. Tracks how long they take
+// and how the foreground operations issued while one is running fare
+// against the others.
+class CheckpointTracker {
+ public:
+
+  // A checkpoint of block_count blocks ran from start_time to end_time (ns)
+  void RecordCheckpoint(const double& start_time,
+                        const double& end_time,
+                        const size_t& block_count);
+
+  // A foreground operation issued at issue_time took latency (ns)
+  void RecordLatency(const double& issue_time,
+                     const double& latency);
+
+  size_t GetCheckpointCount() const;
+
+  void ResetStats();
+
+  friend std::ostream& operator<< (std::ostream& stream,
+                                   const CheckpointTracker& checkpointer);
+
+ private:
+
+  // end of the latest checkpoint
+  double end_time_ = 0;
+
+  size_t checkpoint_count_ = 0;
+  size_t block_count_ = 0;
+  double total_duration_ = 0;
+  double max_duration_ = 0;
+
+  // foreground operations during and outside of checkpoints
+  size_t overlap_count_ = 0;
+  double overlap_latency_ = 0;
+  size_t other_count_ = 0;
+  double other_latency_ = 0;
+
+};
+
+}  // End machine namespace
@@ -5,6 +5,7 @@
 #include <getopt.h>
 #include <sys/time.h>
 #include <iostream>
+#include <map>
 #include <string>
 #include <vector>
 
@@ -33,15 +34,142 @@ class configuration {
   // file name
   std::string file_name;
 
-  // migration frequency
+  // migration frequency (default accesses before a promotion)
   size_t migration_frequency;
 
+  // accesses within a window before moving into DRAM / CACHE (0 uses the
+  // migration frequency)
+  size_t dram_promotion_threshold;
+  size_t cache_promotion_threshold;
+
+  // accesses after which promotion counts are halved
+  size_t promotion_window;
+
+  // migrations and write-backs in flight in the background (0 runs them
+  // in the foreground)
+  size_t migration_queue_depth;
+
+  // bandwidth budget of the background migrations (MB/s, 0 is unlimited)
+  double migration_bandwidth;
+
+  // operations between flusher wake-ups
+  size_t flush_interval;
+
+  // dirty ratio of a volatile tier that starts the flusher (0 is off)
+  double flush_high_watermark;
+
+  // dirty ratio the flusher cleans down to
+  double flush_low_watermark;
+
+  // operations between checkpoints (0 is off)
+  size_t checkpoint_interval;
+
+  // device holding the write-ahead log (invalid is no log)
+  DeviceType log_device_type;
+
+  // delay before a group commit is flushed (ns)
+  double log_commit_interval;
+
+  // bytes appended to the log per record
+  size_t log_record_size;
+
+  // operations per rebalancing epoch (0 is off)
+  size_t rebalance_epoch;
+
+  // blocks moved into DRAM per epoch
+  size_t rebalance_budget;
+
   // operation count
   size_t operation_count;
 
+  // operations replayed before statistics are reset
+  size_t warmup_operation_count;
+
+  // concurrent clients (more than one runs the event engine)
+  size_t client_count;
+
+  // device service models overriding the defaults
+  std::map<DeviceType, DeviceServiceModel> service_models;
+
+  // tier policies and capacities overriding the defaults
+  std::map<DeviceType, TierModel> tier_models;
+
+  // tiers read from a topology file, top first (replaces the hierarchy type)
+  std::vector<TierSpec> topology;
+
+  // whether promotions leave a copy in the lower tier
+  InclusionType inclusion_type;
+
+  // SSD spare capacity over the logical pages (0 turns off the FTL)
+  double ftl_overprovisioning;
+
+  // pages in an SSD erase block
+  size_t ftl_pages_per_block;
+
+  // writes an NVM cell endures
+  double nvm_endurance;
+
+  // NVM writes after which a block is kept in DRAM (0 is off)
+  size_t nvm_wear_threshold;
+
+  // largest readahead window in blocks (0 is off)
+  size_t readahead_window;
+
+  // concurrent sequential streams tracked per tier
+  size_t stream_count;
+
   // Verbose output
   bool verbose;
 
+  // GENERATOR MODE
+
+  // synthesize the workload instead of reading a trace file
+  bool generator_mode;
+
+  // fraction of read operations
+  double read_ratio;
+
+  // fraction of reads that are range scans
+  double scan_ratio;
+
+  // fraction of updates followed by a flush
+  double flush_ratio;
+
+  // fraction of writes that insert a new record
+  double insert_ratio;
+
+  // key distribution
+  DistributionType distribution_type;
+
+  // hotspot: fraction of keys that are hot
+  double hot_set_ratio;
+
+  // hotspot: fraction of operations on hot keys
+  double hot_operation_ratio;
+
+  // number of records
+  size_t key_count;
+
+  // zipf skew over records
+  double zipf_theta;
+
+  // records packed in a page
+  size_t records_per_page;
+
+  // records covered by a scan
+  size_t scan_length;
+
+  // SNAPSHOT
+
+  // snapshot written during the replay
+  std::string save_snapshot_file;
+
+  // operation after which the snapshot is written
+  size_t snapshot_operation;
+
+  // snapshot to resume the replay from
+  std::string load_snapshot_file;
+
   // DERIVED BASED ON HIERARCHY TYPE
 
   // list of devices in hierarchy
@@ -18,6 +18,9 @@ struct Device {
          const size_t& device_size)
   : device_type(device_type),
     device_size(device_size),
+    volatile_device(device_type == DEVICE_TYPE_CACHE ||
+                    device_type == DEVICE_TYPE_DRAM),
+    memory_device(device_type != DEVICE_TYPE_SSD),
     cache(device_type, caching_type, device_size){
     // Nothing to do here!
   }
@@ -28,11 +31,128 @@ struct Device {
   // size of the device (in pages)
   size_t device_size = 0;
 
+  // contents are lost on a crash
+  bool volatile_device = false;
+
+  // blocks are read in place (otherwise copied into memory first)
+  bool memory_device = false;
+
   // storage cache
   StorageCache cache;
 
 };
 
+// Device access made by an operation (a wait when there is no device)
+struct DeviceAccess {
+  DeviceType device_type;
+  double latency;
+
+  // end of a wait without a device (ns, absolute)
+  double ready_time = 0;
+};
+
+// Service model of a device
+struct DeviceServiceModel {
+  // requests served concurrently
+  size_t channel_count = 1;
+
+  // transfer bandwidth shared by the channels (MB/s, 0 is unlimited)
+  double bandwidth = 0;
+
+  // requests admitted at once (0 is unlimited)
+  size_t queue_depth = 0;
+};
+
+// Tier overriding the caching type and size type
+struct TierModel {
+  // replacement policy
+  CachingType caching_type = CACHING_TYPE_INVALID;
+
+  // capacity in 4K blocks (0 keeps the size type)
+  size_t size = 0;
+};
+
+// Tier declared by a topology file
+struct TierSpec {
+  std::string name;
+
+  DeviceType device_type = DEVICE_TYPE_INVALID;
+
+  bool volatile_device = false;
+
+  bool memory_device = false;
+
+  CachingType caching_type = CACHING_TYPE_INVALID;
+
+  // capacity in 4K blocks (0 holds every block)
+  size_t size = 0;
+
+  // latencies (ns, 0 keeps the default of a built-in device)
+  double read_latency = 0;
+  double write_latency = 0;
+
+  // requests served concurrently (0 keeps the default)
+  size_t channel_count = 0;
+};
+
+// Record the device accesses of the current operation (event engine)
+void SetDeviceAccessRecorder(std::vector<DeviceAccess>* recorder);
+
+// Number of requests a device can serve concurrently
+size_t GetDeviceParallelism(const DeviceType& device_type);
+
+// Serve a request that arrives at arrival_time and occupies a channel for
+// latency, and return its completion time (ns)
+double ServeDeviceRequest(const DeviceType& device_type,
+                          const double& arrival_time,
+                          const double& latency);
+
+// Drop in-flight requests and restart the device clock
+void ResetDeviceServiceState();
+
+// Current time of the issuing client (event engine)
+void SetDeviceClock(const double& time);
+double GetDeviceClock();
+
+// Accesses between these calls run in the background: they occupy the
+// devices but are not charged. Returns when the last one completes (ns).
+void BeginBackgroundAccess();
+double EndBackgroundAccess();
+
+// Wait for a background access that completes at ready_time, returns
+// the stall (ns)
+double WaitForDevice(const double& ready_time);
+
+// Accesses between these calls form a job of the migration queue. Begin
+// returns false when there is no queue (the job runs in the foreground)
+// and adds the wait for a free slot to total_duration.
+bool BeginMigration(double& total_duration);
+void EndMigration(const size_t& block_id);
+
+// Wait for the block if a migration is moving it, returns the stall (ns)
+double WaitForMigration(const size_t& block_id);
+
+// Start the SSD with empty flash
+void ResetFlashTranslationLayer();
+
+// Lay out a block in the SSD flash without charging the write
+void BootstrapFlashPage(const size_t& block_id);
+
+class FlashTranslationLayer;
+
+// SSD flash (nullptr without overprovisioning)
+FlashTranslationLayer* GetFlashTranslationLayer();
+
+class WearTracker;
+
+// Write counts of the NVM blocks
+WearTracker& GetNVMWear();
+
+class MigrationQueue;
+
+// Background migrations (nullptr without a queue depth)
+MigrationQueue* GetMigrationQueue();
+
 size_t GetWriteLatency(std::vector<Device>& devices,
                        DeviceType device_type,
                        const size_t& block_id);
@@ -43,6 +163,9 @@ size_t GetReadLatency(std::vector<Device>& devices,
 
 void BootstrapDeviceMetrics(const configuration &state);
 
+// Latency of a sequential block write (ns)
+double GetSequentialWriteLatency(const DeviceType& device_type);
+
 void Copy(std::vector<Device>& devices,
           DeviceType destination,
           DeviceType source,
@@ -53,6 +176,31 @@ void Copy(std::vector<Device>& devices,
 DeviceType LocateInDevices(std::vector<Device> devices,
                            const size_t& block_id);
 
+// Check residency without touching the replacement policy
+bool IsResident(StorageCache& device_cache, const size_t& block_id);
+
+// Precompute the links between the tiers of the hierarchy (top first)
+void BuildTierChain(const std::vector<Device>& devices);
+
+// Price the clean and dirty victims of each tier with the latencies of
+// the tier below (set by BootstrapDeviceMetrics)
+void SetEvictionCosts(std::vector<Device>& devices);
+
+// Device types of the tiers
+const std::vector<DeviceType>& GetTierDeviceTypes();
+
+// Device that takes the victims of source
+DeviceType GetLowerDevice(std::vector<Device>& devices,
+                          DeviceType source);
+
+// Device that source promotes blocks into
+DeviceType GetUpperDevice(DeviceType source);
+
+// First persistent device below source
+DeviceType GetPersistentLowerDevice(DeviceType source);
+
+bool IsVolatileTier(DeviceType device_type);
+
 bool DeviceExists(std::vector<Device>& devices,
                   const DeviceType& device_type);
 
@@ -0,0 +1,37 @@
+// DIRTY INDEX HEADER
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace machine {
+
+// Dirty blocks of a tier as a bitset over the dense block ids, so that
+// the flusher and checkpoints find them without scanning the tier
+class DirtyIndex {
+ public:
+
+  void Set(const size_t& block_id);
+
+  void Clear(const size_t& block_id);
+
+  bool Test(const size_t& block_id) const;
+
+  size_t GetCount() const;
+
+  // append the dirty blocks in ascending order
+  void GetBlocks(std::vector<size_t>& blocks) const;
+
+  void Reset();
+
+ private:
+
+  std::vector<uint64_t> words_;
+
+  size_t count_ = 0;
+
+};
+
+}  // End machine namespace
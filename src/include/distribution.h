@@ -2,9 +2,13 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cmath>
 #include <cstdint>
+#include <cstdlib>
+#include <string>
 #include <thread>
+#include <vector>
 
 namespace machine {
 
@@ -68,20 +72,29 @@ class UniformDistribution {
 };
 
 
+// Zeta is O(n) to compute; FastZipfDistribution avoids it
+inline double ComputeZeta(const uint64_t &n, const double &theta) {
+  double sum = 0;
+  for (uint64_t i = 1; i <= n; i++) sum += pow(1.0 / i, theta);
+  return sum;
+}
+
 class ZipfDistribution {
  public:
-  ZipfDistribution(const uint64_t &n, const double &theta)
-      : rand_generator(rand()) {
+  ZipfDistribution(const uint64_t &n, const double &theta,
+                   const unsigned long &seed = rand())
+      : rand_generator(seed) {
     // range: 1-n
     the_n = n;
     zipf_theta = theta;
     zeta_2_theta = zeta(2, zipf_theta);
     denom = zeta(the_n, zipf_theta);
+    alpha = 1 / (1 - zipf_theta);
+    eta = (1 - pow(2.0 / the_n, 1 - zipf_theta)) / (1 - zeta_2_theta / denom);
+    half_pow_theta = 1 + pow(0.5, zipf_theta);
   }
   double zeta(uint64_t n, double theta) {
-    double sum = 0;
-    for (uint64_t i = 1; i <= n; i++) sum += pow(1.0 / i, theta);
-    return sum;
+    return ComputeZeta(n, theta);
   }
 
   int GenerateInteger(const int &min, const int &max) {
@@ -89,14 +102,10 @@ class ZipfDistribution {
   }
 
   uint64_t GetNextNumber() {
-    double alpha = 1 / (1 - zipf_theta);
-    double zetan = denom;
-    double eta =
-        (1 - pow(2.0 / the_n, 1 - zipf_theta)) / (1 - zeta_2_theta / zetan);
-    double u = (double)(GenerateInteger(1, 10000000) % 10000000) / 10000000;
-    double uz = u * zetan;
+    double u = rand_generator.NextUniform();
+    double uz = u * denom;
     if (uz < 1) return 1;
-    if (uz < 1 + pow(0.5, zipf_theta)) return 2;
+    if (uz < half_pow_theta) return 2;
     return 1 + (uint64_t)(the_n * pow(eta * u - eta + 1, alpha));
   }
 
@@ -104,7 +113,222 @@ class ZipfDistribution {
   double zipf_theta;
   double denom;
   double zeta_2_theta;
+  double alpha;
+  double eta;
+  double half_pow_theta;
+  UniformDistribution rand_generator;
+};
+
+// Rejection-inversion sampler (Hormann and Derflinger) with O(1) setup and
+// O(1) expected draws for any theta >= 0, including theta = 1
+class FastZipfDistribution {
+ public:
+  FastZipfDistribution(const uint64_t &n, const double &theta,
+                       const unsigned long &seed = rand())
+      : the_n(n), zipf_theta(theta), rand_generator(seed) {
+    // range: 1-n
+    h_integral_x1 = HIntegral(1.5) - 1.0;
+    h_integral_n = HIntegral(the_n + 0.5);
+    s = 2.0 - HIntegralInverse(HIntegral(2.5) - H(2.0));
+  }
+
+  // O(1), so the key space can grow with inserts
+  void SetItemCount(const uint64_t &n) {
+    the_n = n;
+    h_integral_n = HIntegral(the_n + 0.5);
+  }
+
+  uint64_t GetNextNumber() {
+    while (true) {
+      double u = h_integral_n +
+          rand_generator.NextUniform() * (h_integral_x1 - h_integral_n);
+      uint64_t k;
+      if (Accept(u, k)) return k;
+    }
+  }
+
+  // Draw the uniforms first, then invert them in a separate branch-light
+  // pass; the rare rejected slots are redrawn one at a time
+  void Fill(uint64_t *keys, const size_t &count) {
+    uniforms.resize(count);
+    for (size_t i = 0; i < count; i++) uniforms[i] = rand_generator.NextUniform();
+
+    double range = h_integral_x1 - h_integral_n;
+    for (size_t i = 0; i < count; i++) {
+      double u = h_integral_n + uniforms[i] * range;
+      if (!Accept(u, keys[i])) keys[i] = GetNextNumber();
+    }
+  }
+
+  uint64_t the_n;
+  double zipf_theta;
+  UniformDistribution rand_generator;
+
+ private:
+  inline bool Accept(const double &u, uint64_t &k) const {
+    double x = HIntegralInverse(u);
+    k = (uint64_t)(x + 0.5);
+    if (k < 1) k = 1;
+    else if (k > the_n) k = the_n;
+    return (k - x <= s || u >= HIntegral(k + 0.5) - H(k));
+  }
+
+  // integral of H from 1 to x, shifted so that it is defined at theta = 1
+  inline double HIntegral(const double &x) const {
+    double log_x = log(x);
+    return Helper2((1.0 - zipf_theta) * log_x) * log_x;
+  }
+
+  inline double H(const double &x) const {
+    return exp(-zipf_theta * log(x));
+  }
+
+  inline double HIntegralInverse(const double &x) const {
+    double t = x * (1.0 - zipf_theta);
+    if (t < -1.0) t = -1.0;
+    return exp(Helper1(t) * x);
+  }
+
+  // log(1 + x) / x, stable near zero
+  static inline double Helper1(const double &x) {
+    if (fabs(x) > 1e-8) return log1p(x) / x;
+    return 1.0 - x * (0.5 - x * (1.0 / 3.0 - 0.25 * x));
+  }
+
+  // (exp(x) - 1) / x, stable near zero
+  static inline double Helper2(const double &x) {
+    if (fabs(x) > 1e-8) return expm1(x) / x;
+    return 1.0 + x * 0.5 * (1.0 + x * (1.0 / 3.0) * (1.0 + 0.25 * x));
+  }
+
+  double h_integral_x1;
+  double h_integral_n;
+  double s;
+  std::vector<double> uniforms;
+};
+
+// 64-bit FNV-1a over the bytes of a value
+inline uint64_t FNVHash64(uint64_t value) {
+  uint64_t hash = 0xCBF29CE484222325ULL;
+  for (int i = 0; i < 8; i++) {
+    hash ^= (value & 0xFF);
+    hash *= 0x100000001B3ULL;
+    value >>= 8;
+  }
+  return hash;
+}
+
+// Zipf over ranks with the ranks hashed across the key space, so that
+// hot keys are not numerically adjacent. As in YCSB, ranks are hashed
+// modulo the item count at construction, so that inserts do not move the
+// hot keys; only the rank generator follows the item count.
+class ScrambledZipfDistribution {
+ public:
+  ScrambledZipfDistribution(const uint64_t &n, const double &theta,
+                            const unsigned long &seed = rand())
+      : the_n(n), rank_generator(n, theta, seed) {
+    // range: 1-n
+  }
+
+  void SetItemCount(const uint64_t &n) {
+    rank_generator.SetItemCount(n);
+  }
+
+  uint64_t GetNextNumber() {
+    return 1 + FNVHash64(rank_generator.GetNextNumber()) % the_n;
+  }
+
+  void Fill(uint64_t *keys, const size_t &count) {
+    rank_generator.Fill(keys, count);
+    for (size_t i = 0; i < count; i++) keys[i] = 1 + FNVHash64(keys[i]) % the_n;
+  }
+
+  uint64_t the_n;
+  FastZipfDistribution rank_generator;
+};
+
+// A fraction of the operations goes to a fraction of the keys, both
+// uniformly at random (hot keys form the prefix of the key space)
+class HotspotDistribution {
+ public:
+  HotspotDistribution(const uint64_t &n,
+                      const double &hot_set_fraction,
+                      const double &hot_operation_fraction,
+                      const unsigned long &seed = rand())
+      : hot_set_fraction(hot_set_fraction),
+        hot_operation_fraction(hot_operation_fraction),
+        rand_generator(seed) {
+    // range: 1-n
+    SetItemCount(n);
+  }
+
+  void SetItemCount(const uint64_t &n) {
+    the_n = n;
+    hot_n = std::max<uint64_t>(1, (uint64_t)(the_n * hot_set_fraction));
+    hot_n = std::min(hot_n, the_n);
+  }
+
+  uint64_t GetNextNumber() {
+    double coin = rand_generator.NextUniform();
+    double u = rand_generator.NextUniform();
+    return Select(coin, u);
+  }
+
+  void Fill(uint64_t *keys, const size_t &count) {
+    coins.resize(count);
+    uniforms.resize(count);
+    for (size_t i = 0; i < count; i++) {
+      coins[i] = rand_generator.NextUniform();
+      uniforms[i] = rand_generator.NextUniform();
+    }
+    for (size_t i = 0; i < count; i++) keys[i] = Select(coins[i], uniforms[i]);
+  }
+
+  uint64_t the_n;
+  uint64_t hot_n;
+  double hot_set_fraction;
+  double hot_operation_fraction;
   UniformDistribution rand_generator;
+
+ private:
+  // branch-free choice between the hot and the cold range
+  inline uint64_t Select(const double &coin, const double &u) const {
+    uint64_t cold_n = the_n - hot_n;
+    bool hot = (coin < hot_operation_fraction) || (cold_n == 0);
+    uint64_t base = hot ? 1 : hot_n + 1;
+    uint64_t span = hot ? hot_n : cold_n;
+    return base + (uint64_t)(u * span);
+  }
+
+  std::vector<double> coins;
+  std::vector<double> uniforms;
+};
+
+// Zipf skewed toward the most recently inserted keys
+class LatestDistribution {
+ public:
+  LatestDistribution(const uint64_t &n, const double &theta,
+                     const unsigned long &seed = rand())
+      : the_n(n), recency_generator(n, theta, seed) {
+    // range: 1-n
+  }
+
+  void SetItemCount(const uint64_t &n) {
+    the_n = n;
+    recency_generator.SetItemCount(n);
+  }
+
+  uint64_t GetNextNumber() {
+    return the_n + 1 - recency_generator.GetNextNumber();
+  }
+
+  void Fill(uint64_t *keys, const size_t &count) {
+    recency_generator.Fill(keys, count);
+    for (size_t i = 0; i < count; i++) keys[i] = the_n + 1 - keys[i];
+  }
+
+  uint64_t the_n;
+  FastZipfDistribution recency_generator;
 };
 
 
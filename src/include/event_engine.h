@@ -0,0 +1,99 @@
+// EVENT ENGINE HEADER
+
+#pragma once
+
+#include <functional>
+#include <map>
+#include <ostream>
+#include <queue>
+#include <vector>
+
+#include "device.h"
+
+namespace machine {
+
+// Discrete-event simulation of concurrent clients sharing the devices.
+// Every client keeps one operation outstanding. An operation is the
+// sequence of device accesses recorded while it runs functionally; each
+// access is served by the device service model when it arrives.
+class EventEngine {
+ public:
+
+  EventEngine(const size_t& client_count);
+
+  // Replay until issue_operation runs out of operations
+  void Run(const std::function<bool()>& issue_operation);
+
+  // Restart throughput and queueing statistics at the current time
+  void ResetStats();
+
+  // simulated time (ns)
+  double GetCurrentTime() const;
+
+  // simulated time since the last reset (ns)
+  double GetElapsedTime() const;
+
+  friend std::ostream& operator<< (std::ostream& stream,
+                                   const EventEngine& engine);
+
+ private:
+
+  struct Event {
+    double time;
+    size_t sequence;
+    size_t client_id;
+
+    bool operator>(const Event& other) const {
+      if(time != other.time){
+        return time > other.time;
+      }
+      return sequence > other.sequence;
+    }
+  };
+
+  struct Client {
+    // accesses of the outstanding operation
+    std::vector<DeviceAccess> accesses;
+    size_t stage = 0;
+    double start_time = 0;
+    bool active = false;
+  };
+
+  struct DeviceQueue {
+    size_t servers = 1;
+
+    size_t request_count = 0;
+
+    // time spent beyond the channel latency (queueing and transfer)
+    double wait_time = 0;
+    double max_wait_time = 0;
+
+    double busy_time = 0;
+  };
+
+  void Schedule(const double& time, const size_t& client_id);
+
+  void Submit(const size_t& client_id, const DeviceAccess& access);
+
+  void Complete(const size_t& client_id);
+
+  void Advance(const size_t& client_id,
+               const std::function<bool()>& issue_operation);
+
+  std::vector<Client> clients_;
+
+  std::map<DeviceType, DeviceQueue> device_queues_;
+
+  std::priority_queue<Event, std::vector<Event>, std::greater<Event>> events_;
+
+  double current_time_ = 0;
+
+  double reset_time_ = 0;
+
+  size_t sequence_ = 0;
+
+  size_t completed_operation_count_ = 0;
+
+};
+
+}  // End machine namespace
@@ -0,0 +1,65 @@
+// FLUSHER HEADER
+
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <ostream>
+#include <vector>
+
+#include "types.h"
+
+namespace machine {
+
+// Background write-back of the volatile tiers in the style of the kernel
+// flusher threads. Every interval operations each tier is checked, and a
+// tier whose dirty ratio passes the high watermark is cleaned down to the
+// low watermark. Blocks go out in ascending order, sweeping the block
+// space like an elevator, so that adjacent blocks form sequential runs.
+class DirtyFlusher {
+ public:
+
+  DirtyFlusher(const size_t& interval,
+               const double& high_watermark,
+               const double& low_watermark);
+
+  // Count an operation, returns true when the flusher wakes up
+  bool Tick();
+
+  // Pick the blocks to write back from the dirty blocks of a tier that
+  // holds capacity blocks, in write-back order
+  void Plan(const DeviceType& device_type,
+            std::vector<size_t>& dirty_blocks,
+            const size_t& capacity,
+            std::vector<size_t>& flush_blocks);
+
+  void ResetStats();
+
+  friend std::ostream& operator<< (std::ostream& stream,
+                                   const DirtyFlusher& flusher);
+
+ private:
+
+  struct FlushStats {
+    size_t batch_count = 0;
+    size_t block_count = 0;
+    // runs of adjacent blocks
+    size_t run_count = 0;
+  };
+
+  size_t interval_;
+
+  double high_watermark_;
+
+  double low_watermark_;
+
+  size_t operation_count_;
+
+  // next block of the sweep in each tier
+  std::map<DeviceType, size_t> cursor_;
+
+  std::map<DeviceType, FlushStats> stats_;
+
+};
+
+}  // End machine namespace
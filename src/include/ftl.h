@@ -0,0 +1,104 @@
+// FLASH TRANSLATION LAYER HEADER
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace machine {
+
+// Flash work done on behalf of one host write
+struct FlashWrite {
+  // valid pages copied out of garbage collected blocks
+  size_t relocated_page_count = 0;
+
+  // erase blocks reclaimed
+  size_t erased_block_count = 0;
+
+  // garbage collection time (ns)
+  double stall = 0;
+};
+
+// Page-mapped FTL with out-of-place writes and greedy garbage collection.
+// The flash keeps overprovisioning spare pages on top of the logical pages
+// it has seen, so the drive is always full from the host's point of view.
+class FlashTranslationLayer {
+ public:
+
+  FlashTranslationLayer(const double& overprovisioning,
+                        const size_t& pages_per_block,
+                        const double& page_read_latency,
+                        const double& page_write_latency,
+                        const double& erase_latency);
+
+  // Lay out a logical page without charging the host
+  void Bootstrap(const size_t& logical_page);
+
+  // Program a logical page, collecting garbage when free blocks run out
+  FlashWrite Write(const size_t& logical_page);
+
+  // number of logical pages mapped
+  size_t GetLogicalPageCount() const;
+
+  // number of erase blocks
+  size_t GetBlockCount() const;
+
+  // Save the page mapping, valid page counts and free blocks
+  void Serialize(std::vector<uint64_t>& buffer) const;
+
+  void Deserialize(const uint64_t*& cursor,
+                   const uint64_t* end);
+
+ private:
+
+  // Map a logical page to the next free physical page
+  void Program(const size_t& logical_page, FlashWrite& flash_write);
+
+  // Start writing into a free erase block
+  void OpenBlock(FlashWrite& flash_write);
+
+  // Reclaim the erase block with the fewest valid pages
+  bool CollectGarbage(FlashWrite& flash_write);
+
+  // Erase blocks that keep the overprovisioning ratio for the mapped
+  // logical pages
+  size_t GetTargetBlockCount() const;
+
+  // Add erase blocks to keep the overprovisioning ratio
+  void Grow();
+
+  void AddBlock();
+
+  double overprovisioning_;
+
+  size_t pages_per_block_;
+
+  double page_read_latency_;
+  double page_write_latency_;
+  double erase_latency_;
+
+  // logical page -> physical page
+  std::unordered_map<size_t, size_t> mapping_;
+
+  // physical page -> logical page (invalid_page when free or stale)
+  std::vector<size_t> reverse_mapping_;
+
+  // valid pages in each erase block
+  std::vector<size_t> valid_page_count_;
+
+  std::vector<bool> free_block_;
+
+  std::vector<size_t> free_blocks_;
+
+  size_t active_block_;
+
+  size_t write_offset_;
+
+  // relocations write into the reserved block instead of collecting again
+  bool collecting_ = false;
+
+};
+
+}  // End machine namespace
@@ -0,0 +1,83 @@
+// GENERATOR HEADER
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "distribution.h"
+#include "types.h"
+
+namespace machine {
+
+class configuration;
+
+// Synthesizes a YCSB-style read/write/flush stream over pages
+class WorkloadGenerator {
+ public:
+
+  WorkloadGenerator(const configuration& state);
+
+  // get the next operation in the stream
+  void GetNextOperation(char& operation_type, size_t& block_id);
+
+  // number of pages spanned by the key space
+  size_t GetPageCount() const;
+
+ private:
+
+  size_t GetPage(const size_t& record) const;
+
+  // next record from the key distribution (1-based)
+  size_t GetNextKey();
+
+  // refill the key batch
+  void FillKeys();
+
+  // record a newly inserted key
+  void InsertKey();
+
+  // number of records
+  size_t key_count_;
+
+  // records packed in a page
+  size_t records_per_page_;
+
+  // records covered by a scan
+  size_t scan_length_;
+
+  // operation mix
+  double read_ratio_;
+  double scan_ratio_;
+  double flush_ratio_;
+  double insert_ratio_;
+
+  // key distribution
+  DistributionType distribution_type_;
+
+  // pending scan pages
+  size_t scan_page_;
+  size_t scan_last_page_;
+
+  // pending flush
+  bool flush_pending_;
+  size_t flush_page_;
+
+  // updates are committed to the write-ahead log
+  bool log_enabled_;
+  bool commit_pending_;
+
+  FastZipfDistribution zipf_generator_;
+  ScrambledZipfDistribution scrambled_zipf_generator_;
+  HotspotDistribution hotspot_generator_;
+  LatestDistribution latest_generator_;
+
+  UniformDistribution operation_generator_;
+
+  // batch of pre-generated keys
+  std::vector<uint64_t> key_batch_;
+  size_t key_batch_itr_;
+
+};
+
+}  // End machine namespace
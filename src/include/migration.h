@@ -0,0 +1,81 @@
+// MIGRATION HEADER
+
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace machine {
+
+// Promotions and dirty write-backs handed to a background daemon.
+// At most queue_depth jobs are in flight, and a new job starts once the
+// bandwidth budget (MB/s, 0 is unlimited) has paced out the previous one.
+// The foreground waits only for a free slot or for a block in flight.
+class MigrationQueue {
+ public:
+
+  MigrationQueue(const size_t& queue_depth,
+                 const double& bandwidth,
+                 const size_t& block_size);
+
+  // Time a job submitted at arrival_time gets a slot in the queue
+  double Admit(const double& arrival_time);
+
+  // Time an admitted job starts moving data
+  double GetStartTime(const double& admission_time) const;
+
+  // Account for a job that moves the block from start_time until the
+  // devices finish at device_time, returns its completion time
+  double Complete(const size_t& block_id,
+                  const double& start_time,
+                  const double& device_time);
+
+  // Completion time of the block if it is still in flight at now
+  bool IsInFlight(const size_t& block_id,
+                  const double& now,
+                  double& ready_time);
+
+  // Foreground time lost to the queue
+  void RecordFullStall(const double& stall);
+  void RecordInFlightStall(const double& stall);
+
+  void ResetStats();
+
+  friend std::ostream& operator<< (std::ostream& stream,
+                                   const MigrationQueue& migration_queue);
+
+ private:
+
+  using Job = std::pair<double, size_t>;
+
+  // Drop the jobs done by now
+  void Retire(const double& now);
+
+  size_t queue_depth_;
+
+  // transfer time of a block at the bandwidth budget (ns)
+  double transfer_time_;
+
+  // earliest start of the next job
+  double pacing_clock_;
+
+  // in-flight jobs by completion time
+  std::priority_queue<Job, std::vector<Job>, std::greater<Job>> jobs_;
+
+  // completion time of the blocks in flight
+  std::unordered_map<size_t, double> in_flight_;
+
+  size_t job_count_ = 0;
+  double busy_time_ = 0;
+  size_t full_stall_count_ = 0;
+  double full_stall_time_ = 0;
+  size_t in_flight_stall_count_ = 0;
+  double in_flight_stall_time_ = 0;
+
+};
+
+}  // End machine namespace
@@ -2,9 +2,12 @@
 
 #pragma once
 
+#include <cstdint>
 #include <unordered_set>
+#include <vector>
 
 #include "macros.h"
+#include "snapshot.h"
 
 namespace machine {
 
@@ -26,6 +29,50 @@ class ICachePolicy {
   // return a key of a replacement candidate
   virtual const Key& Victim(const Key& key) const = 0;
 
+  // handle eviction of the replacement candidate, before it is erased
+  virtual void Evict(UNUSED_ATTRIBUTE const Key& key) {}
+
+  // handle a change of the element status (clean or dirty) in a cache
+  virtual void SetStatus(UNUSED_ATTRIBUTE const Key& key,
+                         UNUSED_ATTRIBUTE const size_t& block_status) {}
+
+  // set the cost of evicting a clean and a dirty element (ns)
+  virtual void SetEvictionCost(UNUSED_ATTRIBUTE const uint64_t& clean_cost,
+                               UNUSED_ATTRIBUTE const uint64_t& dirty_cost) {}
+
+  // append policy metadata (order, frequencies, ghost lists) to a snapshot
+  virtual void Serialize(std::vector<uint64_t>& buffer) const = 0;
+
+  // restore policy metadata from a snapshot ending at end, advancing the
+  // cursor
+  virtual void Deserialize(const uint64_t*& cursor,
+                           const uint64_t* end) = 0;
+
 };
 
+// SNAPSHOT HELPERS
+
+template <typename Container>
+void SerializeKeys(std::vector<uint64_t>& buffer,
+                   const Container& keys) {
+  buffer.push_back(keys.size());
+  for (auto& key : keys) {
+    buffer.push_back(static_cast<uint64_t>(key));
+  }
+}
+
+template <typename Container>
+void DeserializeKeys(const uint64_t*& cursor,
+                     const uint64_t* end,
+                     Container& keys) {
+  using Key = typename Container::value_type;
+  keys.clear();
+  CheckSnapshotSize(cursor, end, 1);
+  auto key_count = *cursor++;
+  CheckSnapshotSize(cursor, end, key_count);
+  for (uint64_t key_itr = 0; key_itr < key_count; key_itr++) {
+    keys.push_back(static_cast<Key>(*cursor++));
+  }
+}
+
 }  // End machine namespace
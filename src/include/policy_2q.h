@@ -0,0 +1,176 @@
+// 2Q HEADER
+
+#pragma once
+
+#include <algorithm>
+#include <list>
+#include <unordered_map>
+
+#include "macros.h"
+#include "policy.h"
+
+namespace machine {
+
+// 2Q (Johnson and Shasha, VLDB 1994). New keys enter a FIFO queue A1in
+// (25% of the capacity). Keys evicted from A1in are remembered in a ghost
+// queue A1out (50% of the capacity), and only a key missed again while in
+// A1out enters the LRU queue Am, so one-time keys never displace Am.
+template <typename Key>
+class TwoQCachePolicy : public ICachePolicy<Key> {
+ public:
+  using queue_iterator = typename std::list<Key>::iterator;
+
+  TwoQCachePolicy(const size_t& capacity)
+  : in_capacity_(std::max<size_t>(1, capacity/4)),
+    out_capacity_(std::max<size_t>(1, capacity/2)) {
+    // Nothing to do here!
+  }
+
+  ~TwoQCachePolicy() = default;
+
+  void Insert(const Key& key) override {
+
+    DLOG(INFO) << "2Q INSERT: " << key << "\n";
+
+    auto key_itr = key_finder_.find(key);
+    if(key_itr != key_finder_.end()){
+      MoveFront(key, QUEUE_AM);
+      return;
+    }
+
+    a1_in_.push_front(key);
+    key_finder_[key] = {a1_in_.begin(), QUEUE_A1_IN};
+
+  }
+
+  // A hit in A1in leaves the key in place: a burst of accesses counts once
+  void Touch(const Key& key) override {
+
+    auto key_itr = key_finder_.find(key);
+    if(key_itr != key_finder_.end() &&
+        key_itr->second.queue_type == QUEUE_AM){
+      MoveFront(key, QUEUE_AM);
+    }
+
+  }
+
+  // A key erased from A1in is remembered in A1out
+  void Erase(const Key& key) override {
+
+    DLOG(INFO) << "2Q ERASE: " << key << "\n";
+
+    auto key_itr = key_finder_.find(key);
+    if(key_itr == key_finder_.end()){
+      return;
+    }
+
+    switch(key_itr->second.queue_type){
+      case QUEUE_A1_IN:
+        MoveFront(key, QUEUE_A1_OUT);
+        if(a1_out_.size() > out_capacity_){
+          key_finder_.erase(a1_out_.back());
+          a1_out_.pop_back();
+        }
+        break;
+
+      case QUEUE_AM:
+        am_.erase(key_itr->second.position);
+        key_finder_.erase(key_itr);
+        break;
+
+      case QUEUE_A1_OUT:
+      default:
+        break;
+    }
+
+  }
+
+  // return a key of a displacement candidate
+  const Key& Victim(UNUSED_ATTRIBUTE const Key& key) const override {
+
+    if(am_.empty() || a1_in_.size() > in_capacity_){
+      DLOG(INFO) << "2Q VICTIM: " << a1_in_.back() << "\n";
+      return a1_in_.back();
+    }
+
+    DLOG(INFO) << "2Q VICTIM: " << am_.back() << "\n";
+    return am_.back();
+
+  }
+
+  void Serialize(std::vector<uint64_t>& buffer) const override {
+
+    SerializeKeys(buffer, a1_in_);
+    SerializeKeys(buffer, a1_out_);
+    SerializeKeys(buffer, am_);
+
+  }
+
+  void Deserialize(const uint64_t*& cursor,
+                   const uint64_t* end) override {
+
+    DeserializeKeys(cursor, end, a1_in_);
+    DeserializeKeys(cursor, end, a1_out_);
+    DeserializeKeys(cursor, end, am_);
+
+    key_finder_.clear();
+    for(auto queue_type : {QUEUE_A1_IN, QUEUE_A1_OUT, QUEUE_AM}){
+      auto& keys = GetQueue(queue_type);
+      for(auto itr = keys.begin(); itr != keys.end(); itr++){
+        key_finder_[*itr] = {itr, queue_type};
+      }
+    }
+
+  }
+
+ private:
+
+  enum QueueType {
+    QUEUE_A1_IN = 0,
+    QUEUE_A1_OUT = 1,
+    QUEUE_AM = 2
+  };
+
+  struct Entry {
+    queue_iterator position;
+    QueueType queue_type;
+  };
+
+  std::list<Key>& GetQueue(const QueueType& queue_type){
+    switch(queue_type){
+      case QUEUE_A1_IN:
+        return a1_in_;
+      case QUEUE_A1_OUT:
+        return a1_out_;
+      case QUEUE_AM:
+      default:
+        return am_;
+    }
+  }
+
+  // Move a tracked key to the front of a queue
+  void MoveFront(const Key& key, const QueueType& queue_type){
+    auto& entry = key_finder_[key];
+    auto& keys = GetQueue(queue_type);
+    keys.splice(keys.begin(), GetQueue(entry.queue_type), entry.position);
+    entry.queue_type = queue_type;
+  }
+
+  size_t in_capacity_;
+
+  size_t out_capacity_;
+
+  // resident keys seen once (FIFO)
+  std::list<Key> a1_in_;
+
+  // keys recently evicted from A1in
+  std::list<Key> a1_out_;
+
+  // resident keys seen again after leaving A1in (LRU)
+  std::list<Key> am_;
+
+  std::unordered_map<Key, Entry> key_finder_;
+
+};
+
+}  // End machine namespace
@@ -2,9 +2,10 @@
 
 #pragma once
 
-#include <deque>
+#include <list>
 #include <vector>
 #include <algorithm>
+#include <unordered_map>
 
 #include <glog/logging.h>
 
@@ -15,9 +16,14 @@ namespace machine {
 
 #define MAX(a,b) (((a)>(b))?(a):(b))
 
+// ARC (Megiddo and Modha, FAST 2003). T1 and T2 hold the resident keys
+// seen once and more than once, and B1 and B2 the keys recently evicted
+// from them. The cache evicts the key returned by Victim, and Erase moves
+// it to the matching ghost list, so the lists never drift from the cache.
 template <typename Key>
 class ARCCachePolicy : public ICachePolicy<Key> {
  public:
+  using arc_iterator = typename std::list<Key>::iterator;
 
   ARCCachePolicy(const size_t& capacity)
  : capacity(capacity),
@@ -31,26 +37,10 @@ class ARCCachePolicy : public ICachePolicy<Key> {
 
     DLOG(INFO) << "ARC INSERT : " << key << "\n";
 
-    if(Contains(B1, key)){
-      DLOG(INFO) << "B1 contains key";
-      size_t size_ratio = B2.size()/B1.size();
-      size_t b_ratio = MAX(size_ratio, 1);
-      p = std::min(capacity, p + b_ratio);
-      Replace(key);
-      DequeErase(B1, key);
-      T2.push_front(key);
-      DLOG(INFO) << "Moved it to T2";
-    }
-    else if(Contains(B2, key)){
-      DLOG(INFO) << "B2 contains key";
-      size_t size_ratio = B1.size()/B2.size();
-      size_t b_ratio = MAX(size_ratio, 1);
-      if(p >= b_ratio) {
-        p = MAX(0, p - b_ratio);
-      }
-      Replace(key);
-      DequeErase(B2, key);
-      T2.push_front(key);
+    if(Contains(LIST_B1, key) || Contains(LIST_B2, key)){
+      DLOG(INFO) << "Ghost hit";
+      p = GetTarget(key);
+      MoveFront(key, LIST_T2);
       DLOG(INFO) << "Moved it to T2";
     }
     else {
@@ -59,26 +49,17 @@ class ARCCachePolicy : public ICachePolicy<Key> {
       auto l1 = T1.size() + B1.size();
       auto l1_plus_l2 = T1.size() + T2.size() + B1.size() + B2.size();
 
-      if(l1 == capacity){
-        if(T1.size() < capacity){
-          B1.pop_back();
-          Replace(key);
-          DLOG(INFO) << "Make space in B1";
-        }
-        else {
-          T1.pop_back();
-          DLOG(INFO) << "Make space in T1";
-        }
+      if(l1 >= capacity && B1.empty() == false){
+        PopBack(LIST_B1);
+        DLOG(INFO) << "Make space in B1";
       }
-      else if(l1 < capacity && l1_plus_l2 >= capacity) {
-        if(l1_plus_l2 == 2 * capacity){
-          B2.pop_back();
-          DLOG(INFO) << "Make space in B2";
-        }
-        Replace(key);
+      else if(l1_plus_l2 >= 2 * capacity && B2.empty() == false){
+        PopBack(LIST_B2);
+        DLOG(INFO) << "Make space in B2";
       }
 
       T1.push_front(key);
+      key_finder[key] = {T1.begin(), LIST_T1};
       DLOG(INFO) << "Moved it to T1";
 
     }
@@ -91,16 +72,8 @@ class ARCCachePolicy : public ICachePolicy<Key> {
 
     DLOG(INFO) << "ARC TOUCH : " << key << "\n";
 
-    if (Contains(T1, key)) {
-      DLOG(INFO) << "T1 contains key";
-      DequeErase(T1, key);
-      T2.push_front(key);
-      DLOG(INFO) << "Moved it to T2";
-    }
-    else if (Contains(T2, key)){
-      DLOG(INFO) << "T2 contains key";
-      DequeErase(T2, key);
-      T2.push_front(key);
+    if (Contains(LIST_T1, key) || Contains(LIST_T2, key)) {
+      MoveFront(key, LIST_T2);
       DLOG(INFO) << "Moved it to T2";
     }
 
@@ -108,34 +81,18 @@ class ARCCachePolicy : public ICachePolicy<Key> {
 
   }
 
-  void Replace(const Key& key) {
+  // Keep the evicted key in the ghost list of its resident list
+  void Erase(const Key& key) override {
 
-    DLOG(INFO) << "ARC REPLACE : " << key << "\n";
+    DLOG(INFO) << "ARC ERASE : " << key << "\n";
 
-    bool T1_not_empty = (T1.empty() == false);
-    bool in_B2 = Contains(B2, key);
-    bool len_T1_eq_P = (T1.size() == p);
-    bool len_T1_gt_P = (T1.size() > p);
-
-    if(T1_not_empty && ((in_B2 && len_T1_eq_P) || len_T1_gt_P)){
-      DLOG(INFO) << "Evict from T1 to B1";
-      auto victim = T1.back();
-      T1.pop_back();
-      B1.push_front(victim);
+    if(Contains(LIST_T1, key)){
+      MoveFront(key, LIST_B1);
     }
-    else {
-      DLOG(INFO) << "Evict from T2 to B2";
-      auto victim = T2.back();
-      T2.pop_back();
-      B2.push_front(victim);
+    else if(Contains(LIST_T2, key)){
+      MoveFront(key, LIST_B2);
     }
 
-    //Check();
-
-  }
-
-  void Erase(UNUSED_ATTRIBUTE const Key& key) override {
-    // Nothing to do here!
   }
 
   // return a key of a displacement candidate
@@ -143,12 +100,16 @@ class ARCCachePolicy : public ICachePolicy<Key> {
 
     DLOG(INFO) << "ARC VICTIM : " << key << "\n";
 
+    // Decide with the target the insertion of the key will set
+    auto target = GetTarget(key);
+
     bool T1_not_empty = (T1.empty() == false);
-    bool in_B2 = Contains(B2, key);
-    bool len_T1_eq_P = (T1.size() == p);
-    bool len_T1_gt_P = (T1.size() > p);
+    bool in_B2 = Contains(LIST_B2, key);
+    bool len_T1_eq_P = (T1.size() == target);
+    bool len_T1_gt_P = (T1.size() > target);
 
-    if(T1_not_empty && ((in_B2 && len_T1_eq_P) || len_T1_gt_P)){
+    if(T1_not_empty &&
+        ((in_B2 && len_T1_eq_P) || len_T1_gt_P || T2.empty())){
       return T1.back();
     }
     else {
@@ -157,6 +118,36 @@ class ARCCachePolicy : public ICachePolicy<Key> {
 
   }
 
+  void Serialize(std::vector<uint64_t>& buffer) const override {
+
+    buffer.push_back(p);
+    SerializeKeys(buffer, T1);
+    SerializeKeys(buffer, B1);
+    SerializeKeys(buffer, T2);
+    SerializeKeys(buffer, B2);
+
+  }
+
+  void Deserialize(const uint64_t*& cursor,
+                   const uint64_t* end) override {
+
+    CheckSnapshotSize(cursor, end, 1);
+    p = *cursor++;
+    DeserializeKeys(cursor, end, T1);
+    DeserializeKeys(cursor, end, B1);
+    DeserializeKeys(cursor, end, T2);
+    DeserializeKeys(cursor, end, B2);
+
+    key_finder.clear();
+    for(auto list_type : {LIST_T1, LIST_B1, LIST_T2, LIST_B2}){
+      auto& keys = GetList(list_type);
+      for(auto itr = keys.begin(); itr != keys.end(); itr++){
+        key_finder[*itr] = {itr, list_type};
+      }
+    }
+
+  }
+
   void Check(){
 
     // Print
@@ -165,7 +156,7 @@ class ARCCachePolicy : public ICachePolicy<Key> {
     //Print("T2",T2);
     //Print("B2",B2);
 
-    if(p > capacity || p < 0){
+    if(p > capacity){
       LOG(INFO) << "p exceeds capacity \n";
       exit(EXIT_FAILURE);
     }
@@ -182,38 +173,94 @@ class ARCCachePolicy : public ICachePolicy<Key> {
 
   }
 
-  void Print(std::string deque_name, const std::deque<Key>& deque){
+  void Print(std::string list_name, const std::list<Key>& list){
     std::stringstream str;
-    str << deque_name << " :: ";
-    for(auto entry : deque){
+    str << list_name << " :: ";
+    for(auto entry : list){
       str << entry << " ";
     }
     str << "\n";
     DLOG(INFO) << str.str();
   }
 
-  bool Contains(const std::deque<Key>& deque, const Key& key) const {
-    auto location = std::find(deque.begin(), deque.end(), key);
-    if (location != deque.end()) {
-      return true;
+ private:
+
+  enum ListType {
+    LIST_T1 = 0,
+    LIST_B1 = 1,
+    LIST_T2 = 2,
+    LIST_B2 = 3
+  };
+
+  struct Entry {
+    arc_iterator position;
+    ListType list_type;
+  };
+
+  // p after adapting to a hit on the key in a ghost list
+  size_t GetTarget(const Key& key) const {
+
+    if(Contains(LIST_B1, key)){
+      size_t size_ratio = B2.size()/B1.size();
+      size_t b_ratio = MAX(size_ratio, 1);
+      return std::min(capacity, p + b_ratio);
+    }
+
+    if(Contains(LIST_B2, key)){
+      size_t size_ratio = B1.size()/B2.size();
+      size_t b_ratio = MAX(size_ratio, 1);
+      if(p >= b_ratio) {
+        return p - b_ratio;
+      }
+    }
+
+    return p;
+  }
+
+  bool Contains(const ListType& list_type, const Key& key) const {
+    auto location = key_finder.find(key);
+    if (location != key_finder.end()) {
+      return location->second.list_type == list_type;
     }
     return false;
   }
 
-  void DequeErase(std::deque<Key>& deque, const Key& key){
-    auto location = std::find(deque.begin(), deque.end(), key);
-    if (location != deque.end()) {
-      deque.erase(location);
+  std::list<Key>& GetList(const ListType& list_type){
+    switch(list_type){
+      case LIST_T1:
+        return T1;
+      case LIST_B1:
+        return B1;
+      case LIST_T2:
+        return T2;
+      case LIST_B2:
+      default:
+        return B2;
     }
   }
 
- private:
+  // Move a tracked key to the front of a list
+  void MoveFront(const Key& key, const ListType& list_type){
+    auto& entry = key_finder[key];
+    auto& list = GetList(list_type);
+    list.splice(list.begin(), GetList(entry.list_type), entry.position);
+    entry.list_type = list_type;
+  }
+
+  // Forget the oldest key of a ghost list
+  void PopBack(const ListType& list_type){
+    auto& list = GetList(list_type);
+    key_finder.erase(list.back());
+    list.pop_back();
+  }
+
+  std::list<Key> T1;
+  std::list<Key> B1;
 
-  std::deque<Key> T1;
-  std::deque<Key> B1;
+  std::list<Key> T2;
+  std::list<Key> B2;
 
-  std::deque<Key> T2;
-  std::deque<Key> B2;
+  std::unordered_map<Key, Entry> key_finder;
 
   // capacity of cache
   size_t capacity;
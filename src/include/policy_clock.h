@@ -0,0 +1,145 @@
+// CLOCK HEADER
+
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "macros.h"
+#include "policy.h"
+
+namespace machine {
+
+// Second-chance replacement on flat arrays. Each resident key owns a slot
+// with a reference bit; a hit only sets the bit. The hand sweeps the
+// slots, clearing set bits, and evicts the first key whose bit is clear.
+template <typename Key>
+class CLOCKCachePolicy : public ICachePolicy<Key> {
+ public:
+
+  CLOCKCachePolicy(UNUSED_ATTRIBUTE const size_t& capacity)
+  : hand_(0) {
+    // Nothing to do here!
+  }
+
+  ~CLOCKCachePolicy() = default;
+
+  void Insert(const Key& key) override {
+
+    DLOG(INFO) << "CLOCK INSERT: " << key << "\n";
+
+    // reuse a freed slot before growing the clock
+    size_t slot = slot_keys_.size();
+    if(free_slots_.empty() == false){
+      slot = free_slots_.back();
+      free_slots_.pop_back();
+    }
+    else {
+      slot_keys_.resize(slot + 1);
+      slot_states_.resize(slot + 1);
+    }
+
+    slot_keys_[slot] = key;
+    slot_states_[slot] = SLOT_RESIDENT;
+    slot_finder_[key] = slot;
+
+  }
+
+  void Touch(const Key& key) override {
+
+    auto slot_itr = slot_finder_.find(key);
+    if(slot_itr == slot_finder_.end()){
+      return;
+    }
+
+    slot_states_[slot_itr->second] = SLOT_REFERENCED;
+
+  }
+
+  void Erase(const Key& key) override {
+
+    DLOG(INFO) << "CLOCK ERASE: " << key << "\n";
+
+    auto slot_itr = slot_finder_.find(key);
+    if(slot_itr == slot_finder_.end()){
+      return;
+    }
+
+    slot_states_[slot_itr->second] = SLOT_EMPTY;
+    free_slots_.push_back(slot_itr->second);
+    slot_finder_.erase(slot_itr);
+
+  }
+
+  // return a key of a displacement candidate
+  const Key& Victim(UNUSED_ATTRIBUTE const Key& key) const override {
+
+    // every referenced key is cleared within one sweep
+    while(true){
+      auto slot = hand_;
+      hand_ = (hand_ + 1) % slot_keys_.size();
+
+      if(slot_states_[slot] == SLOT_REFERENCED){
+        slot_states_[slot] = SLOT_RESIDENT;
+      }
+      else if(slot_states_[slot] == SLOT_RESIDENT){
+        DLOG(INFO) << "CLOCK VICTIM: " << slot_keys_[slot] << "\n";
+        return slot_keys_[slot];
+      }
+    }
+
+  }
+
+  void Serialize(std::vector<uint64_t>& buffer) const override {
+
+    buffer.push_back(hand_);
+    SerializeKeys(buffer, slot_keys_);
+    SerializeKeys(buffer, slot_states_);
+
+  }
+
+  void Deserialize(const uint64_t*& cursor,
+                   const uint64_t* end) override {
+
+    CheckSnapshotSize(cursor, end, 1);
+    hand_ = *cursor++;
+    DeserializeKeys(cursor, end, slot_keys_);
+    DeserializeKeys(cursor, end, slot_states_);
+    CheckSnapshotField("clock_slots", slot_states_.size(), slot_keys_.size());
+
+    slot_finder_.clear();
+    free_slots_.clear();
+    for(size_t slot = 0; slot < slot_keys_.size(); slot++){
+      if(slot_states_[slot] == SLOT_EMPTY){
+        free_slots_.push_back(slot);
+      }
+      else {
+        slot_finder_[slot_keys_[slot]] = slot;
+      }
+    }
+
+  }
+
+ private:
+
+  enum SlotState : uint8_t {
+    SLOT_EMPTY = 0,
+    SLOT_RESIDENT = 1,
+    SLOT_REFERENCED = 2
+  };
+
+  // key and reference bit of each slot
+  std::vector<Key> slot_keys_;
+  mutable std::vector<uint8_t> slot_states_;
+
+  std::unordered_map<Key, size_t> slot_finder_;
+
+  std::vector<size_t> free_slots_;
+
+  // next slot to look at for a victim
+  mutable size_t hand_;
+
+};
+
+}  // End machine namespace
@@ -0,0 +1,309 @@
+// CLOCK-PRO HEADER
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "macros.h"
+#include "policy.h"
+
+namespace machine {
+
+// CLOCK-Pro (Jiang et al., USENIX ATC 2005) on flat arrays. Resident keys
+// are hot or cold and own a slot with a reference bit, so a hit only sets
+// the bit. A new key starts cold in its test period; a cold key that is
+// referenced again during the test period becomes hot. The cold hand
+// evicts unreferenced cold keys, and the hot hand demotes unreferenced
+// hot keys and ends the test periods it passes. Evicted keys still in
+// their test period are kept in a ring of non-resident keys as large as
+// the cache; a miss on one of them grows the cold target and brings the
+// key back hot, while a test period that ends unused shrinks it.
+template <typename Key>
+class CLOCKProCachePolicy : public ICachePolicy<Key> {
+ public:
+
+  CLOCKProCachePolicy(const size_t& capacity)
+  : capacity_(capacity),
+    cold_target_(std::max<size_t>(1, capacity/10)),
+    hot_count_(0),
+    cold_count_(0),
+    cold_hand_(0),
+    hot_hand_(0),
+    test_head_(0) {
+    // Nothing to do here!
+  }
+
+  ~CLOCKProCachePolicy() = default;
+
+  void Insert(const Key& key) override {
+
+    DLOG(INFO) << "CLOCK-PRO INSERT: " << key << "\n";
+
+    // reuse a freed slot before growing the clock
+    size_t slot = slot_keys_.size();
+    if(free_slots_.empty() == false){
+      slot = free_slots_.back();
+      free_slots_.pop_back();
+    }
+    else {
+      slot_keys_.resize(slot + 1);
+      slot_states_.resize(slot + 1);
+    }
+    slot_keys_[slot] = key;
+    slot_finder_[key] = slot;
+
+    // Reused during its non-resident test period: the cold space is too
+    // small, and the key comes back hot
+    auto test_itr = test_finder_.find(key);
+    if(test_itr != test_finder_.end()){
+      test_keys_[test_itr->second] = static_cast<Key>(INVALID_KEY);
+      test_finder_.erase(test_itr);
+      cold_target_ = std::min(cold_target_ + 1, GetMaxColdTarget());
+
+      slot_states_[slot] = SLOT_RESIDENT | SLOT_HOT | SLOT_REFERENCED;
+      hot_count_++;
+      BalanceHotKeys();
+      return;
+    }
+
+    slot_states_[slot] = SLOT_RESIDENT | SLOT_TEST;
+    cold_count_++;
+
+  }
+
+  void Touch(const Key& key) override {
+
+    auto slot_itr = slot_finder_.find(key);
+    if(slot_itr == slot_finder_.end()){
+      return;
+    }
+
+    slot_states_[slot_itr->second] |= SLOT_REFERENCED;
+
+  }
+
+  void Erase(const Key& key) override {
+
+    DLOG(INFO) << "CLOCK-PRO ERASE: " << key << "\n";
+
+    auto slot_itr = slot_finder_.find(key);
+    if(slot_itr == slot_finder_.end()){
+      return;
+    }
+
+    auto slot = slot_itr->second;
+    if((slot_states_[slot] & SLOT_HOT) != 0){
+      hot_count_--;
+    }
+    else {
+      cold_count_--;
+    }
+
+    slot_states_[slot] = SLOT_EMPTY;
+    free_slots_.push_back(slot);
+    slot_finder_.erase(slot_itr);
+
+  }
+
+  // return a key of a displacement candidate
+  const Key& Victim(UNUSED_ATTRIBUTE const Key& key) const override {
+
+    while(true){
+      // every key is hot: demote one
+      if(cold_count_ == 0){
+        RunHotHand();
+      }
+
+      auto slot = cold_hand_;
+      cold_hand_ = (cold_hand_ + 1) % slot_keys_.size();
+
+      auto& slot_state = slot_states_[slot];
+      if((slot_state & SLOT_RESIDENT) == 0 || (slot_state & SLOT_HOT) != 0){
+        continue;
+      }
+
+      // Unreferenced cold key: evict it, and keep it in its test period
+      if((slot_state & SLOT_REFERENCED) == 0){
+        if((slot_state & SLOT_TEST) != 0){
+          AddTestKey(slot_keys_[slot]);
+        }
+        DLOG(INFO) << "CLOCK-PRO VICTIM: " << slot_keys_[slot] << "\n";
+        return slot_keys_[slot];
+      }
+
+      // Referenced in its test period: promote to hot
+      if((slot_state & SLOT_TEST) != 0){
+        slot_state = SLOT_RESIDENT | SLOT_HOT;
+        cold_count_--;
+        hot_count_++;
+        BalanceHotKeys();
+      }
+      // Referenced outside of it: start a new test period
+      else {
+        slot_state = SLOT_RESIDENT | SLOT_TEST;
+      }
+    }
+
+  }
+
+  void Serialize(std::vector<uint64_t>& buffer) const override {
+
+    buffer.push_back(cold_target_);
+    buffer.push_back(cold_hand_);
+    buffer.push_back(hot_hand_);
+    buffer.push_back(test_head_);
+    SerializeKeys(buffer, slot_keys_);
+    SerializeKeys(buffer, slot_states_);
+    SerializeKeys(buffer, test_keys_);
+
+  }
+
+  void Deserialize(const uint64_t*& cursor,
+                   const uint64_t* end) override {
+
+    CheckSnapshotSize(cursor, end, 4);
+    cold_target_ = *cursor++;
+    cold_hand_ = *cursor++;
+    hot_hand_ = *cursor++;
+    test_head_ = *cursor++;
+    DeserializeKeys(cursor, end, slot_keys_);
+    DeserializeKeys(cursor, end, slot_states_);
+    CheckSnapshotField("clock_pro_slots", slot_states_.size(),
+                       slot_keys_.size());
+    DeserializeKeys(cursor, end, test_keys_);
+
+    slot_finder_.clear();
+    free_slots_.clear();
+    hot_count_ = 0;
+    cold_count_ = 0;
+    for(size_t slot = 0; slot < slot_keys_.size(); slot++){
+      auto slot_state = slot_states_[slot];
+      if((slot_state & SLOT_RESIDENT) == 0){
+        free_slots_.push_back(slot);
+        continue;
+      }
+      slot_finder_[slot_keys_[slot]] = slot;
+      if((slot_state & SLOT_HOT) != 0){
+        hot_count_++;
+      }
+      else {
+        cold_count_++;
+      }
+    }
+
+    test_finder_.clear();
+    for(size_t test_itr = 0; test_itr < test_keys_.size(); test_itr++){
+      if(test_keys_[test_itr] != static_cast<Key>(INVALID_KEY)){
+        test_finder_[test_keys_[test_itr]] = test_itr;
+      }
+    }
+
+  }
+
+ private:
+
+  enum SlotState : uint8_t {
+    SLOT_EMPTY = 0,
+    SLOT_RESIDENT = 1,
+    SLOT_HOT = 2,
+    SLOT_TEST = 4,
+    SLOT_REFERENCED = 8
+  };
+
+  size_t GetMaxColdTarget() const {
+    return std::max<size_t>(1, capacity_ - 1);
+  }
+
+  // Demote hot keys past the hot target (the capacity left to cold keys)
+  void BalanceHotKeys() const {
+    while(hot_count_ > 0 && hot_count_ + cold_target_ > capacity_){
+      RunHotHand();
+    }
+  }
+
+  // Move the hot hand until it demotes an unreferenced hot key. Cold keys
+  // it passes end their test period.
+  void RunHotHand() const {
+
+    while(true){
+      auto slot = hot_hand_;
+      hot_hand_ = (hot_hand_ + 1) % slot_keys_.size();
+
+      auto& slot_state = slot_states_[slot];
+      if((slot_state & SLOT_RESIDENT) == 0){
+        continue;
+      }
+
+      if((slot_state & SLOT_HOT) == 0){
+        if((slot_state & SLOT_TEST) != 0){
+          slot_state &= ~SLOT_TEST;
+          cold_target_ = std::max<size_t>(cold_target_ - 1, 1);
+        }
+        continue;
+      }
+
+      if((slot_state & SLOT_REFERENCED) != 0){
+        slot_state &= ~SLOT_REFERENCED;
+        continue;
+      }
+
+      slot_state = SLOT_RESIDENT;
+      hot_count_--;
+      cold_count_++;
+      return;
+    }
+
+  }
+
+  // Keep an evicted key in its test period, dropping the oldest one
+  void AddTestKey(const Key& key) const {
+
+    if(test_keys_.size() < capacity_){
+      test_finder_[key] = test_keys_.size();
+      test_keys_.push_back(key);
+      return;
+    }
+
+    auto& test_key = test_keys_[test_head_];
+    if(test_key != static_cast<Key>(INVALID_KEY)){
+      test_finder_.erase(test_key);
+      cold_target_ = std::max<size_t>(cold_target_ - 1, 1);
+    }
+    test_key = key;
+    test_finder_[key] = test_head_;
+    test_head_ = (test_head_ + 1) % capacity_;
+
+  }
+
+  size_t capacity_;
+
+  // The hands move while looking for a victim
+
+  // resident keys the cold space should hold
+  mutable size_t cold_target_;
+
+  mutable size_t hot_count_;
+  mutable size_t cold_count_;
+
+  // key and state of each slot
+  std::vector<Key> slot_keys_;
+  mutable std::vector<uint8_t> slot_states_;
+
+  std::unordered_map<Key, size_t> slot_finder_;
+
+  std::vector<size_t> free_slots_;
+
+  mutable size_t cold_hand_;
+  mutable size_t hot_hand_;
+
+  // ring of evicted keys in their test period
+  mutable std::vector<Key> test_keys_;
+  mutable std::unordered_map<Key, size_t> test_finder_;
+  mutable size_t test_head_;
+
+};
+
+}  // End machine namespace
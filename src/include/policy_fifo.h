@@ -3,6 +3,7 @@
 #pragma once
 
 #include <list>
+#include <unordered_map>
 
 #include "macros.h"
 #include "policy.h"
@@ -12,6 +13,7 @@ namespace machine {
 template <typename Key>
 class FIFOCachePolicy : public ICachePolicy<Key> {
  public:
+  using fifo_iterator = typename std::list<Key>::const_iterator;
 
   FIFOCachePolicy(UNUSED_ATTRIBUTE const size_t& capacity){
     // Nothing to do here!
@@ -22,6 +24,7 @@ class FIFOCachePolicy : public ICachePolicy<Key> {
   void Insert(const Key& key) override {
 
     fifo_queue.emplace_front(key);
+    key_finder[key] = fifo_queue.cbegin();
 
   }
 
@@ -33,9 +36,16 @@ class FIFOCachePolicy : public ICachePolicy<Key> {
   }
 
   // handle element deletion from a cache
-  void Erase(UNUSED_ATTRIBUTE const Key& key) override {
+  void Erase(const Key& key) override {
 
-    fifo_queue.pop_back();
+    // the victim or any other resident element
+    auto key_itr = key_finder.find(key);
+    if(key_itr == key_finder.end()){
+      return;
+    }
+
+    fifo_queue.erase(key_itr->second);
+    key_finder.erase(key_itr);
 
   }
 
@@ -46,10 +56,30 @@ class FIFOCachePolicy : public ICachePolicy<Key> {
 
   }
 
+  void Serialize(std::vector<uint64_t>& buffer) const override {
+
+    SerializeKeys(buffer, fifo_queue);
+
+  }
+
+  void Deserialize(const uint64_t*& cursor,
+                   const uint64_t* end) override {
+
+    DeserializeKeys(cursor, end, fifo_queue);
+
+    key_finder.clear();
+    for(auto itr = fifo_queue.cbegin(); itr != fifo_queue.cend(); itr++){
+      key_finder[*itr] = itr;
+    }
+
+  }
+
  private:
 
   std::list<Key> fifo_queue;
 
+  std::unordered_map<Key, fifo_iterator> key_finder;
+
 };
 
 }  // End machine namespace
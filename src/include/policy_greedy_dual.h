@@ -0,0 +1,207 @@
+// GREEDY-DUAL HEADER
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+#include "macros.h"
+#include "policy.h"
+
+namespace machine {
+
+// GreedyDual (Young, Algorithmica 1994) with the eviction cost of a key
+// set by its dirty status. Each key gets a priority H = L + cost when it
+// is inserted or touched, and the key with the lowest H is evicted,
+// raising the inflation L to its H. A dirty key costs a write-back to the
+// tier below on top of the refetch, so it survives that many more
+// evictions than a clean key accessed at the same time. With only two
+// costs, the keys of each status are ordered by H already, so each status
+// is a queue and the victim is the lower of the two queue tails.
+template <typename Key>
+class GreedyDualCachePolicy : public ICachePolicy<Key> {
+ public:
+  using queue_iterator = typename std::list<Key>::iterator;
+
+  // Equal costs make it LRU until the tier sets its costs
+  GreedyDualCachePolicy(UNUSED_ATTRIBUTE const size_t& capacity)
+  : clean_cost_(1),
+    dirty_cost_(1),
+    inflation_(0) {
+    // Nothing to do here!
+  }
+
+  ~GreedyDualCachePolicy() = default;
+
+  void Insert(const Key& key) override {
+
+    DLOG(INFO) << "GREEDY-DUAL INSERT: " << key << "\n";
+
+    clean_keys_.emplace_front(key);
+    key_finder_[key] = {clean_keys_.begin(), inflation_ + clean_cost_, false};
+
+  }
+
+  void Touch(const Key& key) override {
+
+    auto key_itr = key_finder_.find(key);
+    if(key_itr == key_finder_.end()){
+      return;
+    }
+
+    auto& entry = key_itr->second;
+    MoveFront(entry, entry.dirty);
+
+  }
+
+  void Erase(const Key& key) override {
+
+    DLOG(INFO) << "GREEDY-DUAL ERASE: " << key << "\n";
+
+    auto key_itr = key_finder_.find(key);
+    if(key_itr == key_finder_.end()){
+      return;
+    }
+
+    auto& entry = key_itr->second;
+    GetQueue(entry.dirty).erase(entry.position);
+    key_finder_.erase(key_itr);
+
+  }
+
+  // Evicting the lowest priority inflates the others; dropping a key
+  // for any other reason leaves the inflation alone
+  void Evict(const Key& key) override {
+
+    auto key_itr = key_finder_.find(key);
+    if(key_itr == key_finder_.end()){
+      return;
+    }
+
+    inflation_ = std::max(inflation_, key_itr->second.priority);
+
+  }
+
+  // A change of status re-prices the key with the cost of the new status
+  void SetStatus(const Key& key, const size_t& block_status) override {
+
+    auto key_itr = key_finder_.find(key);
+    if(key_itr == key_finder_.end()){
+      return;
+    }
+
+    auto& entry = key_itr->second;
+    auto dirty = (block_status == DIRTY_BLOCK);
+    if(entry.dirty != dirty){
+      MoveFront(entry, dirty);
+    }
+
+  }
+
+  // Costs are set once, before any key is inserted
+  void SetEvictionCost(const uint64_t& clean_cost,
+                       const uint64_t& dirty_cost) override {
+    clean_cost_ = clean_cost;
+    dirty_cost_ = dirty_cost;
+  }
+
+  // return a key of a displacement candidate
+  const Key& Victim(UNUSED_ATTRIBUTE const Key& key) const override {
+
+    if(dirty_keys_.empty() ||
+        (clean_keys_.empty() == false &&
+            GetPriority(clean_keys_.back()) <=
+            GetPriority(dirty_keys_.back()))){
+      DLOG(INFO) << "GREEDY-DUAL VICTIM: " << clean_keys_.back() << "\n";
+      return clean_keys_.back();
+    }
+
+    DLOG(INFO) << "GREEDY-DUAL VICTIM: " << dirty_keys_.back() << "\n";
+    return dirty_keys_.back();
+
+  }
+
+  void Serialize(std::vector<uint64_t>& buffer) const override {
+
+    buffer.push_back(inflation_);
+    for(auto dirty : {false, true}){
+      auto& keys = GetQueue(dirty);
+      std::vector<uint64_t> priorities;
+      priorities.reserve(keys.size());
+      for(auto& key : keys){
+        priorities.push_back(GetPriority(key));
+      }
+      SerializeKeys(buffer, keys);
+      SerializeKeys(buffer, priorities);
+    }
+
+  }
+
+  void Deserialize(const uint64_t*& cursor,
+                   const uint64_t* end) override {
+
+    CheckSnapshotSize(cursor, end, 1);
+    inflation_ = *cursor++;
+    key_finder_.clear();
+    for(auto dirty : {false, true}){
+      auto& keys = GetQueue(dirty);
+      std::vector<uint64_t> priorities;
+      DeserializeKeys(cursor, end, keys);
+      DeserializeKeys(cursor, end, priorities);
+      CheckSnapshotField("greedy_dual_priorities", priorities.size(),
+                         keys.size());
+      size_t key_itr = 0;
+      for(auto itr = keys.begin(); itr != keys.end(); itr++, key_itr++){
+        key_finder_[*itr] = {itr, priorities[key_itr], dirty};
+      }
+    }
+
+  }
+
+ private:
+
+  struct Entry {
+    queue_iterator position;
+    uint64_t priority;
+    bool dirty;
+  };
+
+  std::list<Key>& GetQueue(const bool& dirty){
+    return dirty ? dirty_keys_ : clean_keys_;
+  }
+
+  const std::list<Key>& GetQueue(const bool& dirty) const {
+    return dirty ? dirty_keys_ : clean_keys_;
+  }
+
+  uint64_t GetPriority(const Key& key) const {
+    return key_finder_.at(key).priority;
+  }
+
+  // Re-price a key and move it to the front of the queue of its status
+  void MoveFront(Entry& entry, const bool& dirty){
+    auto& keys = GetQueue(dirty);
+    keys.splice(keys.begin(), GetQueue(entry.dirty), entry.position);
+    entry.dirty = dirty;
+    entry.priority = inflation_ + (dirty ? dirty_cost_ : clean_cost_);
+  }
+
+  // cost of evicting a clean and a dirty key
+  uint64_t clean_cost_;
+  uint64_t dirty_cost_;
+
+  // priority of the last evicted key
+  uint64_t inflation_;
+
+  // keys of each status (lowest priority at the back)
+  std::list<Key> clean_keys_;
+  std::list<Key> dirty_keys_;
+
+  std::unordered_map<Key, Entry> key_finder_;
+
+};
+
+}  // End machine namespace
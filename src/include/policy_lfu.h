@@ -81,6 +81,36 @@ class LFUCachePolicy : public ICachePolicy<Key> {
     return victim;
   }
 
+  void Serialize(std::vector<uint64_t>& buffer) const override {
+
+    // (frequency, key) pairs in victim order
+    buffer.push_back(frequency_storage.size());
+    for(auto& entry : frequency_storage){
+      buffer.push_back(entry.first);
+      buffer.push_back(static_cast<uint64_t>(entry.second));
+    }
+
+  }
+
+  void Deserialize(const uint64_t*& cursor,
+                   const uint64_t* end) override {
+
+    frequency_storage.clear();
+    lfu_storage.clear();
+
+    CheckSnapshotSize(cursor, end, 1);
+    auto entry_count = *cursor++;
+    CheckSnapshotSize(cursor, end, entry_count, 2);
+    for(uint64_t entry_itr = 0; entry_itr < entry_count; entry_itr++){
+      auto frequency = *cursor++;
+      auto key = static_cast<Key>(*cursor++);
+      lfu_storage[key] = frequency_storage.emplace_hint(frequency_storage.cend(),
+                                                        frequency,
+                                                        key);
+    }
+
+  }
+
  private:
 
   std::multimap<std::size_t, Key> frequency_storage;
@@ -0,0 +1,278 @@
+// LIRS HEADER
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+#include "macros.h"
+#include "policy.h"
+
+namespace machine {
+
+// LIRS (Jiang and Zhang, SIGMETRICS 2002). Keys with a short reuse
+// distance are LIR and stay resident; the other resident keys are HIR and
+// wait in a small queue (1% of the capacity), whose oldest key is the
+// victim. The recency stack holds the LIR keys and the HIR keys seen since
+// the oldest LIR key, so a HIR key hit while still in the stack becomes
+// LIR and demotes the oldest LIR key. Evicted keys left in the stack are
+// ghosts, and at most as many ghosts as the capacity are kept.
+template <typename Key>
+class LIRSCachePolicy : public ICachePolicy<Key> {
+ public:
+  using lirs_iterator = typename std::list<Key>::iterator;
+
+  LIRSCachePolicy(const size_t& capacity)
+  : lir_capacity_(capacity - std::min(capacity,
+                                      std::max<size_t>(1, capacity/100))),
+    ghost_capacity_(capacity),
+    lir_count_(0) {
+    // Nothing to do here!
+  }
+
+  ~LIRSCachePolicy() = default;
+
+  void Insert(const Key& key) override {
+
+    DLOG(INFO) << "LIRS INSERT: " << key << "\n";
+
+    auto key_itr = key_finder_.find(key);
+
+    // Reused within the stack: the reuse distance is short
+    if(key_itr != key_finder_.end()){
+      auto& entry = key_itr->second;
+      ghost_keys_.erase(entry.queue_position);
+      stack_.splice(stack_.begin(), stack_, entry.stack_position);
+      entry.status = STATUS_LIR;
+      lir_count_++;
+      BalanceLIRKeys();
+      return;
+    }
+
+    stack_.push_front(key);
+    auto& entry = key_finder_[key];
+    entry.stack_position = stack_.begin();
+    entry.in_stack = true;
+
+    // The LIR set fills up first
+    if(lir_count_ < lir_capacity_){
+      entry.status = STATUS_LIR;
+      lir_count_++;
+      return;
+    }
+
+    hir_keys_.push_front(key);
+    entry.queue_position = hir_keys_.begin();
+    entry.status = STATUS_HIR;
+
+  }
+
+  void Touch(const Key& key) override {
+
+    auto key_itr = key_finder_.find(key);
+    if(key_itr == key_finder_.end() ||
+        key_itr->second.status == STATUS_GHOST){
+      return;
+    }
+
+    auto& entry = key_itr->second;
+    if(entry.status == STATUS_LIR){
+      stack_.splice(stack_.begin(), stack_, entry.stack_position);
+      PruneStack();
+      return;
+    }
+
+    // HIR key still in the stack: promote it
+    if(entry.in_stack){
+      stack_.splice(stack_.begin(), stack_, entry.stack_position);
+      hir_keys_.erase(entry.queue_position);
+      entry.status = STATUS_LIR;
+      lir_count_++;
+      BalanceLIRKeys();
+      return;
+    }
+
+    stack_.push_front(key);
+    entry.stack_position = stack_.begin();
+    entry.in_stack = true;
+    hir_keys_.splice(hir_keys_.begin(), hir_keys_, entry.queue_position);
+
+  }
+
+  // An erased HIR key stays in the stack as a ghost
+  void Erase(const Key& key) override {
+
+    DLOG(INFO) << "LIRS ERASE: " << key << "\n";
+
+    auto key_itr = key_finder_.find(key);
+    if(key_itr == key_finder_.end() ||
+        key_itr->second.status == STATUS_GHOST){
+      return;
+    }
+
+    auto& entry = key_itr->second;
+    if(entry.status == STATUS_LIR){
+      stack_.erase(entry.stack_position);
+      key_finder_.erase(key_itr);
+      lir_count_--;
+      PruneStack();
+      return;
+    }
+
+    hir_keys_.erase(entry.queue_position);
+    if(entry.in_stack == false){
+      key_finder_.erase(key_itr);
+      return;
+    }
+
+    ghost_keys_.push_front(key);
+    entry.queue_position = ghost_keys_.begin();
+    entry.status = STATUS_GHOST;
+
+    // Forget the oldest ghost
+    if(ghost_keys_.size() > ghost_capacity_){
+      auto& ghost_entry = key_finder_[ghost_keys_.back()];
+      stack_.erase(ghost_entry.stack_position);
+      key_finder_.erase(ghost_keys_.back());
+      ghost_keys_.pop_back();
+    }
+
+  }
+
+  // return a key of a displacement candidate
+  const Key& Victim(UNUSED_ATTRIBUTE const Key& key) const override {
+
+    if(hir_keys_.empty() == false){
+      DLOG(INFO) << "LIRS VICTIM: " << hir_keys_.back() << "\n";
+      return hir_keys_.back();
+    }
+
+    DLOG(INFO) << "LIRS VICTIM: " << stack_.back() << "\n";
+    return stack_.back();
+
+  }
+
+  void Serialize(std::vector<uint64_t>& buffer) const override {
+
+    std::vector<uint8_t> stack_states;
+    stack_states.reserve(stack_.size());
+    for(auto& key : stack_){
+      stack_states.push_back(key_finder_.at(key).status);
+    }
+
+    SerializeKeys(buffer, stack_);
+    SerializeKeys(buffer, stack_states);
+    SerializeKeys(buffer, hir_keys_);
+    SerializeKeys(buffer, ghost_keys_);
+
+  }
+
+  void Deserialize(const uint64_t*& cursor,
+                   const uint64_t* end) override {
+
+    std::vector<uint8_t> stack_states;
+    DeserializeKeys(cursor, end, stack_);
+    DeserializeKeys(cursor, end, stack_states);
+    CheckSnapshotField("lirs_stack", stack_states.size(), stack_.size());
+    DeserializeKeys(cursor, end, hir_keys_);
+    DeserializeKeys(cursor, end, ghost_keys_);
+
+    key_finder_.clear();
+    lir_count_ = 0;
+    size_t stack_itr = 0;
+    for(auto itr = stack_.begin(); itr != stack_.end(); itr++, stack_itr++){
+      auto& entry = key_finder_[*itr];
+      entry.stack_position = itr;
+      entry.in_stack = true;
+      entry.status = static_cast<Status>(stack_states[stack_itr]);
+      if(entry.status == STATUS_LIR){
+        lir_count_++;
+      }
+    }
+    for(auto itr = hir_keys_.begin(); itr != hir_keys_.end(); itr++){
+      auto& entry = key_finder_[*itr];
+      entry.queue_position = itr;
+      entry.status = STATUS_HIR;
+    }
+    for(auto itr = ghost_keys_.begin(); itr != ghost_keys_.end(); itr++){
+      key_finder_[*itr].queue_position = itr;
+    }
+
+  }
+
+ private:
+
+  enum Status : uint8_t {
+    STATUS_LIR = 1,
+    STATUS_HIR = 2,
+    STATUS_GHOST = 3
+  };
+
+  // The queue position is in the HIR queue for resident HIR keys and in
+  // the ghost list for ghosts
+  struct Entry {
+    lirs_iterator stack_position;
+    lirs_iterator queue_position;
+    Status status = STATUS_HIR;
+    bool in_stack = false;
+  };
+
+  // Demote the oldest LIR keys past the LIR capacity
+  void BalanceLIRKeys(){
+    while(lir_count_ > lir_capacity_){
+      PruneStack();
+      auto& key = stack_.back();
+      auto& entry = key_finder_[key];
+      hir_keys_.push_front(key);
+      entry.queue_position = hir_keys_.begin();
+      entry.status = STATUS_HIR;
+      entry.in_stack = false;
+      stack_.pop_back();
+      lir_count_--;
+    }
+    PruneStack();
+  }
+
+  // Drop HIR keys and ghosts from the stack bottom, so that its oldest key
+  // is a LIR key
+  void PruneStack(){
+    while(stack_.empty() == false){
+      auto key_itr = key_finder_.find(stack_.back());
+      auto& entry = key_itr->second;
+      if(entry.status == STATUS_LIR){
+        break;
+      }
+      stack_.pop_back();
+      if(entry.status == STATUS_GHOST){
+        ghost_keys_.erase(entry.queue_position);
+        key_finder_.erase(key_itr);
+      }
+      else {
+        entry.in_stack = false;
+      }
+    }
+  }
+
+  size_t lir_capacity_;
+
+  size_t ghost_capacity_;
+
+  size_t lir_count_;
+
+  // recency stack (most recent first)
+  std::list<Key> stack_;
+
+  // resident HIR keys (victim at the back)
+  std::list<Key> hir_keys_;
+
+  // ghosts in the stack (oldest at the back)
+  std::list<Key> ghost_keys_;
+
+  std::unordered_map<Key, Entry> key_finder_;
+
+};
+
+}  // End machine namespace
@@ -39,13 +39,18 @@ class LRUCachePolicy : public ICachePolicy<Key> {
 
   }
 
-  void Erase(UNUSED_ATTRIBUTE const Key& key) override {
+  void Erase(const Key& key) override {
 
-    DLOG(INFO) << "LRU ERASE: " << lru_queue.back() << "\n";
+    DLOG(INFO) << "LRU ERASE: " << key << "\n";
 
-    // remove the least recently used element
-    key_finder.erase(lru_queue.back());
-    lru_queue.pop_back();
+    // remove the element, usually the least recently used one
+    auto key_itr = key_finder.find(key);
+    if(key_itr == key_finder.end()){
+      return;
+    }
+
+    lru_queue.erase(key_itr->second);
+    key_finder.erase(key_itr);
 
   }
 
@@ -58,6 +63,24 @@ class LRUCachePolicy : public ICachePolicy<Key> {
 
   }
 
+  void Serialize(std::vector<uint64_t>& buffer) const override {
+
+    SerializeKeys(buffer, lru_queue);
+
+  }
+
+  void Deserialize(const uint64_t*& cursor,
+                   const uint64_t* end) override {
+
+    DeserializeKeys(cursor, end, lru_queue);
+
+    key_finder.clear();
+    for(auto itr = lru_queue.cbegin(); itr != lru_queue.cend(); itr++){
+      key_finder[*itr] = itr;
+    }
+
+  }
+
  private:
 
   std::list<Key> lru_queue;
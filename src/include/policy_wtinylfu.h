@@ -0,0 +1,203 @@
+// W-TINYLFU HEADER
+
+#pragma once
+
+#include <algorithm>
+#include <list>
+#include <unordered_map>
+
+#include "macros.h"
+#include "policy.h"
+#include "sketch.h"
+
+namespace machine {
+
+// Fixed seed keeps the admission decisions deterministic
+const uint64_t wtinylfu_sketch_seed = 50;
+
+// W-TinyLFU (Einziger et al., ACM ToS 2017). New keys enter a small LRU
+// window (1% of the capacity). Keys leaving the window compete with the
+// probation victim of a segmented LRU main area, and the one with the
+// higher sketch frequency stays, so one-time keys rarely displace the
+// hot ones. A hit in probation moves the key to the protected segment
+// (80% of the main area), whose overflow returns to probation.
+template <typename Key>
+class WTinyLFUCachePolicy : public ICachePolicy<Key> {
+ public:
+  using lru_iterator = typename std::list<Key>::iterator;
+
+  WTinyLFUCachePolicy(const size_t& capacity)
+  : window_capacity_(std::max<size_t>(1, capacity/100)),
+    protected_capacity_((capacity - std::min(capacity, window_capacity_)) *
+                        8 / 10),
+    sketch_(wtinylfu_sketch_seed) {
+    // Nothing to do here!
+  }
+
+  ~WTinyLFUCachePolicy() = default;
+
+  void Insert(const Key& key) override {
+
+    DLOG(INFO) << "W-TINYLFU INSERT: " << key << "\n";
+
+    sketch_.Increment(key);
+
+    window_.emplace_front(key);
+    key_finder_[key] = {window_.begin(), SEGMENT_WINDOW};
+    sketch_.EnsureCapacity(key_finder_.size());
+
+    // The window overflow moves to probation (it won the admission
+    // check when the cache is full)
+    if(window_.size() > window_capacity_){
+      MoveFront(window_.back(), probation_, SEGMENT_PROBATION);
+    }
+
+  }
+
+  void Touch(const Key& key) override {
+
+    auto key_itr = key_finder_.find(key);
+    if(key_itr == key_finder_.end()){
+      return;
+    }
+
+    sketch_.Increment(key);
+
+    switch(key_itr->second.segment){
+      case SEGMENT_WINDOW:
+        MoveFront(key, window_, SEGMENT_WINDOW);
+        break;
+
+      case SEGMENT_PROBATION:
+        MoveFront(key, protected_, SEGMENT_PROTECTED);
+        if(protected_.size() > protected_capacity_){
+          MoveFront(protected_.back(), probation_, SEGMENT_PROBATION);
+        }
+        break;
+
+      case SEGMENT_PROTECTED:
+        MoveFront(key, protected_, SEGMENT_PROTECTED);
+        break;
+    }
+
+  }
+
+  void Erase(const Key& key) override {
+
+    DLOG(INFO) << "W-TINYLFU ERASE: " << key << "\n";
+
+    auto key_itr = key_finder_.find(key);
+    if(key_itr == key_finder_.end()){
+      return;
+    }
+
+    GetSegment(key_itr->second.segment).erase(key_itr->second.position);
+    key_finder_.erase(key_itr);
+
+  }
+
+  // return a key of a displacement candidate
+  const Key& Victim(UNUSED_ATTRIBUTE const Key& key) const override {
+
+    const Key* main_victim = nullptr;
+    if(probation_.empty() == false){
+      main_victim = &probation_.back();
+    }
+    else if(protected_.empty() == false){
+      main_victim = &protected_.back();
+    }
+
+    if(main_victim == nullptr){
+      return window_.back();
+    }
+
+    // The window candidate is admitted if it is more frequent
+    if(window_.size() >= window_capacity_){
+      auto& candidate = window_.back();
+      if(sketch_.Estimate(candidate) <= sketch_.Estimate(*main_victim)){
+        DLOG(INFO) << "W-TINYLFU VICTIM: " << candidate << "\n";
+        return candidate;
+      }
+    }
+
+    DLOG(INFO) << "W-TINYLFU VICTIM: " << *main_victim << "\n";
+    return *main_victim;
+
+  }
+
+  void Serialize(std::vector<uint64_t>& buffer) const override {
+
+    SerializeKeys(buffer, window_);
+    SerializeKeys(buffer, probation_);
+    SerializeKeys(buffer, protected_);
+    sketch_.Serialize(buffer);
+
+  }
+
+  void Deserialize(const uint64_t*& cursor,
+                   const uint64_t* end) override {
+
+    DeserializeKeys(cursor, end, window_);
+    DeserializeKeys(cursor, end, probation_);
+    DeserializeKeys(cursor, end, protected_);
+    sketch_.Deserialize(cursor, end);
+
+    key_finder_.clear();
+    for(auto segment : {SEGMENT_WINDOW, SEGMENT_PROBATION, SEGMENT_PROTECTED}){
+      auto& keys = GetSegment(segment);
+      for(auto itr = keys.begin(); itr != keys.end(); itr++){
+        key_finder_[*itr] = {itr, segment};
+      }
+    }
+
+  }
+
+ private:
+
+  enum Segment {
+    SEGMENT_WINDOW = 0,
+    SEGMENT_PROBATION = 1,
+    SEGMENT_PROTECTED = 2
+  };
+
+  struct Entry {
+    lru_iterator position;
+    Segment segment;
+  };
+
+  std::list<Key>& GetSegment(const Segment& segment){
+    switch(segment){
+      case SEGMENT_WINDOW:
+        return window_;
+      case SEGMENT_PROBATION:
+        return probation_;
+      case SEGMENT_PROTECTED:
+      default:
+        return protected_;
+    }
+  }
+
+  // Move a resident key to the front of a segment
+  void MoveFront(const Key& key,
+                 std::list<Key>& keys,
+                 const Segment& segment){
+    auto& entry = key_finder_[key];
+    keys.splice(keys.begin(), GetSegment(entry.segment), entry.position);
+    entry.segment = segment;
+  }
+
+  size_t window_capacity_;
+
+  size_t protected_capacity_;
+
+  std::list<Key> window_;
+  std::list<Key> probation_;
+  std::list<Key> protected_;
+
+  std::unordered_map<Key, Entry> key_finder_;
+
+  FrequencySketch sketch_;
+
+};
+
+}  // End machine namespace
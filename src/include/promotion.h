@@ -0,0 +1,57 @@
+// PROMOTION HEADER
+
+#pragma once
+
+#include <map>
+#include <ostream>
+#include <vector>
+
+#include "sketch.h"
+#include "types.h"
+
+namespace machine {
+
+// Promotes a block into a faster tier once it has been accessed
+// threshold times within the current window. Access counts live in a
+// count-min sketch that is halved at the end of every window.
+class PromotionEngine {
+ public:
+
+  PromotionEngine(const size_t& window,
+                  const std::map<DeviceType, size_t>& thresholds,
+                  const uint64_t& seed);
+
+  // Count a demand access to the block
+  void Access(const size_t& block_id);
+
+  // Should the block move up into the destination tier?
+  bool ShouldPromote(const size_t& block_id, const DeviceType& destination);
+
+  void ResetStats();
+
+  // Access counts and the position in the window (for snapshots)
+  void Serialize(std::vector<uint64_t>& buffer) const;
+
+  void Deserialize(const uint64_t*& cursor,
+                   const uint64_t* end);
+
+  friend std::ostream& operator<< (std::ostream& stream,
+                                   const PromotionEngine& promotion);
+
+ private:
+
+  size_t window_;
+
+  size_t window_access_count_;
+
+  // accesses needed to move into each tier
+  std::map<DeviceType, size_t> thresholds_;
+
+  CountMinSketch sketch_;
+
+  // promotions into each tier
+  std::map<DeviceType, size_t> promotion_count_;
+
+};
+
+}  // End machine namespace
@@ -0,0 +1,90 @@
+// READAHEAD HEADER
+
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+
+#include "stream_table.h"
+
+namespace machine {
+
+// Blocks in the first readahead window of a stream
+const size_t readahead_initial_window = 4;
+
+// Unused prefetches kept per stream, in maximum windows. Blocks that are
+// never read (or evicted before use) would otherwise pile up for the
+// whole run; the oldest are dropped past twice this bound.
+const size_t readahead_pending_windows = 4;
+
+// Sequential readahead in the style of the Linux page cache.
+// A sequential miss opens a window of blocks to prefetch. The first block
+// of the latest window is the marker: when the stream reaches it, the
+// next window is issued at twice the size, up to the maximum window.
+// Interleaved streams keep separate windows in a stream table.
+class ReadaheadEngine {
+ public:
+
+  ReadaheadEngine(const size_t& max_window);
+
+  // Demand access to a block; slow_access is set when the block is not in
+  // a fast tier. Appends the blocks to prefetch.
+  void Access(const size_t& block_id,
+              const bool& slow_access,
+              std::vector<size_t>& prefetch_blocks);
+
+  // A prefetch was issued and the block is ready at ready_time (ns)
+  void RecordPrefetch(const size_t& block_id, const double& ready_time);
+
+  // Demand access to a prefetched block, returns false if it was not
+  // prefetched or already used
+  bool UsePrefetch(const size_t& block_id, double& ready_time);
+
+  // Demand access to a slow tier that prefetching did not cover
+  void RecordMiss();
+
+  // Waited for an in-flight prefetch
+  void RecordLateUse();
+
+  // Prefetched blocks not used yet
+  size_t GetPendingCount() const;
+
+  void ResetStats();
+
+  friend std::ostream& operator<< (std::ostream& stream,
+                                   const ReadaheadEngine& readahead);
+
+ private:
+
+  struct Stream {
+    size_t window;
+    size_t prefetch_end;
+    size_t marker;
+  };
+
+  // Issue the next window at the end of the stream's readahead
+  void IssueWindow(Stream& stream, std::vector<size_t>& prefetch_blocks);
+
+  // Drop the oldest unused prefetches past the pending bound
+  void TrimPending();
+
+  size_t max_window_;
+
+  StreamTable stream_table_;
+
+  // readahead state of each stream table slot
+  std::vector<Stream> streams_;
+
+  // prefetched blocks not used yet, with their ready time
+  std::unordered_map<size_t, double> pending_blocks_;
+
+  size_t prefetch_count_ = 0;
+  size_t use_count_ = 0;
+  size_t late_use_count_ = 0;
+  size_t miss_count_ = 0;
+
+};
+
+}  // End machine namespace
@@ -0,0 +1,74 @@
+// REBALANCER HEADER
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+
+namespace machine {
+
+// Periodic hot/cold classification in the style of kernel memory tiering.
+// Blocks carry aging access counters (halved every epoch). At the end of
+// an epoch the hottest blocks of the slow tier are swapped with the
+// coldest blocks of the fast tier, up to a migration budget.
+class EpochRebalancer {
+ public:
+
+  EpochRebalancer(const size_t& epoch_length, const size_t& budget);
+
+  // Count a demand access to the block
+  void Access(const size_t& block_id);
+
+  // Count an operation, returns true at the end of an epoch
+  bool Tick();
+
+  // Plan the migrations of this epoch and age the counters.
+  // fast_blocks are resident in the fast tier, which has free_slots
+  // empty slots; in_slow_tier tells if a block sits in the slow tier.
+  void Plan(const std::vector<int>& fast_blocks,
+            const size_t& free_slots,
+            const std::function<bool(const size_t&)>& in_slow_tier,
+            std::vector<size_t>& promote_blocks,
+            std::vector<size_t>& demote_blocks);
+
+  // Account for the migrations of an epoch and their device time (ns)
+  void RecordMigration(const size_t& promote_count,
+                       const size_t& demote_count,
+                       const double& duration);
+
+  double GetMigrationDuration() const;
+
+  void ResetStats();
+
+  // Access counters and the position in the epoch (for snapshots)
+  void Serialize(std::vector<uint64_t>& buffer) const;
+
+  void Deserialize(const uint64_t*& cursor,
+                   const uint64_t* end);
+
+  friend std::ostream& operator<< (std::ostream& stream,
+                                   const EpochRebalancer& rebalancer);
+
+ private:
+
+  size_t epoch_length_;
+
+  size_t budget_;
+
+  size_t operation_count_;
+
+  // aging access counters
+  std::unordered_map<size_t, uint32_t> access_count_;
+
+  size_t epoch_count_ = 0;
+  size_t promote_count_ = 0;
+  size_t demote_count_ = 0;
+  double migration_duration_ = 0;
+
+};
+
+}  // End machine namespace
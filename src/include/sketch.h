@@ -0,0 +1,92 @@
+// SKETCH HEADER
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace machine {
+
+// Count-min sketch with conservative update.
+// Estimates never undercount; halving every counter ages old accesses.
+class CountMinSketch {
+ public:
+
+  // width is rounded up to a power of two
+  CountMinSketch(const size_t& width,
+                 const size_t& depth,
+                 const uint64_t& seed);
+
+  // Count an access and return the new estimate
+  uint32_t Increment(const uint64_t& key);
+
+  uint32_t Estimate(const uint64_t& key) const;
+
+  // Halve every counter
+  void Age();
+
+  void Reset();
+
+  void Serialize(std::vector<uint64_t>& buffer) const;
+
+  void Deserialize(const uint64_t*& cursor,
+                   const uint64_t* end);
+
+ private:
+
+  size_t GetIndex(const uint64_t& key, const size_t& row) const;
+
+  size_t width_;
+
+  size_t depth_;
+
+  // per-row hash seeds
+  std::vector<uint64_t> seeds_;
+
+  // depth rows of width counters
+  std::vector<uint32_t> counters_;
+
+};
+
+// Count-min sketch of 4-bit counters packed sixteen to a 64-bit word.
+// The four counters of a key lie in one word, one per quarter, so an
+// access updates them with a single saturating add and aging halves
+// sixteen counters per shift. The counts are halved once the sketch has
+// seen ten increments per word.
+class FrequencySketch {
+ public:
+
+  FrequencySketch(const uint64_t& seed);
+
+  // Grow the table to at least entry_count words, keeping the estimates
+  void EnsureCapacity(const size_t& entry_count);
+
+  // Count an access (counters saturate at 15)
+  void Increment(const uint64_t& key);
+
+  uint32_t Estimate(const uint64_t& key) const;
+
+  // Halve every counter
+  void Age();
+
+  void Serialize(std::vector<uint64_t>& buffer) const;
+
+  void Deserialize(const uint64_t*& cursor,
+                   const uint64_t* end);
+
+ private:
+
+  // word of the key and the bit offsets of its counters in that word
+  size_t GetWord(const uint64_t& key, uint64_t& increments) const;
+
+  uint64_t seed_;
+
+  std::vector<uint64_t> table_;
+
+  // increments since the last aging
+  size_t increment_count_;
+
+};
+
+}  // End machine namespace
@@ -0,0 +1,66 @@
+// SNAPSHOT HEADER
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace machine {
+
+class configuration;
+
+// Write the state of every tier (resident blocks, dirty bits and policy
+// metadata), the access counts of promotion and rebalancing, the SSD flash
+// layout and the NVM wear after the given operation to a binary snapshot
+// file
+void SaveSnapshot(const configuration& state,
+                  const std::string& file_name,
+                  const size_t& operation_itr);
+
+// Restore the state of every tier, the access counts, the flash layout and
+// the wear from a snapshot file
+// Returns the operation index to resume the replay from
+size_t LoadSnapshot(configuration& state,
+                    const std::string& file_name);
+
+// Exit unless the snapshot value matches the running configuration
+inline void CheckSnapshotField(const char *name,
+                               const uint64_t& snapshot_value,
+                               const uint64_t& expected_value){
+  if(snapshot_value != expected_value){
+    std::cout << "Snapshot mismatch in " << name << " : "
+        << snapshot_value << " (expected " << expected_value << ")\n";
+    exit(EXIT_FAILURE);
+  }
+}
+
+// Exit unless the snapshot value is below limit (e.g. an index)
+inline void CheckSnapshotRange(const char *name,
+                               const uint64_t& snapshot_value,
+                               const uint64_t& limit){
+  if(snapshot_value >= limit){
+    std::cout << "Corrupt snapshot : " << name << " " << snapshot_value
+        << " out of range (limit " << limit << ")\n";
+    exit(EXIT_FAILURE);
+  }
+}
+
+// Exit on a truncated or corrupt snapshot unless count entries of width
+// words remain before end
+inline void CheckSnapshotSize(const uint64_t* cursor,
+                              const uint64_t* end,
+                              const uint64_t& count,
+                              const uint64_t& width = 1){
+  // Divide instead of multiplying so a corrupt count cannot overflow
+  uint64_t remaining_words = end - cursor;
+  if(count > remaining_words / width){
+    std::cout << "Corrupt snapshot : " << count << " entries of " << width
+        << " words past the end\n";
+    exit(EXIT_FAILURE);
+  }
+}
+
+}  // End machine namespace
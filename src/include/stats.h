@@ -3,6 +3,7 @@
 #pragma once
 
 #include <map>
+#include <vector>
 
 #include "types.h"
 
@@ -20,6 +21,33 @@ class Stats{
 
   void IncrementWriteCount(DeviceType device_type);
 
+  // record the simulated latency of an operation
+  void RecordLatency(const double& latency);
+
+  // record the flash work behind an SSD host write
+  void RecordFlashWrite(const size_t& relocated_page_count,
+                        const size_t& erased_block_count,
+                        const double& stall);
+
+  // record a demand access, hit when a tier above the last device
+  // holds the block
+  void RecordTierAccess(const bool& hit);
+
+  size_t GetTierAccessCount() const;
+
+  size_t GetTierHitCount() const;
+
+  size_t GetFlashHostWriteCount() const;
+
+  size_t GetFlashRelocatedPageCount() const;
+
+  size_t GetFlashErasedBlockCount() const;
+
+  double GetFlashStall() const;
+
+  // latency at the given percentile (bucket lower bound)
+  double GetLatencyPercentile(const double& percentile) const;
+
   friend std::ostream& operator<< (std::ostream& stream, const Stats& stats);
 
  private:
@@ -30,6 +58,29 @@ class Stats{
   // Write op count
   std::map<DeviceType, size_t> write_ops;
 
+  // Latency histogram (8 sub-buckets per power of two)
+  std::vector<size_t> latency_histogram;
+
+  size_t latency_count = 0;
+
+  double latency_sum = 0;
+
+  double latency_max = 0;
+
+  // Demand accesses served above the last device
+  size_t tier_access_count = 0;
+
+  size_t tier_hit_count = 0;
+
+  // SSD flash translation layer
+  size_t flash_host_write_count = 0;
+
+  size_t flash_relocated_page_count = 0;
+
+  size_t flash_erased_block_count = 0;
+
+  double flash_stall = 0;
+
 };
 
 }  // End machine namespace
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "cache.h"
+#include "dirty_index.h"
 #include "types.h"
 
 namespace machine {
@@ -23,8 +24,24 @@ class StorageCache {
 
   size_t CurrentCapacity() const;
 
+  void GetKeys(std::vector<int>& keys) const;
+
+  // dirty blocks in ascending order
+  void GetDirtyBlocks(std::vector<size_t>& blocks) const;
+
+  size_t GetDirtyCount() const;
+
   bool IsSequential(const size_t& next);
 
+  // cost of evicting a clean and a dirty block (ns)
+  void SetEvictionCost(const uint64_t& clean_cost,
+                       const uint64_t& dirty_cost);
+
+  void Serialize(std::vector<uint64_t>& buffer) const;
+
+  void Deserialize(const uint64_t*& cursor,
+                   const uint64_t* end);
+
   friend std::ostream& operator<< (std::ostream& stream,
                                    const StorageCache& cache);
 
@@ -40,6 +57,21 @@ class StorageCache {
 
   Cache<int, int, ARCCachePolicy<int>>* arc_cache = nullptr;
 
+  Cache<int, int, CLOCKCachePolicy<int>>* clock_cache = nullptr;
+
+  Cache<int, int, CLOCKProCachePolicy<int>>* clock_pro_cache = nullptr;
+
+  Cache<int, int, WTinyLFUCachePolicy<int>>* wtinylfu_cache = nullptr;
+
+  Cache<int, int, LIRSCachePolicy<int>>* lirs_cache = nullptr;
+
+  Cache<int, int, TwoQCachePolicy<int>>* two_q_cache = nullptr;
+
+  Cache<int, int, GreedyDualCachePolicy<int>>* greedy_dual_cache = nullptr;
+
+  // dirty blocks (shared by the copies of this cache)
+  DirtyIndex* dirty_index = nullptr;
+
   // current block accessed
   size_t current_ = 0;
 
@@ -0,0 +1,55 @@
+// STREAM TABLE HEADER
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace machine {
+
+// Concurrent sequential streams tracked per table (--streams)
+extern size_t stream_table_size;
+
+// Table of concurrent sequential streams with LRU replacement.
+// A block continues a stream when it is next to the stream's last block;
+// otherwise it starts a new stream in place of the least recently used.
+// Accessing a stream's last block again only refreshes the stream.
+class StreamTable {
+ public:
+
+  StreamTable(const size_t& stream_count = stream_table_size,
+              const bool& forward_only = false);
+
+  // Returns the slot of the stream the block belongs to; sequential is
+  // set when it continues an existing stream (or repeats the last block
+  // of a stream that was sequential)
+  size_t Access(const size_t& block_id, bool& sequential);
+
+  size_t GetStreamCount() const;
+
+  // append the streams to a snapshot
+  void Serialize(std::vector<uint64_t>& buffer) const;
+
+  // restore the streams from a snapshot
+  void Deserialize(const uint64_t*& cursor,
+                   const uint64_t* end);
+
+ private:
+
+  bool forward_only_;
+
+  // last block of each stream
+  std::vector<size_t> last_block_;
+
+  // whether the last block of each stream continued it
+  std::vector<bool> sequential_;
+
+  // access stamp of each stream (0 is unused)
+  std::vector<size_t> last_access_;
+
+  size_t access_clock_;
+
+};
+
+}  // End machine namespace
@@ -12,7 +12,10 @@ enum HierarchyType {
   HIERARCHY_TYPE_NVM = 1,
   HIERARCHY_TYPE_DRAM_NVM = 2,
   HIERARCHY_TYPE_DRAM_SSD = 3,
-  HIERARCHY_TYPE_DRAM_NVM_SSD = 4
+  HIERARCHY_TYPE_DRAM_NVM_SSD = 4,
+
+  // tiers declared by a topology file
+  HIERARCHY_TYPE_TOPOLOGY = 5
 
 };
 
@@ -43,7 +46,16 @@ enum CachingType {
   CACHING_TYPE_FIFO = 1,
   CACHING_TYPE_LRU = 2,
   CACHING_TYPE_LFU = 3,
-  CACHING_TYPE_ARC = 4
+  CACHING_TYPE_ARC = 4,
+  CACHING_TYPE_CLOCK = 5,
+  CACHING_TYPE_CLOCK_PRO = 6,
+  CACHING_TYPE_WTINYLFU = 7,
+  CACHING_TYPE_LIRS = 8,
+  CACHING_TYPE_2Q = 9,
+  CACHING_TYPE_GREEDY_DUAL = 10,
+
+  // Last valid caching type (move it along when adding a policy)
+  CACHING_TYPE_MAX = CACHING_TYPE_GREEDY_DUAL
 
 };
 
@@ -53,7 +65,30 @@ enum DeviceType {
   DEVICE_TYPE_CACHE = 1,
   DEVICE_TYPE_DRAM = 2,
   DEVICE_TYPE_NVM = 3,
-  DEVICE_TYPE_SSD = 4
+  DEVICE_TYPE_SSD = 4,
+
+  // first device type of the tiers declared by a topology file
+  DEVICE_TYPE_CUSTOM = 5
+
+};
+
+enum InclusionType {
+  INCLUSION_TYPE_INVALID = 0,
+
+  // a block may be held by several tiers
+  INCLUSION_TYPE_INCLUSIVE = 1,
+  // a block is held by one tier above the last device
+  INCLUSION_TYPE_EXCLUSIVE = 2
+
+};
+
+enum DistributionType {
+  DISTRIBUTION_TYPE_INVALID = 0,
+
+  DISTRIBUTION_TYPE_ZIPF = 1,
+  DISTRIBUTION_TYPE_SCRAMBLED_ZIPF = 2,
+  DISTRIBUTION_TYPE_HOTSPOT = 3,
+  DISTRIBUTION_TYPE_LATEST = 4
 
 };
 
@@ -69,5 +104,12 @@ std::string CachingTypeToString(const CachingType& caching_type);
 
 std::string DeviceTypeToString(const DeviceType& device_type);
 
+// Name a device type declared by a topology file
+void SetDeviceTypeName(const DeviceType& device_type, const std::string& name);
+
+std::string InclusionTypeToString(const InclusionType& inclusion_type);
+
+std::string DistributionTypeToString(const DistributionType& distribution_type);
+
 
 }  // End machine namespace
@@ -0,0 +1,77 @@
+// WAL HEADER
+
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+
+#include "types.h"
+
+namespace machine {
+
+// Write-ahead log on a dedicated device. Records are appended to an
+// in-memory buffer and made durable by sequential page writes. A commit
+// opens a group that is flushed commit_interval ns later (or once the
+// previous flush is done); commits that arrive before the flush is issued
+// join the group and share its write.
+class WriteAheadLog {
+ public:
+
+  WriteAheadLog(const DeviceType& device_type,
+                const double& page_write_latency,
+                const double& commit_interval,
+                const size_t& record_size);
+
+  // Add a record to the log buffer
+  void Append();
+
+  // Time the log is durable up to the records appended so far, for a
+  // commit issued at now
+  double Commit(const double& now);
+
+  // Foreground time lost waiting for the log
+  void RecordCommitWait(const double& wait);
+
+  DeviceType GetDeviceType() const;
+
+  void ResetStats();
+
+  friend std::ostream& operator<< (std::ostream& stream,
+                                   const WriteAheadLog& write_ahead_log);
+
+ private:
+
+  // Write time of the log between the two offsets (bytes)
+  double GetFlushLatency(const size_t& start_offset,
+                         const size_t& end_offset) const;
+
+  DeviceType device_type_;
+
+  double page_write_latency_;
+
+  double commit_interval_;
+
+  size_t record_size_;
+
+  // end of the appended records (bytes)
+  size_t tail_offset_;
+
+  // end of the records covered by an issued or pending flush
+  size_t scheduled_offset_;
+
+  // pending group: flushes [group_start_offset_, scheduled_offset_) at
+  // group_issue_time_ and completes at group_completion_time_
+  size_t group_start_offset_;
+  double group_issue_time_;
+  double group_completion_time_;
+
+  size_t append_count_ = 0;
+  size_t commit_count_ = 0;
+  size_t flush_count_ = 0;
+  size_t page_count_ = 0;
+  double commit_wait_time_ = 0;
+  double max_commit_wait_time_ = 0;
+
+};
+
+}  // End machine namespace
@@ -0,0 +1,65 @@
+// WEAR HEADER
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+
+namespace machine {
+
+// Blocks in a wear region (1 MB of 4K blocks)
+const size_t wear_region_block_count = 256;
+
+// Write counts of a device with limited endurance.
+// Blocks are tracked individually and in regions; a device that levels
+// wear inside a region wears out with its most written region.
+class WearTracker {
+ public:
+
+  void RecordWrite(const size_t& block_id);
+
+  size_t GetBlockWriteCount(const size_t& block_id) const;
+
+  size_t GetWriteCount() const;
+
+  void Reset();
+
+  // Save the block write counts (regions are summed again on load)
+  void Serialize(std::vector<uint64_t>& buffer) const;
+
+  void Deserialize(const uint64_t*& cursor,
+                   const uint64_t* end);
+
+  // Projected lifetimes (years) for cells that take endurance writes,
+  // given the writes seen over duration (ns) on capacity blocks
+  double GetBlockLifetime(const double& endurance,
+                          const double& duration) const;
+
+  double GetRegionLifetime(const double& endurance,
+                           const double& duration) const;
+
+  double GetLeveledLifetime(const double& endurance,
+                            const double& duration,
+                            const size_t& capacity) const;
+
+  friend std::ostream& operator<< (std::ostream& stream,
+                                   const WearTracker& wear_tracker);
+
+ private:
+
+  size_t GetMaxBlockWriteCount() const;
+
+  size_t GetMaxRegionWriteCount() const;
+
+  std::unordered_map<size_t, size_t> block_write_count_;
+
+  std::unordered_map<size_t, size_t> region_write_count_;
+
+  size_t write_count_ = 0;
+
+};
+
+}  // End machine namespace
@@ -8,6 +8,36 @@ namespace machine {
 
 extern configuration state;
 
+extern double total_duration;
+
+void BootstrapBlock(const size_t& block_id);
+
+void ReadBlock(const size_t& block_id);
+
+void WriteBlock(const size_t& block_id);
+
+void FlushBlock(const size_t& block_id);
+
+// Start promotion with fresh access counts
+void ResetPromotionEngine();
+
+// Start readahead, promotion, flushing, checkpointing, logging and
+// rebalancing afresh, as configured
+void ResetWorkloadEngines();
+
+class PromotionEngine;
+class EpochRebalancer;
+
+// Hotness-driven promotion between tiers
+PromotionEngine* GetPromotionEngine();
+
+// Epoch rebalancer (nullptr without a rebalance epoch)
+EpochRebalancer* GetRebalancer();
+
+// Replay a single trace operation (returns false on unknown operation)
+bool ExecuteOperation(const char& operation_type,
+                      const size_t& block_id);
+
 void RunMachineTest();
 
 }  // namespace machine
@@ -0,0 +1,120 @@
+// MIGRATION SOURCE
+
+#include <algorithm>
+#include <iomanip>
+
+#include "migration.h"
+
+namespace machine {
+
+MigrationQueue::MigrationQueue(const size_t& queue_depth,
+                               const double& bandwidth,
+                               const size_t& block_size)
+: queue_depth_(queue_depth),
+  transfer_time_(0),
+  pacing_clock_(0) {
+
+  // MB/s to ns per block
+  if(bandwidth > 0){
+    transfer_time_ = (block_size * 1000.0)/bandwidth;
+  }
+
+}
+
+void MigrationQueue::Retire(const double& now){
+
+  while(jobs_.empty() == false && jobs_.top().first <= now){
+    auto& job = jobs_.top();
+    auto block_itr = in_flight_.find(job.second);
+    if(block_itr != in_flight_.end() && block_itr->second <= job.first){
+      in_flight_.erase(block_itr);
+    }
+    jobs_.pop();
+  }
+
+}
+
+double MigrationQueue::Admit(const double& arrival_time){
+
+  Retire(arrival_time);
+
+  // Wait for the earliest job to finish
+  auto admission_time = arrival_time;
+  if(jobs_.size() >= queue_depth_){
+    admission_time = jobs_.top().first;
+    Retire(admission_time);
+  }
+
+  return admission_time;
+}
+
+double MigrationQueue::GetStartTime(const double& admission_time) const {
+  return std::max(admission_time, pacing_clock_);
+}
+
+double MigrationQueue::Complete(const size_t& block_id,
+                                const double& start_time,
+                                const double& device_time){
+
+  pacing_clock_ = start_time + transfer_time_;
+  auto completion_time = std::max(device_time, pacing_clock_);
+
+  jobs_.push({completion_time, block_id});
+  in_flight_[block_id] = completion_time;
+
+  job_count_++;
+  busy_time_ += completion_time - start_time;
+
+  return completion_time;
+}
+
+bool MigrationQueue::IsInFlight(const size_t& block_id,
+                                const double& now,
+                                double& ready_time){
+
+  auto block_itr = in_flight_.find(block_id);
+  if(block_itr == in_flight_.end() || block_itr->second <= now){
+    return false;
+  }
+
+  ready_time = block_itr->second;
+  return true;
+}
+
+void MigrationQueue::RecordFullStall(const double& stall){
+  full_stall_count_++;
+  full_stall_time_ += stall;
+}
+
+void MigrationQueue::RecordInFlightStall(const double& stall){
+  in_flight_stall_count_++;
+  in_flight_stall_time_ += stall;
+}
+
+void MigrationQueue::ResetStats(){
+  job_count_ = 0;
+  busy_time_ = 0;
+  full_stall_count_ = 0;
+  full_stall_time_ = 0;
+  in_flight_stall_count_ = 0;
+  in_flight_stall_time_ = 0;
+}
+
+std::ostream& operator<< (std::ostream& os,
+                          const MigrationQueue& migration_queue){
+
+  os << "MIGRATION QUEUE (count, time ns): \n";
+  os << std::setw(10) << "JOBS" << " :: "
+      << migration_queue.job_count_ << " "
+      << migration_queue.busy_time_ << "\n";
+  os << std::setw(10) << "FULL" << " :: "
+      << migration_queue.full_stall_count_ << " "
+      << migration_queue.full_stall_time_ << "\n";
+  os << std::setw(10) << "IN FLIGHT" << " :: "
+      << migration_queue.in_flight_stall_count_ << " "
+      << migration_queue.in_flight_stall_time_ << "\n";
+
+  return os;
+}
+
+}  // End machine namespace
@@ -0,0 +1,81 @@
+// PROMOTION SOURCE
+
+#include <iomanip>
+
+#include "promotion.h"
+#include "snapshot.h"
+
+namespace machine {
+
+// Sketch shape: 4 rows of 64K counters
+const size_t promotion_sketch_width = 64 * 1024;
+const size_t promotion_sketch_depth = 4;
+
+PromotionEngine::PromotionEngine(const size_t& window,
+                                 const std::map<DeviceType, size_t>& thresholds,
+                                 const uint64_t& seed)
+: window_(window),
+  window_access_count_(0),
+  thresholds_(thresholds),
+  sketch_(promotion_sketch_width, promotion_sketch_depth, seed) {
+  // Nothing to do here!
+}
+
+void PromotionEngine::Access(const size_t& block_id){
+
+  sketch_.Increment(block_id);
+
+  // Age the counts at the end of the window
+  window_access_count_++;
+  if(window_access_count_ == window_){
+    sketch_.Age();
+    window_access_count_ = 0;
+  }
+
+}
+
+bool PromotionEngine::ShouldPromote(const size_t& block_id,
+                                    const DeviceType& destination){
+
+  auto threshold = thresholds_[destination];
+  if(sketch_.Estimate(block_id) < threshold){
+    return false;
+  }
+
+  promotion_count_[destination]++;
+  return true;
+}
+
+void PromotionEngine::ResetStats(){
+  promotion_count_.clear();
+}
+
+void PromotionEngine::Serialize(std::vector<uint64_t>& buffer) const {
+  buffer.push_back(window_access_count_);
+  sketch_.Serialize(buffer);
+}
+
+void PromotionEngine::Deserialize(const uint64_t*& cursor,
+                                  const uint64_t* end){
+  CheckSnapshotSize(cursor, end, 1);
+  window_access_count_ = *cursor++;
+  sketch_.Deserialize(cursor, end);
+}
+
+std::ostream& operator<< (std::ostream& os, const PromotionEngine& promotion){
+
+  os << "PROMOTIONS (threshold, count): \n";
+  for(auto entry : promotion.thresholds_){
+    size_t promotion_count = 0;
+    auto count_itr = promotion.promotion_count_.find(entry.first);
+    if(count_itr != promotion.promotion_count_.end()){
+      promotion_count = count_itr->second;
+    }
+    os << std::setw(10) << DeviceTypeToString(entry.first) << " :: "
+        << entry.second << " " << promotion_count << "\n";
+  }
+
+  return os;
+}
+
+}  // End machine namespace
@@ -0,0 +1,164 @@
+// READAHEAD SOURCE
+
+#include <algorithm>
+#include <iomanip>
+#include <limits>
+
+#include "readahead.h"
+
+namespace machine {
+
+const size_t invalid_block = std::numeric_limits<size_t>::max();
+
+ReadaheadEngine::ReadaheadEngine(const size_t& max_window)
+: max_window_(max_window),
+  stream_table_(stream_table_size, true),
+  streams_(stream_table_size, {0, 0, invalid_block}) {
+  // Nothing to do here!
+}
+
+void ReadaheadEngine::IssueWindow(Stream& stream,
+                                  std::vector<size_t>& prefetch_blocks){
+
+  // The stream reaching the start of this window issues the next one
+  stream.marker = stream.prefetch_end;
+
+  for(size_t block_itr = 0; block_itr < stream.window; block_itr++){
+    prefetch_blocks.push_back(stream.prefetch_end + block_itr);
+  }
+  stream.prefetch_end += stream.window;
+
+}
+
+void ReadaheadEngine::Access(const size_t& block_id,
+                             const bool& slow_access,
+                             std::vector<size_t>& prefetch_blocks){
+
+  bool sequential = false;
+  auto slot = stream_table_.Access(block_id, sequential);
+  auto& stream = streams_[slot];
+
+  // New stream in this slot
+  if(sequential == false){
+    stream = {0, 0, invalid_block};
+    return;
+  }
+
+  // Asynchronous readahead: ramp up the window
+  if(block_id == stream.marker){
+    stream.window = std::min(stream.window * 2, max_window_);
+    IssueWindow(stream, prefetch_blocks);
+    return;
+  }
+
+  // Synchronous readahead: a sequential miss (re)starts the stream
+  if(slow_access == true){
+    stream.window = std::min(readahead_initial_window, max_window_);
+    stream.prefetch_end = block_id + 1;
+    IssueWindow(stream, prefetch_blocks);
+  }
+
+}
+
+void ReadaheadEngine::RecordPrefetch(const size_t& block_id,
+                                     const double& ready_time){
+  // Moving a pending block up another tier is the same prefetch
+  auto pending_itr = pending_blocks_.find(block_id);
+  if(pending_itr != pending_blocks_.end()){
+    pending_itr->second = ready_time;
+    return;
+  }
+
+  pending_blocks_[block_id] = ready_time;
+  prefetch_count_++;
+
+  TrimPending();
+}
+
+void ReadaheadEngine::TrimPending(){
+
+  auto pending_limit = std::max<size_t>(readahead_pending_windows *
+                                        max_window_ *
+                                        stream_table_.GetStreamCount(), 1);
+  if(pending_blocks_.size() <= 2 * pending_limit){
+    return;
+  }
+
+  // Keep the pending_limit latest prefetches (by ready time)
+  std::vector<double> ready_times;
+  ready_times.reserve(pending_blocks_.size());
+  for(auto& entry : pending_blocks_){
+    ready_times.push_back(entry.second);
+  }
+  auto oldest_kept = ready_times.end() - pending_limit;
+  std::nth_element(ready_times.begin(), oldest_kept, ready_times.end());
+  auto ready_time_limit = *oldest_kept;
+
+  for(auto pending_itr = pending_blocks_.begin();
+      pending_itr != pending_blocks_.end();){
+    if(pending_itr->second < ready_time_limit){
+      pending_itr = pending_blocks_.erase(pending_itr);
+    }
+    else {
+      pending_itr++;
+    }
+  }
+
+}
+
+bool ReadaheadEngine::UsePrefetch(const size_t& block_id, double& ready_time){
+
+  auto pending_itr = pending_blocks_.find(block_id);
+  if(pending_itr == pending_blocks_.end()){
+    return false;
+  }
+
+  ready_time = pending_itr->second;
+  pending_blocks_.erase(pending_itr);
+  use_count_++;
+  return true;
+}
+
+void ReadaheadEngine::RecordMiss(){
+  miss_count_++;
+}
+
+void ReadaheadEngine::RecordLateUse(){
+  late_use_count_++;
+}
+
+size_t ReadaheadEngine::GetPendingCount() const {
+  return pending_blocks_.size();
+}
+
+void ReadaheadEngine::ResetStats(){
+  prefetch_count_ = 0;
+  use_count_ = 0;
+  late_use_count_ = 0;
+  miss_count_ = 0;
+}
+
+std::ostream& operator<< (std::ostream& os, const ReadaheadEngine& readahead){
+
+  double accuracy = 0;
+  double coverage = 0;
+  if(readahead.prefetch_count_ > 0){
+    accuracy = (double) readahead.use_count_ / readahead.prefetch_count_;
+  }
+  if(readahead.use_count_ + readahead.miss_count_ > 0){
+    coverage = (double) readahead.use_count_ /
+        (readahead.use_count_ + readahead.miss_count_);
+  }
+
+  os << "READAHEAD: \n";
+  os << std::setw(10) << "PREFETCHED" << " :: " << readahead.prefetch_count_ << "\n";
+  os << std::setw(10) << "USED" << " :: " << readahead.use_count_ << "\n";
+  os << std::setw(10) << "LATE" << " :: " << readahead.late_use_count_ << "\n";
+  os << std::setw(10) << "MISSES" << " :: " << readahead.miss_count_ << "\n";
+  os << std::setw(10) << "ACCURACY" << " :: " << accuracy << "\n";
+  os << std::setw(10) << "COVERAGE" << " :: " << coverage << "\n";
+
+  return os;
+}
+
+}  // End machine namespace
@@ -0,0 +1,158 @@
+// REBALANCER SOURCE
+
+#include <algorithm>
+#include <iomanip>
+
+#include "rebalancer.h"
+#include "snapshot.h"
+
+namespace machine {
+
+// accesses that make a slow-tier block hot
+const uint32_t hot_access_count = 2;
+
+EpochRebalancer::EpochRebalancer(const size_t& epoch_length,
+                                 const size_t& budget)
+: epoch_length_(epoch_length),
+  budget_(budget),
+  operation_count_(0) {
+  // Nothing to do here!
+}
+
+void EpochRebalancer::Access(const size_t& block_id){
+  access_count_[block_id]++;
+}
+
+bool EpochRebalancer::Tick(){
+  operation_count_++;
+  if(operation_count_ == epoch_length_){
+    operation_count_ = 0;
+    return true;
+  }
+  return false;
+}
+
+void EpochRebalancer::Plan(const std::vector<int>& fast_blocks,
+                           const size_t& free_slots,
+                           const std::function<bool(const size_t&)>& in_slow_tier,
+                           std::vector<size_t>& promote_blocks,
+                           std::vector<size_t>& demote_blocks){
+
+  using Candidate = std::pair<uint32_t, size_t>;
+  epoch_count_++;
+
+  // Hot set: accessed blocks of the slow tier, hottest first
+  std::vector<Candidate> hot_blocks;
+  for(auto& entry : access_count_){
+    if(entry.second >= hot_access_count && in_slow_tier(entry.first) == true){
+      hot_blocks.push_back({entry.second, entry.first});
+    }
+  }
+  auto hot_count = std::min(hot_blocks.size(), budget_);
+  std::partial_sort(hot_blocks.begin(),
+                    hot_blocks.begin() + hot_count,
+                    hot_blocks.end(),
+                    std::greater<Candidate>());
+
+  // Cold set: blocks of the fast tier, coldest first
+  std::vector<Candidate> cold_blocks;
+  cold_blocks.reserve(fast_blocks.size());
+  for(auto block_id : fast_blocks){
+    auto count_itr = access_count_.find(block_id);
+    uint32_t access_count = 0;
+    if(count_itr != access_count_.end()){
+      access_count = count_itr->second;
+    }
+    cold_blocks.push_back({access_count, block_id});
+  }
+  auto cold_count = std::min(cold_blocks.size(), hot_count);
+  std::partial_sort(cold_blocks.begin(),
+                    cold_blocks.begin() + cold_count,
+                    cold_blocks.end());
+
+  // Fill free slots, then swap while the hot block is hotter
+  size_t cold_itr = 0;
+  for(size_t hot_itr = 0; hot_itr < hot_count; hot_itr++){
+    auto& hot_block = hot_blocks[hot_itr];
+    if(promote_blocks.size() < free_slots){
+      promote_blocks.push_back(hot_block.second);
+      continue;
+    }
+    // Hysteresis keeps blocks from ping-ponging between the tiers
+    if(cold_itr == cold_count ||
+        cold_blocks[cold_itr].first * 2 >= hot_block.first){
+      break;
+    }
+    demote_blocks.push_back(cold_blocks[cold_itr++].second);
+    promote_blocks.push_back(hot_block.second);
+  }
+
+  // Age the counters and forget idle blocks
+  for(auto count_itr = access_count_.begin();
+      count_itr != access_count_.end();){
+    count_itr->second >>= 1;
+    if(count_itr->second == 0){
+      count_itr = access_count_.erase(count_itr);
+    }
+    else {
+      ++count_itr;
+    }
+  }
+
+}
+
+void EpochRebalancer::RecordMigration(const size_t& promote_count,
+                                      const size_t& demote_count,
+                                      const double& duration){
+  promote_count_ += promote_count;
+  demote_count_ += demote_count;
+  migration_duration_ += duration;
+}
+
+double EpochRebalancer::GetMigrationDuration() const {
+  return migration_duration_;
+}
+
+void EpochRebalancer::ResetStats(){
+  epoch_count_ = 0;
+  promote_count_ = 0;
+  demote_count_ = 0;
+  migration_duration_ = 0;
+}
+
+void EpochRebalancer::Serialize(std::vector<uint64_t>& buffer) const {
+  buffer.push_back(operation_count_);
+  buffer.push_back(access_count_.size());
+  for(auto& entry : access_count_){
+    buffer.push_back(entry.first);
+    buffer.push_back(entry.second);
+  }
+}
+
+void EpochRebalancer::Deserialize(const uint64_t*& cursor,
+                                  const uint64_t* end){
+  CheckSnapshotSize(cursor, end, 2);
+  operation_count_ = *cursor++;
+  auto block_count = *cursor++;
+  CheckSnapshotSize(cursor, end, block_count, 2);
+  access_count_.clear();
+  access_count_.reserve(block_count);
+  for(size_t block_itr = 0; block_itr < block_count; block_itr++){
+    auto block_id = *cursor++;
+    access_count_[block_id] = *cursor++;
+  }
+}
+
+std::ostream& operator<< (std::ostream& os, const EpochRebalancer& rebalancer){
+
+  os << "REBALANCER: \n";
+  os << std::setw(10) << "EPOCHS" << " :: " << rebalancer.epoch_count_ << "\n";
+  os << std::setw(10) << "PROMOTED" << " :: " << rebalancer.promote_count_ << "\n";
+  os << std::setw(10) << "DEMOTED" << " :: " << rebalancer.demote_count_ << "\n";
+  os << std::setw(10) << "MIGRATION" << " :: "
+      << rebalancer.migration_duration_ << " ns\n";
+
+  return os;
+}
+
+}  // End machine namespace
@@ -0,0 +1,207 @@
+// SKETCH SOURCE
+
+#include <algorithm>
+#include <limits>
+
+#include "sketch.h"
+#include "snapshot.h"
+
+namespace machine {
+
+// SplitMix64 finalizer
+static uint64_t MixHash(uint64_t value){
+  value += 0x9E3779B97F4A7C15ULL;
+  value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+  return value ^ (value >> 31);
+}
+
+CountMinSketch::CountMinSketch(const size_t& width,
+                               const size_t& depth,
+                               const uint64_t& seed)
+: width_(1),
+  depth_(depth) {
+
+  while(width_ < width){
+    width_ <<= 1;
+  }
+
+  uint64_t row_seed = seed;
+  for(size_t row = 0; row < depth_; row++){
+    row_seed = MixHash(row_seed);
+    seeds_.push_back(row_seed);
+  }
+
+  counters_.assign(width_ * depth_, 0);
+}
+
+size_t CountMinSketch::GetIndex(const uint64_t& key, const size_t& row) const {
+  return row * width_ + (MixHash(key ^ seeds_[row]) & (width_ - 1));
+}
+
+uint32_t CountMinSketch::Estimate(const uint64_t& key) const {
+  auto estimate = std::numeric_limits<uint32_t>::max();
+  for(size_t row = 0; row < depth_; row++){
+    estimate = std::min(estimate, counters_[GetIndex(key, row)]);
+  }
+  return estimate;
+}
+
+uint32_t CountMinSketch::Increment(const uint64_t& key){
+
+  // Conservative update: only raise the counters at the minimum
+  auto estimate = Estimate(key) + 1;
+  for(size_t row = 0; row < depth_; row++){
+    auto& counter = counters_[GetIndex(key, row)];
+    counter = std::max(counter, estimate);
+  }
+
+  return estimate;
+}
+
+void CountMinSketch::Age(){
+  for(auto& counter : counters_){
+    counter >>= 1;
+  }
+}
+
+void CountMinSketch::Reset(){
+  std::fill(counters_.begin(), counters_.end(), 0);
+}
+
+// Two counters per word
+void CountMinSketch::Serialize(std::vector<uint64_t>& buffer) const {
+  buffer.push_back(counters_.size());
+  for(size_t counter_itr = 0; counter_itr < counters_.size(); counter_itr += 2){
+    uint64_t word = counters_[counter_itr];
+    if(counter_itr + 1 < counters_.size()){
+      word |= static_cast<uint64_t>(counters_[counter_itr + 1]) << 32;
+    }
+    buffer.push_back(word);
+  }
+}
+
+void CountMinSketch::Deserialize(const uint64_t*& cursor,
+                                 const uint64_t* end){
+  CheckSnapshotSize(cursor, end, 1);
+  auto size = *cursor++;
+  CheckSnapshotSize(cursor, end, (size + 1) / 2);
+  counters_.resize(size);
+  for(size_t counter_itr = 0; counter_itr < size; counter_itr += 2){
+    auto word = *cursor++;
+    counters_[counter_itr] = static_cast<uint32_t>(word);
+    if(counter_itr + 1 < size){
+      counters_[counter_itr + 1] = static_cast<uint32_t>(word >> 32);
+    }
+  }
+}
+
+// Largest frequency sketch (words)
+const size_t frequency_sketch_max_size = 1 << 22;
+
+// Low bit and low three bits of each 4-bit counter
+const uint64_t counter_low_bits = 0x1111111111111111ULL;
+const uint64_t counter_mask = 0x7777777777777777ULL;
+
+FrequencySketch::FrequencySketch(const uint64_t& seed)
+: seed_(seed),
+  table_(16, 0),
+  increment_count_(0) {
+  // Nothing to do here!
+}
+
+void FrequencySketch::EnsureCapacity(const size_t& entry_count){
+
+  if(entry_count <= table_.size() ||
+      table_.size() >= frequency_sketch_max_size){
+    return;
+  }
+
+  auto old_size = table_.size();
+  auto size = old_size;
+  while(size < entry_count && size < frequency_sketch_max_size){
+    size <<= 1;
+  }
+
+  // A key lands on its old word modulo the old size, so copies of the old
+  // table keep every estimate
+  table_.resize(size);
+  for(size_t word_itr = old_size; word_itr < size; word_itr++){
+    table_[word_itr] = table_[word_itr % old_size];
+  }
+}
+
+size_t FrequencySketch::GetWord(const uint64_t& key,
+                                uint64_t& increments) const {
+
+  auto hash = MixHash(key ^ seed_);
+
+  // Each row picks one of the four counters in its quarter of the word
+  increments = 0;
+  for(size_t row = 0; row < 4; row++){
+    auto counter = row * 4 + ((hash >> (32 + 2 * row)) & 3);
+    increments |= 1ULL << (counter * 4);
+  }
+
+  return hash & (table_.size() - 1);
+}
+
+void FrequencySketch::Increment(const uint64_t& key){
+
+  uint64_t increments;
+  auto& word = table_[GetWord(key, increments)];
+
+  // Skip the counters already at 15
+  auto saturated = word & (word >> 1) & (word >> 2) & (word >> 3) &
+      counter_low_bits;
+  increments &= ~saturated;
+  if(increments == 0){
+    return;
+  }
+
+  word += increments;
+  increment_count_++;
+  if(increment_count_ == 10 * table_.size()){
+    Age();
+  }
+}
+
+uint32_t FrequencySketch::Estimate(const uint64_t& key) const {
+
+  uint64_t increments;
+  auto word = table_[GetWord(key, increments)];
+
+  uint32_t estimate = 15;
+  while(increments != 0){
+    auto shift = __builtin_ctzll(increments);
+    estimate = std::min(estimate, (uint32_t) ((word >> shift) & 15));
+    increments &= increments - 1;
+  }
+
+  return estimate;
+}
+
+void FrequencySketch::Age(){
+  for(auto& word : table_){
+    word = (word >> 1) & counter_mask;
+  }
+  increment_count_ /= 2;
+}
+
+void FrequencySketch::Serialize(std::vector<uint64_t>& buffer) const {
+  buffer.push_back(increment_count_);
+  buffer.push_back(table_.size());
+  buffer.insert(buffer.end(), table_.begin(), table_.end());
+}
+
+void FrequencySketch::Deserialize(const uint64_t*& cursor,
+                                  const uint64_t* end){
+  CheckSnapshotSize(cursor, end, 2);
+  increment_count_ = *cursor++;
+  auto size = *cursor++;
+  CheckSnapshotSize(cursor, end, size);
+  table_.assign(cursor, cursor + size);
+  cursor += size;
+}
+
+}  // End machine namespace
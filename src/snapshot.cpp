@@ -0,0 +1,186 @@
+// SNAPSHOT SOURCE
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include "snapshot.h"
+#include "configuration.h"
+#include "workload.h"
+#include "device.h"
+#include "ftl.h"
+#include "wear.h"
+#include "promotion.h"
+#include "rebalancer.h"
+
+namespace machine {
+
+// "MACHSNAP"
+const uint64_t snapshot_magic = 0x50414E534843414DULL;
+
+const uint64_t snapshot_version = 7;
+
+// Words before the first tier
+const size_t snapshot_header_size = 7;
+
+// Bits of a floating point setting
+static uint64_t GetSnapshotWord(const double& value){
+  uint64_t word;
+  memcpy(&word, &value, sizeof(word));
+  return word;
+}
+
+void SaveSnapshot(const configuration& state,
+                  const std::string& file_name,
+                  const size_t& operation_itr){
+
+  std::vector<uint64_t> buffer;
+
+  // Header
+  buffer.push_back(snapshot_magic);
+  buffer.push_back(snapshot_version);
+  buffer.push_back(operation_itr);
+  buffer.push_back(state.hierarchy_type);
+  buffer.push_back(state.size_type);
+  buffer.push_back(state.caching_type);
+  buffer.push_back(state.devices.size());
+
+  // Tiers
+  for(auto& device : state.devices){
+    buffer.push_back(device.device_type);
+    buffer.push_back(device.cache.caching_type_);
+    buffer.push_back(device.device_size);
+    device.cache.Serialize(buffer);
+  }
+
+  // Access counts behind promotion and rebalancing
+  GetPromotionEngine()->Serialize(buffer);
+  auto rebalancer = GetRebalancer();
+  buffer.push_back(rebalancer != nullptr);
+  if(rebalancer != nullptr){
+    rebalancer->Serialize(buffer);
+  }
+
+  // Flash layout and NVM wear
+  auto ftl = GetFlashTranslationLayer();
+  buffer.push_back(ftl != nullptr);
+  if(ftl != nullptr){
+    buffer.push_back(state.ftl_pages_per_block);
+    buffer.push_back(GetSnapshotWord(state.ftl_overprovisioning));
+    ftl->Serialize(buffer);
+  }
+  GetNVMWear().Serialize(buffer);
+
+  std::ofstream output(file_name, std::ios::binary | std::ios::trunc);
+  output.write(reinterpret_cast<const char*>(buffer.data()),
+               buffer.size() * sizeof(uint64_t));
+
+  if(output.good() == false){
+    std::cout << "Could not write snapshot : " << file_name << "\n";
+    exit(EXIT_FAILURE);
+  }
+
+  std::cout << "Saved snapshot " << file_name << " at operation "
+      << operation_itr << " (" << buffer.size() * sizeof(uint64_t)
+      << " bytes)\n";
+
+}
+
+size_t LoadSnapshot(configuration& state,
+                    const std::string& file_name){
+
+  int fd = open(file_name.c_str(), O_RDONLY);
+  if(fd < 0){
+    std::cout << "Could not open snapshot : " << file_name << "\n";
+    exit(EXIT_FAILURE);
+  }
+
+  struct stat file_stat;
+  if(fstat(fd, &file_stat) != 0){
+    std::cout << "Could not stat snapshot : " << file_name << "\n";
+    exit(EXIT_FAILURE);
+  }
+  size_t file_size = file_stat.st_size;
+
+  // Too short for the header, or not made of whole words
+  if(file_size < snapshot_header_size * sizeof(uint64_t) ||
+      file_size % sizeof(uint64_t) != 0){
+    close(fd);
+    std::cout << "Corrupt snapshot : " << file_name << "\n";
+    exit(EXIT_FAILURE);
+  }
+
+  void *mapping = mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if(mapping == MAP_FAILED){
+    std::cout << "Could not map snapshot : " << file_name << "\n";
+    exit(EXIT_FAILURE);
+  }
+  madvise(mapping, file_size, MADV_SEQUENTIAL);
+
+  const uint64_t *cursor = static_cast<const uint64_t*>(mapping);
+  const uint64_t *end = cursor + file_size / sizeof(uint64_t);
+
+  // Header
+  CheckSnapshotField("magic", *cursor++, snapshot_magic);
+  CheckSnapshotField("version", *cursor++, snapshot_version);
+  auto operation_itr = *cursor++;
+  CheckSnapshotField("hierarchy_type", *cursor++, state.hierarchy_type);
+  CheckSnapshotField("size_type", *cursor++, state.size_type);
+  CheckSnapshotField("caching_type", *cursor++, state.caching_type);
+  CheckSnapshotField("device_count", *cursor++, state.devices.size());
+
+  // Tiers
+  for(auto& device : state.devices){
+    CheckSnapshotSize(cursor, end, 3);
+    CheckSnapshotField("device_type", *cursor++, device.device_type);
+    CheckSnapshotField("tier_caching_type", *cursor++,
+                       device.cache.caching_type_);
+    CheckSnapshotField("device_size", *cursor++, device.device_size);
+    device.cache.Deserialize(cursor, end);
+  }
+
+  // Access counts behind promotion and rebalancing
+  GetPromotionEngine()->Deserialize(cursor, end);
+  auto rebalancer = GetRebalancer();
+  CheckSnapshotSize(cursor, end, 1);
+  CheckSnapshotField("rebalancer", *cursor++, rebalancer != nullptr);
+  if(rebalancer != nullptr){
+    rebalancer->Deserialize(cursor, end);
+  }
+
+  // Flash layout and NVM wear
+  auto ftl = GetFlashTranslationLayer();
+  CheckSnapshotSize(cursor, end, 1);
+  CheckSnapshotField("ftl", *cursor++, ftl != nullptr);
+  if(ftl != nullptr){
+    CheckSnapshotSize(cursor, end, 2);
+    CheckSnapshotField("ftl_pages_per_block", *cursor++,
+                       state.ftl_pages_per_block);
+    CheckSnapshotField("ftl_overprovisioning", *cursor++,
+                       GetSnapshotWord(state.ftl_overprovisioning));
+    ftl->Deserialize(cursor, end);
+  }
+  GetNVMWear().Deserialize(cursor, end);
+
+  if(cursor != end){
+    std::cout << "Corrupt snapshot : " << file_name << "\n";
+    exit(EXIT_FAILURE);
+  }
+
+  munmap(mapping, file_size);
+
+  std::cout << "Loaded snapshot " << file_name << " at operation "
+      << operation_itr << "\n";
+
+  return operation_itr;
+}
+
+}  // End machine namespace
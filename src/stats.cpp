@@ -7,6 +7,27 @@
 
 namespace machine {
 
+const size_t latency_bucket_count = 512;
+
+static size_t GetLatencyBucket(const double& latency){
+  uint64_t value = (uint64_t) latency;
+  if(value < 8){
+    return value;
+  }
+  size_t log = 63 - __builtin_clzll(value);
+  size_t sub_bucket = (value >> (log - 3)) & 7;
+  return (log - 2) * 8 + sub_bucket;
+}
+
+static double GetBucketLatency(const size_t& bucket){
+  if(bucket < 8){
+    return bucket;
+  }
+  size_t log = bucket / 8 + 2;
+  size_t sub_bucket = bucket % 8;
+  return (double)((8 + sub_bucket) << (log - 3));
+}
+
 void Stats::Reset(){
   read_ops.clear();
   write_ops.clear();
@@ -20,6 +41,19 @@ void Stats::Reset(){
   write_ops[DeviceType::DEVICE_TYPE_DRAM] = 0;
   write_ops[DeviceType::DEVICE_TYPE_NVM] = 0;
   write_ops[DeviceType::DEVICE_TYPE_SSD] = 0;
+
+  latency_histogram.assign(latency_bucket_count, 0);
+  latency_count = 0;
+  latency_sum = 0;
+  latency_max = 0;
+
+  tier_access_count = 0;
+  tier_hit_count = 0;
+
+  flash_host_write_count = 0;
+  flash_relocated_page_count = 0;
+  flash_erased_block_count = 0;
+  flash_stall = 0;
 }
 
 void Stats::IncrementReadCount(DeviceType device_type){
@@ -30,6 +64,71 @@ void Stats::IncrementWriteCount(DeviceType device_type){
   write_ops[device_type]++;
 }
 
+void Stats::RecordLatency(const double& latency){
+  if(latency_histogram.empty()){
+    latency_histogram.assign(latency_bucket_count, 0);
+  }
+
+  latency_histogram[GetLatencyBucket(latency)]++;
+  latency_count++;
+  latency_sum += latency;
+  if(latency > latency_max){
+    latency_max = latency;
+  }
+}
+
+void Stats::RecordFlashWrite(const size_t& relocated_page_count,
+                             const size_t& erased_block_count,
+                             const double& stall){
+  flash_host_write_count++;
+  flash_relocated_page_count += relocated_page_count;
+  flash_erased_block_count += erased_block_count;
+  flash_stall += stall;
+}
+
+void Stats::RecordTierAccess(const bool& hit){
+  tier_access_count++;
+  if(hit == true){
+    tier_hit_count++;
+  }
+}
+
+size_t Stats::GetTierAccessCount() const {
+  return tier_access_count;
+}
+
+size_t Stats::GetTierHitCount() const {
+  return tier_hit_count;
+}
+
+size_t Stats::GetFlashHostWriteCount() const {
+  return flash_host_write_count;
+}
+
+size_t Stats::GetFlashRelocatedPageCount() const {
+  return flash_relocated_page_count;
+}
+
+size_t Stats::GetFlashErasedBlockCount() const {
+  return flash_erased_block_count;
+}
+
+double Stats::GetFlashStall() const {
+  return flash_stall;
+}
+
+double Stats::GetLatencyPercentile(const double& percentile) const {
+  size_t threshold = (size_t) (percentile * latency_count);
+  size_t count = 0;
+  for(size_t bucket = 0; bucket < latency_histogram.size(); bucket++){
+    count += latency_histogram[bucket];
+    if(count > threshold){
+      return GetBucketLatency(bucket);
+    }
+  }
+  return latency_max;
+}
+
 std::ostream& operator<< (std::ostream& os, const Stats& stats){
 
   os << "READ OPS: \n";
@@ -42,6 +141,34 @@ std::ostream& operator<< (std::ostream& os, const Stats& stats){
     os << std::setw(10) << DeviceTypeToString(entry.first) << " :: " << entry.second << "\n";
   }
 
+  if(stats.latency_count > 0){
+    os << "LATENCY (ns): \n";
+    os << std::setw(10) << "MEAN" << " :: " << stats.latency_sum / stats.latency_count << "\n";
+    os << std::setw(10) << "P50" << " :: " << stats.GetLatencyPercentile(0.50) << "\n";
+    os << std::setw(10) << "P95" << " :: " << stats.GetLatencyPercentile(0.95) << "\n";
+    os << std::setw(10) << "P99" << " :: " << stats.GetLatencyPercentile(0.99) << "\n";
+    os << std::setw(10) << "MAX" << " :: " << stats.latency_max << "\n";
+  }
+
+  if(stats.tier_access_count > 0){
+    os << "HIT RATE (above the last device): \n";
+    os << std::setw(10) << "HITS" << " :: " << stats.tier_hit_count
+        << " of " << stats.tier_access_count << " ("
+        << (100.0 * stats.tier_hit_count) / stats.tier_access_count << " %)\n";
+  }
+
+  if(stats.flash_host_write_count > 0){
+    auto flash_write_count = stats.flash_host_write_count +
+        stats.flash_relocated_page_count;
+    os << "SSD FLASH: \n";
+    os << std::setw(10) << "HOST" << " :: " << stats.flash_host_write_count << "\n";
+    os << std::setw(10) << "GC" << " :: " << stats.flash_relocated_page_count << "\n";
+    os << std::setw(10) << "ERASES" << " :: " << stats.flash_erased_block_count << "\n";
+    os << std::setw(10) << "WAF" << " :: "
+        << (double) flash_write_count / stats.flash_host_write_count << "\n";
+    os << std::setw(10) << "STALL" << " :: " << stats.flash_stall << "\n";
+  }
+
   return os;
 }
 
@@ -11,6 +11,8 @@ StorageCache::StorageCache(DeviceType device_type,
                                    caching_type_(caching_type),
                                    capacity_(capacity){
 
+  dirty_index = new DirtyIndex();
+
   switch(caching_type_){
 
     case CACHING_TYPE_FIFO:
@@ -29,6 +31,30 @@ StorageCache::StorageCache(DeviceType device_type,
       arc_cache = new Cache<int, int, ARCCachePolicy<int>>(capacity);
       break;
 
+    case CACHING_TYPE_CLOCK:
+      clock_cache = new Cache<int, int, CLOCKCachePolicy<int>>(capacity);
+      break;
+
+    case CACHING_TYPE_CLOCK_PRO:
+      clock_pro_cache = new Cache<int, int, CLOCKProCachePolicy<int>>(capacity);
+      break;
+
+    case CACHING_TYPE_WTINYLFU:
+      wtinylfu_cache = new Cache<int, int, WTinyLFUCachePolicy<int>>(capacity);
+      break;
+
+    case CACHING_TYPE_LIRS:
+      lirs_cache = new Cache<int, int, LIRSCachePolicy<int>>(capacity);
+      break;
+
+    case CACHING_TYPE_2Q:
+      two_q_cache = new Cache<int, int, TwoQCachePolicy<int>>(capacity);
+      break;
+
+    case CACHING_TYPE_GREEDY_DUAL:
+      greedy_dual_cache = new Cache<int, int, GreedyDualCachePolicy<int>>(capacity);
+      break;
+
     case CACHING_TYPE_INVALID:
     default:
       exit(EXIT_FAILURE);
@@ -58,12 +84,45 @@ Block StorageCache::Put(const int& key, const int& value){
       victim = arc_cache->Put(key, value);
       break;
 
+    case CACHING_TYPE_CLOCK:
+      victim = clock_cache->Put(key, value);
+      break;
+
+    case CACHING_TYPE_CLOCK_PRO:
+      victim = clock_pro_cache->Put(key, value);
+      break;
+
+    case CACHING_TYPE_WTINYLFU:
+      victim = wtinylfu_cache->Put(key, value);
+      break;
+
+    case CACHING_TYPE_LIRS:
+      victim = lirs_cache->Put(key, value);
+      break;
+
+    case CACHING_TYPE_2Q:
+      victim = two_q_cache->Put(key, value);
+      break;
+
+    case CACHING_TYPE_GREEDY_DUAL:
+      victim = greedy_dual_cache->Put(key, value);
+      break;
+
     case CACHING_TYPE_INVALID:
     default:
       exit(EXIT_FAILURE);
   }
 
+  // Keep the dirty index in step
+  if(value == DIRTY_BLOCK){
+    dirty_index->Set(key);
+  }
+  else {
+    dirty_index->Clear(key);
+  }
+
   if(victim.block_id != INVALID_KEY){
+    dirty_index->Clear(victim.block_id);
     if(victim.block_type != CLEAN_BLOCK &&
         victim.block_type != DIRTY_BLOCK ){
       LOG(INFO) << "Invalid block type : " << victim.block_type;
@@ -93,6 +152,24 @@ const int& StorageCache::Get(const int& key, bool touch) const{
     case CACHING_TYPE_ARC:
       return arc_cache->Get(key, touch);
 
+    case CACHING_TYPE_CLOCK:
+      return clock_cache->Get(key, touch);
+
+    case CACHING_TYPE_CLOCK_PRO:
+      return clock_pro_cache->Get(key, touch);
+
+    case CACHING_TYPE_WTINYLFU:
+      return wtinylfu_cache->Get(key, touch);
+
+    case CACHING_TYPE_LIRS:
+      return lirs_cache->Get(key, touch);
+
+    case CACHING_TYPE_2Q:
+      return two_q_cache->Get(key, touch);
+
+    case CACHING_TYPE_GREEDY_DUAL:
+      return greedy_dual_cache->Get(key, touch);
+
     case CACHING_TYPE_INVALID:
     default:
       exit(EXIT_FAILURE);
@@ -102,6 +179,8 @@ const int& StorageCache::Get(const int& key, bool touch) const{
 
 void StorageCache::Erase(const int& key) {
 
+  dirty_index->Clear(key);
+
   switch(caching_type_){
 
     case CACHING_TYPE_FIFO:
@@ -120,6 +199,30 @@ void StorageCache::Erase(const int& key) {
       arc_cache->Erase(key);
       break;
 
+    case CACHING_TYPE_CLOCK:
+      clock_cache->Erase(key);
+      break;
+
+    case CACHING_TYPE_CLOCK_PRO:
+      clock_pro_cache->Erase(key);
+      break;
+
+    case CACHING_TYPE_WTINYLFU:
+      wtinylfu_cache->Erase(key);
+      break;
+
+    case CACHING_TYPE_LIRS:
+      lirs_cache->Erase(key);
+      break;
+
+    case CACHING_TYPE_2Q:
+      two_q_cache->Erase(key);
+      break;
+
+    case CACHING_TYPE_GREEDY_DUAL:
+      greedy_dual_cache->Erase(key);
+      break;
+
     case CACHING_TYPE_INVALID:
     default:
       exit(EXIT_FAILURE);
@@ -143,6 +246,24 @@ size_t StorageCache::CurrentCapacity() const{
     case CACHING_TYPE_ARC:
       return arc_cache->CurrentCapacity();
 
+    case CACHING_TYPE_CLOCK:
+      return clock_cache->CurrentCapacity();
+
+    case CACHING_TYPE_CLOCK_PRO:
+      return clock_pro_cache->CurrentCapacity();
+
+    case CACHING_TYPE_WTINYLFU:
+      return wtinylfu_cache->CurrentCapacity();
+
+    case CACHING_TYPE_LIRS:
+      return lirs_cache->CurrentCapacity();
+
+    case CACHING_TYPE_2Q:
+      return two_q_cache->CurrentCapacity();
+
+    case CACHING_TYPE_GREEDY_DUAL:
+      return greedy_dual_cache->CurrentCapacity();
+
     case CACHING_TYPE_INVALID:
     default:
       exit(EXIT_FAILURE);
@@ -150,6 +271,65 @@ size_t StorageCache::CurrentCapacity() const{
 
 }
 
+void StorageCache::GetKeys(std::vector<int>& keys) const{
+
+  switch(caching_type_){
+
+    case CACHING_TYPE_FIFO:
+      fifo_cache->GetKeys(keys);
+      break;
+
+    case CACHING_TYPE_LRU:
+      lru_cache->GetKeys(keys);
+      break;
+
+    case CACHING_TYPE_LFU:
+      lfu_cache->GetKeys(keys);
+      break;
+
+    case CACHING_TYPE_ARC:
+      arc_cache->GetKeys(keys);
+      break;
+
+    case CACHING_TYPE_CLOCK:
+      clock_cache->GetKeys(keys);
+      break;
+
+    case CACHING_TYPE_CLOCK_PRO:
+      clock_pro_cache->GetKeys(keys);
+      break;
+
+    case CACHING_TYPE_WTINYLFU:
+      wtinylfu_cache->GetKeys(keys);
+      break;
+
+    case CACHING_TYPE_LIRS:
+      lirs_cache->GetKeys(keys);
+      break;
+
+    case CACHING_TYPE_2Q:
+      two_q_cache->GetKeys(keys);
+      break;
+
+    case CACHING_TYPE_GREEDY_DUAL:
+      greedy_dual_cache->GetKeys(keys);
+      break;
+
+    case CACHING_TYPE_INVALID:
+    default:
+      exit(EXIT_FAILURE);
+  }
+
+}
+
+void StorageCache::GetDirtyBlocks(std::vector<size_t>& blocks) const{
+  dirty_index->GetBlocks(blocks);
+}
+
+size_t StorageCache::GetDirtyCount() const{
+  return dirty_index->GetCount();
+}
+
 std::ostream& operator<< (std::ostream& stream,
                           const StorageCache& cache){
 
@@ -183,6 +363,30 @@ std::ostream& operator<< (std::ostream& stream,
       cache.arc_cache->Print();
       return stream;
 
+    case CACHING_TYPE_CLOCK:
+      cache.clock_cache->Print();
+      return stream;
+
+    case CACHING_TYPE_CLOCK_PRO:
+      cache.clock_pro_cache->Print();
+      return stream;
+
+    case CACHING_TYPE_WTINYLFU:
+      cache.wtinylfu_cache->Print();
+      return stream;
+
+    case CACHING_TYPE_LIRS:
+      cache.lirs_cache->Print();
+      return stream;
+
+    case CACHING_TYPE_2Q:
+      cache.two_q_cache->Print();
+      return stream;
+
+    case CACHING_TYPE_GREEDY_DUAL:
+      cache.greedy_dual_cache->Print();
+      return stream;
+
     case CACHING_TYPE_INVALID:
     default:
       exit(EXIT_FAILURE);
@@ -206,6 +410,24 @@ bool StorageCache::IsSequential(const size_t& next){
     case CACHING_TYPE_ARC:
       return arc_cache->IsSequential(next);
 
+    case CACHING_TYPE_CLOCK:
+      return clock_cache->IsSequential(next);
+
+    case CACHING_TYPE_CLOCK_PRO:
+      return clock_pro_cache->IsSequential(next);
+
+    case CACHING_TYPE_WTINYLFU:
+      return wtinylfu_cache->IsSequential(next);
+
+    case CACHING_TYPE_LIRS:
+      return lirs_cache->IsSequential(next);
+
+    case CACHING_TYPE_2Q:
+      return two_q_cache->IsSequential(next);
+
+    case CACHING_TYPE_GREEDY_DUAL:
+      return greedy_dual_cache->IsSequential(next);
+
     case CACHING_TYPE_INVALID:
     default:
       exit(EXIT_FAILURE);
@@ -213,5 +435,169 @@ bool StorageCache::IsSequential(const size_t& next){
 
 }
 
-}  // End machine namespace
+void StorageCache::SetEvictionCost(const uint64_t& clean_cost,
+                                   const uint64_t& dirty_cost){
+
+  switch(caching_type_){
+
+    case CACHING_TYPE_FIFO:
+      fifo_cache->SetEvictionCost(clean_cost, dirty_cost);
+      break;
+
+    case CACHING_TYPE_LRU:
+      lru_cache->SetEvictionCost(clean_cost, dirty_cost);
+      break;
+
+    case CACHING_TYPE_LFU:
+      lfu_cache->SetEvictionCost(clean_cost, dirty_cost);
+      break;
+
+    case CACHING_TYPE_ARC:
+      arc_cache->SetEvictionCost(clean_cost, dirty_cost);
+      break;
+
+    case CACHING_TYPE_CLOCK:
+      clock_cache->SetEvictionCost(clean_cost, dirty_cost);
+      break;
+
+    case CACHING_TYPE_CLOCK_PRO:
+      clock_pro_cache->SetEvictionCost(clean_cost, dirty_cost);
+      break;
+
+    case CACHING_TYPE_WTINYLFU:
+      wtinylfu_cache->SetEvictionCost(clean_cost, dirty_cost);
+      break;
+
+    case CACHING_TYPE_LIRS:
+      lirs_cache->SetEvictionCost(clean_cost, dirty_cost);
+      break;
+
+    case CACHING_TYPE_2Q:
+      two_q_cache->SetEvictionCost(clean_cost, dirty_cost);
+      break;
+
+    case CACHING_TYPE_GREEDY_DUAL:
+      greedy_dual_cache->SetEvictionCost(clean_cost, dirty_cost);
+      break;
+
+    case CACHING_TYPE_INVALID:
+    default:
+      exit(EXIT_FAILURE);
+  }
+
+}
+
+void StorageCache::Serialize(std::vector<uint64_t>& buffer) const{
+
+  switch(caching_type_){
+
+    case CACHING_TYPE_FIFO:
+      fifo_cache->Serialize(buffer);
+      break;
+
+    case CACHING_TYPE_LRU:
+      lru_cache->Serialize(buffer);
+      break;
+
+    case CACHING_TYPE_LFU:
+      lfu_cache->Serialize(buffer);
+      break;
+
+    case CACHING_TYPE_ARC:
+      arc_cache->Serialize(buffer);
+      break;
+
+    case CACHING_TYPE_CLOCK:
+      clock_cache->Serialize(buffer);
+      break;
+
+    case CACHING_TYPE_CLOCK_PRO:
+      clock_pro_cache->Serialize(buffer);
+      break;
+
+    case CACHING_TYPE_WTINYLFU:
+      wtinylfu_cache->Serialize(buffer);
+      break;
+
+    case CACHING_TYPE_LIRS:
+      lirs_cache->Serialize(buffer);
+      break;
+
+    case CACHING_TYPE_2Q:
+      two_q_cache->Serialize(buffer);
+      break;
+
+    case CACHING_TYPE_GREEDY_DUAL:
+      greedy_dual_cache->Serialize(buffer);
+      break;
+
+    case CACHING_TYPE_INVALID:
+    default:
+      exit(EXIT_FAILURE);
+  }
+
+}
+
+void StorageCache::Deserialize(const uint64_t*& cursor,
+                               const uint64_t* end){
+
+  switch(caching_type_){
+
+    case CACHING_TYPE_FIFO:
+      fifo_cache->Deserialize(cursor, end);
+      break;
+
+    case CACHING_TYPE_LRU:
+      lru_cache->Deserialize(cursor, end);
+      break;
+
+    case CACHING_TYPE_LFU:
+      lfu_cache->Deserialize(cursor, end);
+      break;
+
+    case CACHING_TYPE_ARC:
+      arc_cache->Deserialize(cursor, end);
+      break;
+
+    case CACHING_TYPE_CLOCK:
+      clock_cache->Deserialize(cursor, end);
+      break;
+
+    case CACHING_TYPE_CLOCK_PRO:
+      clock_pro_cache->Deserialize(cursor, end);
+      break;
+
+    case CACHING_TYPE_WTINYLFU:
+      wtinylfu_cache->Deserialize(cursor, end);
+      break;
+
+    case CACHING_TYPE_LIRS:
+      lirs_cache->Deserialize(cursor, end);
+      break;
+
+    case CACHING_TYPE_2Q:
+      two_q_cache->Deserialize(cursor, end);
+      break;
 
+    case CACHING_TYPE_GREEDY_DUAL:
+      greedy_dual_cache->Deserialize(cursor, end);
+      break;
+
+    case CACHING_TYPE_INVALID:
+    default:
+      exit(EXIT_FAILURE);
+  }
+
+  // Rebuild the dirty index from the restored blocks
+  dirty_index->Reset();
+  std::vector<int> keys;
+  GetKeys(keys);
+  for(auto key : keys){
+    if(Get(key, false) == DIRTY_BLOCK){
+      dirty_index->Set(key);
+    }
+  }
+
+}
+
+}  // End machine namespace
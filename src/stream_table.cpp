@@ -0,0 +1,105 @@
+// STREAM TABLE SOURCE
+
+#include "stream_table.h"
+#include "snapshot.h"
+
+namespace machine {
+
+size_t stream_table_size = 8;
+
+StreamTable::StreamTable(const size_t& stream_count,
+                         const bool& forward_only)
+: forward_only_(forward_only),
+  last_block_(stream_count, 0),
+  sequential_(stream_count, false),
+  last_access_(stream_count, 0),
+  access_clock_(0) {
+  // Nothing to do here!
+}
+
+size_t StreamTable::Access(const size_t& block_id, bool& sequential){
+
+  access_clock_++;
+  sequential = false;
+
+  // Most recently used stream the block continues or repeats
+  size_t stream_slot = 0;
+  size_t victim_slot = 0;
+  bool found = false;
+  bool repeat = false;
+  for(size_t slot = 0; slot < last_block_.size(); slot++){
+    auto last_block = last_block_[slot];
+    bool next = (block_id == last_block + 1);
+    bool previous = (forward_only_ == false && block_id + 1 == last_block);
+
+    // Same block again (e.g. read then write)
+    bool same = (block_id == last_block);
+
+    if(last_access_[slot] != 0 && (next || previous || same)){
+      if(found == false ||
+          last_access_[slot] > last_access_[stream_slot]){
+        stream_slot = slot;
+        repeat = same;
+      }
+      found = true;
+    }
+
+    if(last_access_[slot] < last_access_[victim_slot]){
+      victim_slot = slot;
+    }
+  }
+
+  if(repeat == true){
+    sequential = sequential_[stream_slot];
+    last_access_[stream_slot] = access_clock_;
+    return stream_slot;
+  }
+
+  // Replace the least recently used stream
+  sequential = found;
+  if(sequential == false){
+    stream_slot = victim_slot;
+  }
+
+  last_block_[stream_slot] = block_id;
+  sequential_[stream_slot] = sequential;
+  last_access_[stream_slot] = access_clock_;
+  return stream_slot;
+}
+
+size_t StreamTable::GetStreamCount() const {
+  return last_block_.size();
+}
+
+void StreamTable::Serialize(std::vector<uint64_t>& buffer) const {
+
+  buffer.push_back(access_clock_);
+  buffer.push_back(last_block_.size());
+  for(size_t slot = 0; slot < last_block_.size(); slot++){
+    buffer.push_back(last_block_[slot]);
+    buffer.push_back(sequential_[slot]);
+    buffer.push_back(last_access_[slot]);
+  }
+
+}
+
+void StreamTable::Deserialize(const uint64_t*& cursor,
+                              const uint64_t* end){
+
+  CheckSnapshotSize(cursor, end, 2);
+  access_clock_ = *cursor++;
+  auto stream_count = *cursor++;
+  CheckSnapshotSize(cursor, end, stream_count, 3);
+
+  last_block_.assign(stream_count, 0);
+  sequential_.assign(stream_count, false);
+  last_access_.assign(stream_count, 0);
+  for(size_t slot = 0; slot < stream_count; slot++){
+    last_block_[slot] = *cursor++;
+    sequential_[slot] = (*cursor++ != 0);
+    last_access_[slot] = *cursor++;
+  }
+
+}
+
+}  // End machine namespace
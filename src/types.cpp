@@ -1,9 +1,18 @@
 // TYPES SOURCE
 
+#include <map>
+
 #include "types.h"
 
 namespace machine {
 
+// Names of the device types declared by a topology file
+static std::map<int, std::string> device_type_names;
+
+void SetDeviceTypeName(const DeviceType& device_type, const std::string& name){
+  device_type_names[device_type] = name;
+}
+
 std::string CachingTypeToString(const CachingType& caching_type){
 
   switch (caching_type){
@@ -15,6 +24,18 @@ std::string CachingTypeToString(const CachingType& caching_type){
       return "LFU";
     case CACHING_TYPE_ARC:
       return "ARC";
+    case CACHING_TYPE_CLOCK:
+      return "CLOCK";
+    case CACHING_TYPE_CLOCK_PRO:
+      return "CLOCK-PRO";
+    case CACHING_TYPE_WTINYLFU:
+      return "W-TINYLFU";
+    case CACHING_TYPE_LIRS:
+      return "LIRS";
+    case CACHING_TYPE_2Q:
+      return "2Q";
+    case CACHING_TYPE_GREEDY_DUAL:
+      return "GREEDY-DUAL";
     default:
       return "INVALID";
   }
@@ -32,6 +53,41 @@ std::string DeviceTypeToString(const DeviceType& device_type){
       return "NVM";
     case DEVICE_TYPE_SSD:
       return "SSD";
+    default: {
+      auto name_itr = device_type_names.find(device_type);
+      if(name_itr != device_type_names.end()){
+        return name_itr->second;
+      }
+      return "INVALID";
+    }
+  }
+
+}
+
+std::string DistributionTypeToString(const DistributionType& distribution_type){
+
+  switch (distribution_type){
+    case DISTRIBUTION_TYPE_ZIPF:
+      return "ZIPF";
+    case DISTRIBUTION_TYPE_SCRAMBLED_ZIPF:
+      return "SCRAMBLED-ZIPF";
+    case DISTRIBUTION_TYPE_HOTSPOT:
+      return "HOTSPOT";
+    case DISTRIBUTION_TYPE_LATEST:
+      return "LATEST";
+    default:
+      return "INVALID";
+  }
+
+}
+
+std::string InclusionTypeToString(const InclusionType& inclusion_type){
+
+  switch (inclusion_type){
+    case INCLUSION_TYPE_INCLUSIVE:
+      return "INCLUSIVE";
+    case INCLUSION_TYPE_EXCLUSIVE:
+      return "EXCLUSIVE";
     default:
       return "INVALID";
   }
@@ -49,6 +105,8 @@ std::string HierarchyTypeToString(const HierarchyType& hierarchy_type){
       return "CACHE-DRAM-SSD";
     case HIERARCHY_TYPE_DRAM_NVM_SSD:
       return "CACHE-DRAM-NVM-SSD";
+    case HIERARCHY_TYPE_TOPOLOGY:
+      return "TOPOLOGY";
     default:
       return "INVALID";
   }
@@ -0,0 +1,128 @@
+// WAL SOURCE
+
+#include <algorithm>
+#include <iomanip>
+
+#include "wal.h"
+
+namespace machine {
+
+// Log page written by a flush (bytes)
+const size_t log_page_size = 4096;
+
+// Pages written to make the log durable between the two offsets. The
+// partially filled tail page is written again by the next flush.
+static size_t GetPageCount(const size_t& start_offset,
+                           const size_t& end_offset){
+  if(end_offset <= start_offset){
+    return 0;
+  }
+  return (end_offset - 1)/log_page_size - start_offset/log_page_size + 1;
+}
+
+WriteAheadLog::WriteAheadLog(const DeviceType& device_type,
+                             const double& page_write_latency,
+                             const double& commit_interval,
+                             const size_t& record_size)
+: device_type_(device_type),
+  page_write_latency_(page_write_latency),
+  commit_interval_(commit_interval),
+  record_size_(record_size),
+  tail_offset_(0),
+  scheduled_offset_(0),
+  group_start_offset_(0),
+  group_issue_time_(0),
+  group_completion_time_(0) {
+  // Nothing to do here!
+}
+
+double WriteAheadLog::GetFlushLatency(const size_t& start_offset,
+                                      const size_t& end_offset) const {
+  return GetPageCount(start_offset, end_offset) * page_write_latency_;
+}
+
+void WriteAheadLog::Append(){
+  tail_offset_ += record_size_;
+  append_count_++;
+}
+
+double WriteAheadLog::Commit(const double& now){
+
+  commit_count_++;
+
+  // Nothing new to flush: wait for the flush that covers the records
+  if(tail_offset_ == scheduled_offset_){
+    return std::max(now, group_completion_time_);
+  }
+
+  // Join the pending group before its flush is issued
+  auto group_pending = (scheduled_offset_ > group_start_offset_ &&
+      now < group_issue_time_);
+  if(group_pending == true){
+    page_count_ -= GetPageCount(group_start_offset_, scheduled_offset_);
+  }
+  // Open a new group behind the previous flush
+  else {
+    group_start_offset_ = scheduled_offset_;
+    group_issue_time_ = std::max(now + commit_interval_,
+                                 group_completion_time_);
+    flush_count_++;
+  }
+
+  scheduled_offset_ = tail_offset_;
+  page_count_ += GetPageCount(group_start_offset_, scheduled_offset_);
+  group_completion_time_ = group_issue_time_ +
+      GetFlushLatency(group_start_offset_, scheduled_offset_);
+
+  return group_completion_time_;
+}
+
+void WriteAheadLog::RecordCommitWait(const double& wait){
+  commit_wait_time_ += wait;
+  max_commit_wait_time_ = std::max(max_commit_wait_time_, wait);
+}
+
+DeviceType WriteAheadLog::GetDeviceType() const {
+  return device_type_;
+}
+
+void WriteAheadLog::ResetStats(){
+  append_count_ = 0;
+  commit_count_ = 0;
+  flush_count_ = 0;
+  page_count_ = 0;
+  commit_wait_time_ = 0;
+  max_commit_wait_time_ = 0;
+}
+
+std::ostream& operator<< (std::ostream& os,
+                          const WriteAheadLog& write_ahead_log){
+
+  double mean_group_size = 0;
+  double mean_commit_wait = 0;
+  if(write_ahead_log.flush_count_ > 0){
+    mean_group_size = (double) write_ahead_log.commit_count_ /
+        write_ahead_log.flush_count_;
+  }
+  if(write_ahead_log.commit_count_ > 0){
+    mean_commit_wait = write_ahead_log.commit_wait_time_ /
+        write_ahead_log.commit_count_;
+  }
+
+  os << "LOG (" << DeviceTypeToString(write_ahead_log.device_type_) << "): \n";
+  os << std::setw(10) << "APPENDS" << " :: "
+      << write_ahead_log.append_count_ << "\n";
+  os << std::setw(10) << "COMMITS" << " :: "
+      << write_ahead_log.commit_count_ << "\n";
+  os << std::setw(10) << "FLUSHES" << " :: "
+      << write_ahead_log.flush_count_ << " "
+      << write_ahead_log.page_count_ << " pages "
+      << mean_group_size << " commits/flush\n";
+  os << std::setw(10) << "WAIT" << " :: "
+      << mean_commit_wait << " mean "
+      << write_ahead_log.max_commit_wait_time_ << " max (ns)\n";
+
+  return os;
+}
+
+}  // End machine namespace
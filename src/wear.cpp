@@ -0,0 +1,157 @@
+// WEAR SOURCE
+
+#include <algorithm>
+#include <functional>
+#include <iomanip>
+#include <limits>
+#include <vector>
+
+#include "wear.h"
+#include "snapshot.h"
+
+namespace machine {
+
+const double seconds_per_year = 365.0 * 24 * 60 * 60;
+
+// Years until writes at this rate use up the endurance
+static double GetLifetime(const double& endurance,
+                          const double& duration,
+                          const double& write_count){
+  if(write_count == 0 || duration == 0){
+    return std::numeric_limits<double>::infinity();
+  }
+  auto writes_per_second = write_count / (duration / 1e9);
+  return endurance / writes_per_second / seconds_per_year;
+}
+
+void WearTracker::RecordWrite(const size_t& block_id){
+  block_write_count_[block_id]++;
+  region_write_count_[block_id / wear_region_block_count]++;
+  write_count_++;
+}
+
+size_t WearTracker::GetBlockWriteCount(const size_t& block_id) const {
+  auto block_itr = block_write_count_.find(block_id);
+  if(block_itr == block_write_count_.end()){
+    return 0;
+  }
+  return block_itr->second;
+}
+
+size_t WearTracker::GetWriteCount() const {
+  return write_count_;
+}
+
+void WearTracker::Reset(){
+  block_write_count_.clear();
+  region_write_count_.clear();
+  write_count_ = 0;
+}
+
+void WearTracker::Serialize(std::vector<uint64_t>& buffer) const {
+  buffer.push_back(block_write_count_.size());
+  for(auto& entry : block_write_count_){
+    buffer.push_back(entry.first);
+    buffer.push_back(entry.second);
+  }
+}
+
+void WearTracker::Deserialize(const uint64_t*& cursor,
+                              const uint64_t* end){
+  Reset();
+  CheckSnapshotSize(cursor, end, 1);
+  auto block_count = *cursor++;
+  CheckSnapshotSize(cursor, end, block_count, 2);
+  block_write_count_.reserve(block_count);
+  for(size_t block_itr = 0; block_itr < block_count; block_itr++){
+    auto block_id = *cursor++;
+    auto write_count = *cursor++;
+    block_write_count_[block_id] = write_count;
+    region_write_count_[block_id / wear_region_block_count] += write_count;
+    write_count_ += write_count;
+  }
+}
+
+size_t WearTracker::GetMaxBlockWriteCount() const {
+  size_t max_write_count = 0;
+  for(auto& entry : block_write_count_){
+    max_write_count = std::max(max_write_count, entry.second);
+  }
+  return max_write_count;
+}
+
+size_t WearTracker::GetMaxRegionWriteCount() const {
+  size_t max_write_count = 0;
+  for(auto& entry : region_write_count_){
+    max_write_count = std::max(max_write_count, entry.second);
+  }
+  return max_write_count;
+}
+
+double WearTracker::GetBlockLifetime(const double& endurance,
+                                     const double& duration) const {
+  return GetLifetime(endurance, duration, GetMaxBlockWriteCount());
+}
+
+double WearTracker::GetRegionLifetime(const double& endurance,
+                                      const double& duration) const {
+  return GetLifetime(endurance * wear_region_block_count,
+                     duration,
+                     GetMaxRegionWriteCount());
+}
+
+double WearTracker::GetLeveledLifetime(const double& endurance,
+                                       const double& duration,
+                                       const size_t& capacity) const {
+  return GetLifetime(endurance * capacity, duration, write_count_);
+}
+
+std::ostream& operator<< (std::ostream& os, const WearTracker& wear_tracker){
+
+  // Blocks by write count (powers of two) and the hottest blocks' share
+  std::vector<size_t> histogram;
+  std::vector<size_t> write_counts;
+  write_counts.reserve(wear_tracker.block_write_count_.size());
+  for(auto& entry : wear_tracker.block_write_count_){
+    size_t bucket = 63 - __builtin_clzll(entry.second);
+    if(bucket >= histogram.size()){
+      histogram.resize(bucket + 1, 0);
+    }
+    histogram[bucket]++;
+    write_counts.push_back(entry.second);
+  }
+
+  auto hot_block_count = (write_counts.size() + 99) / 100;
+  std::partial_sort(write_counts.begin(),
+                    write_counts.begin() + hot_block_count,
+                    write_counts.end(),
+                    std::greater<size_t>());
+  size_t hot_write_count = 0;
+  for(size_t block_itr = 0; block_itr < hot_block_count; block_itr++){
+    hot_write_count += write_counts[block_itr];
+  }
+
+  os << "NVM WEAR: \n";
+  os << std::setw(10) << "WRITES" << " :: " << wear_tracker.write_count_ << "\n";
+  os << std::setw(10) << "BLOCKS" << " :: " << write_counts.size() << "\n";
+  os << std::setw(10) << "MAX BLOCK" << " :: "
+      << wear_tracker.GetMaxBlockWriteCount() << "\n";
+  os << std::setw(10) << "MAX REGION" << " :: "
+      << wear_tracker.GetMaxRegionWriteCount() << "\n";
+  if(wear_tracker.write_count_ > 0){
+    os << std::setw(10) << "TOP 1%" << " :: "
+        << (100.0 * hot_write_count) / wear_tracker.write_count_
+        << "% of writes\n";
+  }
+  os << "BLOCKS BY WRITE COUNT: \n";
+  for(size_t bucket = 0; bucket < histogram.size(); bucket++){
+    if(histogram[bucket] == 0){
+      continue;
+    }
+    os << std::setw(10) << (1UL << bucket) << "+ :: " << histogram[bucket] << "\n";
+  }
+
+  return os;
+}
+
+}  // End machine namespace
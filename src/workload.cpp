@@ -11,10 +11,21 @@
 #include "macros.h"
 #include "workload.h"
 #include "distribution.h"
+#include "generator.h"
+#include "snapshot.h"
+#include "event_engine.h"
 #include "configuration.h"
 #include "device.h"
 #include "cache.h"
 #include "stats.h"
+#include "wear.h"
+#include "readahead.h"
+#include "promotion.h"
+#include "rebalancer.h"
+#include "migration.h"
+#include "flusher.h"
+#include "checkpoint.h"
+#include "wal.h"
 
 namespace machine {
 
@@ -28,6 +39,85 @@ double total_duration = 0;
 // Stats
 extern Stats machine_stats;
 
+// Sequential prefetcher (off unless a readahead window is set)
+std::unique_ptr<ReadaheadEngine> readahead;
+
+// Hotness-driven promotion between tiers
+std::unique_ptr<PromotionEngine> promotion;
+
+// Epoch-based bulk rebalancing between DRAM and NVM (off by default)
+std::unique_ptr<EpochRebalancer> rebalancer;
+
+// Watermark-driven write-back of dirty blocks (off by default)
+std::unique_ptr<DirtyFlusher> flusher;
+
+// Checkpoint durations and their foreground impact
+std::unique_ptr<CheckpointTracker> checkpointer(new CheckpointTracker());
+
+// Write-ahead log (off unless a log device is set)
+std::unique_ptr<WriteAheadLog> write_ahead_log;
+
+void ResetPromotionEngine(){
+
+  // Promote on the migration_frequency-th access unless set per tier
+  std::map<DeviceType, size_t> thresholds;
+  thresholds[DeviceType::DEVICE_TYPE_DRAM] = state.migration_frequency;
+  thresholds[DeviceType::DEVICE_TYPE_CACHE] = state.migration_frequency;
+  if(state.dram_promotion_threshold > 0){
+    thresholds[DeviceType::DEVICE_TYPE_DRAM] = state.dram_promotion_threshold;
+  }
+  if(state.cache_promotion_threshold > 0){
+    thresholds[DeviceType::DEVICE_TYPE_CACHE] = state.cache_promotion_threshold;
+  }
+
+  promotion.reset(new PromotionEngine(state.promotion_window,
+                                      thresholds,
+                                      generator_seed));
+}
+
+void ResetWorkloadEngines(){
+
+  readahead.reset();
+  if(state.readahead_window > 0){
+    readahead.reset(new ReadaheadEngine(state.readahead_window));
+  }
+
+  ResetPromotionEngine();
+
+  flusher.reset();
+  if(state.flush_high_watermark > 0){
+    flusher.reset(new DirtyFlusher(state.flush_interval,
+                                   state.flush_high_watermark,
+                                   state.flush_low_watermark));
+  }
+
+  checkpointer.reset(new CheckpointTracker());
+
+  write_ahead_log.reset();
+  if(state.log_device_type != DEVICE_TYPE_INVALID){
+    auto page_write_latency = GetSequentialWriteLatency(state.log_device_type);
+    write_ahead_log.reset(new WriteAheadLog(state.log_device_type,
+                                            page_write_latency,
+                                            state.log_commit_interval,
+                                            state.log_record_size));
+  }
+
+  rebalancer.reset();
+  if(state.rebalance_epoch > 0){
+    rebalancer.reset(new EpochRebalancer(state.rebalance_epoch,
+                                         state.rebalance_budget));
+  }
+
+}
+
+PromotionEngine* GetPromotionEngine(){
+  return promotion.get();
+}
+
+EpochRebalancer* GetRebalancer(){
+  return rebalancer.get();
+}
+
 static void WriteOutput(double stat) {
 
   // Write out output in verbose mode
@@ -53,6 +143,30 @@ size_t GetMachineSize(){
   return machine_size;
 }
 
+// Blocks held above the last device, counting each block once
+void PrintCapacity(){
+
+  size_t total_block_count = 0;
+  size_t resident_block_count = 0;
+  std::set<int> unique_blocks;
+  for(size_t device_itr = 0; device_itr + 1 < state.devices.size(); device_itr++){
+    std::vector<int> keys;
+    state.devices[device_itr].cache.GetKeys(keys);
+    total_block_count += state.devices[device_itr].device_size;
+    resident_block_count += keys.size();
+    unique_blocks.insert(keys.begin(), keys.end());
+  }
+
+  std::cout << "CAPACITY (" << InclusionTypeToString(state.inclusion_type)
+      << ", blocks above the last device): \n";
+  std::cout << std::setw(10) << "TOTAL" << " :: " << total_block_count << "\n";
+  std::cout << std::setw(10) << "RESIDENT" << " :: "
+      << resident_block_count << "\n";
+  std::cout << std::setw(10) << "UNIQUE" << " :: " << unique_blocks.size()
+      << "\n";
+
+}
+
 void PrintMachine(){
 
   std::cout << "\n+++++++++++++++++++++++++++++++++++++++++++++++++++++\n";
@@ -64,6 +178,40 @@ void PrintMachine(){
 
   std::cout << machine_stats;
 
+  PrintCapacity();
+
+  if(GetNVMWear().GetWriteCount() > 0){
+    std::cout << GetNVMWear();
+  }
+
+  if(readahead != nullptr){
+    std::cout << *readahead;
+  }
+
+  if(promotion != nullptr){
+    std::cout << *promotion;
+  }
+
+  if(rebalancer != nullptr){
+    std::cout << *rebalancer;
+  }
+
+  if(GetMigrationQueue() != nullptr){
+    std::cout << *GetMigrationQueue();
+  }
+
+  if(flusher != nullptr){
+    std::cout << *flusher;
+  }
+
+  if(checkpointer->GetCheckpointCount() > 0){
+    std::cout << *checkpointer;
+  }
+
+  if(write_ahead_log != nullptr){
+    std::cout << *write_ahead_log;
+  }
+
 }
 
 DeviceType LocateInMemoryDevices(const size_t& block_id){
@@ -75,69 +223,221 @@ DeviceType LocateInStorageDevices(const size_t& block_id){
 }
 
 bool IsVolatileDevice(DeviceType device_type){
-  return (device_type == DeviceType::DEVICE_TYPE_CACHE ||
-      device_type == DeviceType::DEVICE_TYPE_DRAM);
+  return IsVolatileTier(device_type);
+}
+
+bool IsFastDevice(DeviceType device_type){
+  return IsVolatileTier(device_type);
+}
+
+// Lowest tier that serves reads in place
+DeviceType GetLowestMemoryDevice(){
+  return state.memory_devices.back().device_type;
+}
+
+// Pull a block one tier up in the background
+void PrefetchBlock(const size_t& block_id){
+
+  auto memory_device_type = LocateInMemoryDevices(block_id);
+  auto top_device_type = state.devices.front().device_type;
+  auto source = DeviceType::DEVICE_TYPE_INVALID;
+  auto destination = DeviceType::DEVICE_TYPE_INVALID;
+
+  // Persistent memory to the tier above (the top tier is left to promotion)
+  if(memory_device_type != DeviceType::DEVICE_TYPE_INVALID){
+    auto upper_device_type = GetUpperDevice(memory_device_type);
+    if(IsVolatileDevice(memory_device_type) == false &&
+        upper_device_type != top_device_type){
+      source = memory_device_type;
+      destination = upper_device_type;
+    }
+  }
+  // Storage to the lowest memory tier
+  else {
+    source = LocateInStorageDevices(block_id);
+    destination = GetLowestMemoryDevice();
+  }
+
+  if(source == DeviceType::DEVICE_TYPE_INVALID ||
+      destination == DeviceType::DEVICE_TYPE_INVALID){
+    return;
+  }
+
+  double prefetch_duration = 0;
+  BeginBackgroundAccess();
+  Copy(state.devices,
+       destination,
+       source,
+       block_id,
+       CLEAN_BLOCK,
+       prefetch_duration);
+  auto ready_time = EndBackgroundAccess();
+
+  readahead->RecordPrefetch(block_id, ready_time);
+}
+
+// Account for prefetching before a demand access and issue readahead
+void Readahead(const size_t& block_id){
+
+  auto memory_device_type = LocateInMemoryDevices(block_id);
+  auto slow_access = (IsFastDevice(memory_device_type) == false);
+
+  double ready_time = 0;
+  if(readahead->UsePrefetch(block_id, ready_time) == true){
+    // Prefetch still in flight
+    auto stall = WaitForDevice(ready_time);
+    if(stall > 0){
+      readahead->RecordLateUse();
+      total_duration += stall;
+    }
+  }
+  else if(slow_access == true){
+    readahead->RecordMiss();
+  }
+
+  std::vector<size_t> prefetch_blocks;
+  readahead->Access(block_id, slow_access, prefetch_blocks);
+  for(auto prefetch_block : prefetch_blocks){
+    PrefetchBlock(prefetch_block);
+  }
+
+}
+
+// Move a resident block up a tier, off the critical path when there is
+// a migration queue
+void MigrateBlock(DeviceType destination,
+                  DeviceType source,
+                  const size_t& block_id){
+
+  auto background = BeginMigration(total_duration);
+  Copy(state.devices,
+       destination,
+       source,
+       block_id,
+       CLEAN_BLOCK,
+       total_duration);
+  if(background == true){
+    EndMigration(block_id);
+  }
+
 }
 
 void BringBlockToMemory(const size_t& block_id){
 
+  // Wait for the block if a migration is moving it
+  total_duration += WaitForMigration(block_id);
+
+  if(readahead != nullptr){
+    Readahead(block_id);
+  }
+
+  if(promotion == nullptr){
+    ResetPromotionEngine();
+  }
+  promotion->Access(block_id);
+
+  if(rebalancer != nullptr){
+    rebalancer->Access(block_id);
+  }
+
+  // A hit needs a tier above the last device, which may be a memory
+  // device itself (e.g. NVM)
+  auto tier_hit = false;
+  for(size_t device_itr = 0; device_itr + 1 < state.devices.size(); device_itr++){
+    if(IsResident(state.devices[device_itr].cache, block_id) == true){
+      tier_hit = true;
+      break;
+    }
+  }
+  machine_stats.RecordTierAccess(tier_hit);
+
   auto memory_device_type = LocateInMemoryDevices(block_id);
   auto storage_device_type = LocateInStorageDevices(block_id);
-  auto nvm_exists = DeviceExists(state.devices, DeviceType::DEVICE_TYPE_NVM);
 
-  // Not found on DRAM & NVM
+  // Not found in memory: copy to the lowest memory tier
   if(memory_device_type == DeviceType::DEVICE_TYPE_INVALID &&
       storage_device_type != DeviceType::DEVICE_TYPE_INVALID){
-    // Copy to NVM first if it exists in hierarchy
-    if(nvm_exists == true) {
-      Copy(state.devices,
-           DeviceType::DEVICE_TYPE_NVM,
-           storage_device_type,
-           block_id,
-           CLEAN_BLOCK,
-           total_duration);
+    Copy(state.devices,
+         GetLowestMemoryDevice(),
+         storage_device_type,
+         block_id,
+         CLEAN_BLOCK,
+         total_duration);
+  }
+
+  // Promote through the memory tiers, bottom up (e.g. NVM to DRAM, then
+  // DRAM to CACHE)
+  for(size_t device_itr = state.memory_devices.size() - 1;
+      device_itr > 0;
+      device_itr--){
+    auto source = state.memory_devices[device_itr].device_type;
+    memory_device_type = LocateInMemoryDevices(block_id);
+    if(memory_device_type != source){
+      continue;
     }
-    else {
-      Copy(state.devices,
-           DeviceType::DEVICE_TYPE_DRAM,
-           storage_device_type,
-           block_id,
-           CLEAN_BLOCK,
-           total_duration);
+
+    auto destination = state.memory_devices[device_itr - 1].device_type;
+    if(promotion->ShouldPromote(block_id, destination) == true){
+      MigrateBlock(destination, source, block_id);
     }
   }
 
-  // NVM to DRAM migration
-  memory_device_type = LocateInMemoryDevices(block_id);
-
-  if(memory_device_type == DeviceType::DEVICE_TYPE_NVM){
-    auto dram_exists = DeviceExists(state.devices, DeviceType::DEVICE_TYPE_DRAM);
-    bool migrate_to_dram = (rand() % state.migration_frequency == 0);
-    if(dram_exists == true){
-      if(migrate_to_dram == true){
-        Copy(state.devices,
-             DeviceType::DEVICE_TYPE_DRAM,
-             DeviceType::DEVICE_TYPE_NVM,
-             block_id,
-             CLEAN_BLOCK,
-             total_duration);
-      }
-    }
+}
+
+// Write a dirty block of a volatile tier back to the persistent tiers
+void WriteBackBlock(const DeviceType& source,
+                    const size_t& block_id,
+                    const size_t& block_status){
+
+  // Copy to the first persistent tier (clean if it is the last one)
+  Copy(state.devices,
+       GetPersistentLowerDevice(source),
+       source,
+       block_id,
+       block_status,
+       total_duration);
+
+  // Mark block as clean
+  auto device_offset = GetDeviceOffset(state.devices, source);
+  auto device_cache = state.devices[device_offset].cache;
+  auto victim = device_cache.Put(block_id, CLEAN_BLOCK);
+  if(victim.block_id != INVALID_KEY){
+    exit(EXIT_FAILURE);
   }
 
-  // DRAM to CACHE migration
-  memory_device_type = LocateInMemoryDevices(block_id);
+  // Update duration
+  total_duration += GetWriteLatency(state.devices, source, block_id);
 
-  if(memory_device_type == DeviceType::DEVICE_TYPE_DRAM){
-    bool migrate_to_cache = (rand() % state.migration_frequency == 0);
-    if(migrate_to_cache == true){
-      Copy(state.devices,
-           DeviceType::DEVICE_TYPE_CACHE,
-           DeviceType::DEVICE_TYPE_DRAM,
-           block_id,
-           CLEAN_BLOCK,
-           total_duration);
+}
+
+// Clean the volatile tiers past the high watermark in sorted batches,
+// in the background. Blocks are written back to the first persistent tier,
+// as by a checkpoint, so that their eviction is clean.
+void FlushDirtyBlocks(){
+
+  for(size_t device_itr = 0; device_itr < state.devices.size(); device_itr++){
+    auto device_type = state.devices[device_itr].device_type;
+    if(IsVolatileDevice(device_type) == false){
+      continue;
+    }
+
+    std::vector<size_t> dirty_blocks;
+    state.devices[device_itr].cache.GetDirtyBlocks(dirty_blocks);
+
+    std::vector<size_t> flush_blocks;
+    flusher->Plan(device_type,
+                  dirty_blocks,
+                  state.devices[device_itr].device_size,
+                  flush_blocks);
+    if(flush_blocks.empty() == true){
+      continue;
+    }
+
+    BeginBackgroundAccess();
+    for(auto block_id : flush_blocks){
+      WriteBackBlock(device_type, block_id, DIRTY_BLOCK);
     }
+    EndBackgroundAccess();
   }
 
 }
@@ -147,46 +447,41 @@ void BringBlockToStorage(const size_t& block_id,
 
   auto source = LocateInMemoryDevices(block_id);
   auto is_volatile_source = IsVolatileDevice(source);
-  auto nvm_exists = DeviceExists(state.devices, DeviceType::DEVICE_TYPE_NVM);
-  auto last_device_type = state.devices.back().device_type;
-  auto nvm_last = (last_device_type == DeviceType::DEVICE_TYPE_NVM);
-  auto nvm_status = block_status;
-  if(nvm_last == true){
-    nvm_status = CLEAN_BLOCK;
-  }
 
   // Check if it is on DRAM or CACHE
   if(is_volatile_source){
-    // Copy to NVM first if it exists in hierarchy
-    if(nvm_exists == true) {
-      Copy(state.devices,
-           DeviceType::DEVICE_TYPE_NVM,
-           source,
-           block_id,
-           nvm_status,
-           total_duration);
-    }
-    else {
-      Copy(state.devices,
-           DeviceType::DEVICE_TYPE_SSD,
-           source,
-           block_id,
-           CLEAN_BLOCK,
-           total_duration);
-    }
+    WriteBackBlock(source, block_id, block_status);
+  }
 
-    // Mark block as clean
-    auto device_offset = GetDeviceOffset(state.devices, source);
-    auto device_cache = state.devices[device_offset].cache;
-    auto victim = device_cache.Put(block_id, CLEAN_BLOCK);
-    if(victim.block_id != INVALID_KEY){
-      exit(EXIT_FAILURE);
+}
+
+// Flush every dirty block of the volatile tiers in block order. The
+// writes are issued at once, as a checkpointer does, and run in the
+// background next to the foreground operations.
+void Checkpoint(){
+
+  auto start_time = GetDeviceClock();
+  auto end_time = start_time;
+  size_t block_count = 0;
+
+  for(size_t device_itr = 0; device_itr < state.devices.size(); device_itr++){
+    auto device_type = state.devices[device_itr].device_type;
+    if(IsVolatileDevice(device_type) == false){
+      continue;
     }
 
-    // Update duration
-    total_duration += GetWriteLatency(state.devices, source, block_id);
+    std::vector<size_t> dirty_blocks;
+    state.devices[device_itr].cache.GetDirtyBlocks(dirty_blocks);
+    for(auto block_id : dirty_blocks){
+      BeginBackgroundAccess();
+      WriteBackBlock(device_type, block_id, DIRTY_BLOCK);
+      end_time = std::max(end_time, EndBackgroundAccess());
+    }
+    block_count += dirty_blocks.size();
   }
 
+  checkpointer->RecordCheckpoint(start_time, end_time, block_count);
+
 }
 
 void BootstrapBlock(const size_t& block_id) {
@@ -194,10 +489,49 @@ void BootstrapBlock(const size_t& block_id) {
   auto last_device_cache = state.devices.back().cache;
   last_device_cache.Put(block_id, CLEAN_BLOCK);
 
+  // Bootstrapped blocks already sit in the flash
+  if(state.devices.back().device_type == DEVICE_TYPE_SSD){
+    BootstrapFlashPage(block_id);
+  }
+
+}
+
+bool IsWriteHot(const size_t& block_id){
+
+  if(state.nvm_wear_threshold == 0){
+    return false;
+  }
+
+  auto dram_exists = DeviceExists(state.devices, DeviceType::DEVICE_TYPE_DRAM);
+  auto write_count = GetNVMWear().GetBlockWriteCount(block_id);
+  return (dram_exists == true && write_count >= state.nvm_wear_threshold);
+}
+
+void AppendLog(){
+  if(write_ahead_log != nullptr){
+    write_ahead_log->Append();
+  }
+}
+
+// Wait until the log holds every record appended so far
+void CommitLog(){
+
+  if(write_ahead_log == nullptr){
+    return;
+  }
+
+  auto ready_time = write_ahead_log->Commit(GetDeviceClock());
+  auto wait = WaitForDevice(ready_time);
+  write_ahead_log->RecordCommitWait(wait);
+  total_duration += wait;
+
 }
 
 void WriteBlock(const size_t& block_id) {
 
+  // Log the update before the page changes
+  AppendLog();
+
   // Bring block to memory if needed
   BringBlockToMemory(block_id);
 
@@ -207,9 +541,9 @@ void WriteBlock(const size_t& block_id) {
   if(destination == DeviceType::DEVICE_TYPE_INVALID){
     //std::cout << "WRITE " << block_id << "\n";
 
-    // Mark block as dirty
+    // Mark block as dirty in the top tier
     Copy(state.devices,
-         DeviceType::DEVICE_TYPE_CACHE,
+         state.devices.front().device_type,
          DeviceType::DEVICE_TYPE_INVALID,
          block_id,
          DIRTY_BLOCK,
@@ -221,6 +555,15 @@ void WriteBlock(const size_t& block_id) {
   // CASE 2: Existing block
   //std::cout << "UPDATE " << block_id << "\n";
 
+  // Keep write-hot blocks in DRAM to spare the NVM
+  if(destination == DeviceType::DEVICE_TYPE_NVM &&
+      IsWriteHot(block_id) == true){
+    MigrateBlock(DeviceType::DEVICE_TYPE_DRAM,
+                 DeviceType::DEVICE_TYPE_NVM,
+                 block_id);
+    destination = LocateInMemoryDevices(block_id);
+  }
+
   // Mark block as dirty
   auto is_volatile_destination = IsVolatileDevice(destination);
   if(is_volatile_destination){
@@ -271,22 +614,175 @@ void FlushBlock(const size_t& block_id) {
 
 }
 
+// Swap the hottest NVM blocks with the coldest DRAM blocks. Migrations run
+// in the background and are charged to the rebalancer, not to the caller.
+void RebalanceTiers(){
+
+  auto dram_exists = DeviceExists(state.devices, DeviceType::DEVICE_TYPE_DRAM);
+  auto nvm_exists = DeviceExists(state.devices, DeviceType::DEVICE_TYPE_NVM);
+  if(dram_exists == false || nvm_exists == false){
+    return;
+  }
+
+  auto dram_offset = GetDeviceOffset(state.devices, DeviceType::DEVICE_TYPE_DRAM);
+  auto nvm_offset = GetDeviceOffset(state.devices, DeviceType::DEVICE_TYPE_NVM);
+  auto dram_cache = state.devices[dram_offset].cache;
+  auto nvm_cache = state.devices[nvm_offset].cache;
+
+  std::vector<int> dram_blocks;
+  dram_cache.GetKeys(dram_blocks);
+  auto dram_size = state.devices[dram_offset].device_size;
+  size_t free_slots = 0;
+  if(dram_blocks.size() < dram_size){
+    free_slots = dram_size - dram_blocks.size();
+  }
+
+  // Blocks held by a faster tier are not candidates
+  auto in_nvm = [&](const size_t& block_id){
+    for(size_t device_itr = 0; device_itr < dram_offset; device_itr++){
+      if(IsResident(state.devices[device_itr].cache, block_id) == true){
+        return false;
+      }
+    }
+    return (IsResident(dram_cache, block_id) == false &&
+        IsResident(nvm_cache, block_id) == true);
+  };
+
+  std::vector<size_t> promote_blocks;
+  std::vector<size_t> demote_blocks;
+  rebalancer->Plan(dram_blocks,
+                   free_slots,
+                   in_nvm,
+                   promote_blocks,
+                   demote_blocks);
+
+  if(promote_blocks.empty() == true){
+    return;
+  }
+
+  double migration_duration = 0;
+  auto start_time = GetDeviceClock();
+  BeginBackgroundAccess();
+
+  // Demote first so that promotions land in free slots
+  for(auto block_id : demote_blocks){
+    // Clean blocks still held by the NVM are simply dropped
+    auto block_status = dram_cache.Get(block_id, false);
+    if(block_status == DIRTY_BLOCK ||
+        IsResident(nvm_cache, block_id) == false){
+      Copy(state.devices,
+           DeviceType::DEVICE_TYPE_NVM,
+           DeviceType::DEVICE_TYPE_DRAM,
+           block_id,
+           block_status,
+           migration_duration);
+    }
+    dram_cache.Erase(block_id);
+  }
+
+  for(auto block_id : promote_blocks){
+    Copy(state.devices,
+         DeviceType::DEVICE_TYPE_DRAM,
+         DeviceType::DEVICE_TYPE_NVM,
+         block_id,
+         CLEAN_BLOCK,
+         migration_duration);
+  }
+
+  auto end_time = EndBackgroundAccess();
+  rebalancer->RecordMigration(promote_blocks.size(),
+                              demote_blocks.size(),
+                              end_time - start_time);
+
+}
+
+bool ExecuteOperation(const char& operation_type,
+                      const size_t& block_id){
+
+  switch(operation_type){
+    case 'r':
+      ReadBlock(block_id);
+      return true;
+
+    case 'w':
+      WriteBlock(block_id);
+      return true;
+
+    case 'f':
+      FlushBlock(block_id);
+      return true;
+
+    case 'c':
+      Checkpoint();
+      return true;
+
+    case 'l':
+      AppendLog();
+      return true;
+
+    case 't':
+      CommitLog();
+      return true;
+
+    default:
+      return false;
+  }
+
+}
+
 size_t GetGlobalBlockNumber(const size_t& fork_number,
                             const size_t& block_number){
   return (fork_number * 10 + block_number);
 }
 
+// Get the next operation from the trace file or the generator
+bool GetNextOperation(std::istream* input,
+                      WorkloadGenerator* generator,
+                      char& operation_type,
+                      size_t& fork_number,
+                      size_t& block_number){
+
+  if(generator != nullptr){
+    fork_number = 0;
+    generator->GetNextOperation(operation_type, block_number);
+    return true;
+  }
+
+  if(input->eof()){
+    return false;
+  }
+
+  const size_t fragment_size = 4096;
+  char buffer[fragment_size];
+
+  // Get a line from the input stream
+  input->getline(buffer, fragment_size);
+
+  // Check statement
+  sscanf(buffer, "%c %lu %lu",
+         &operation_type,
+         &fork_number,
+         &block_number);
+
+  return true;
+}
+
 void MachineHelper() {
 
   // Run workload
 
-  // Go through trace file
+  // Go through trace file or synthesize the workload
   std::unique_ptr<std::istream> input;
+  std::unique_ptr<WorkloadGenerator> generator;
   char operation_type;
   size_t fork_number;
   size_t block_number;
 
-  if (state.file_name.empty()) {
+  if (state.generator_mode == true) {
+    std::cout << "Running generator...\n";
+    generator.reset(new WorkloadGenerator(state));
+  }
+  else if (state.file_name.empty()) {
     return;
   }
   else {
@@ -294,50 +790,55 @@ void MachineHelper() {
     input.reset(new std::ifstream(state.file_name.c_str()));
   }
 
-  size_t fragment_size = 4096;
-  char buffer[fragment_size];
-
   size_t operation_itr = 0;
   size_t invalid_operation_itr = 0;
 
   std::set<size_t> block_list;
 
-  // PREPROCESS
-  while(!input->eof()){
-    operation_itr++;
-
-    // Get a line from the input stream
-    input->getline(buffer, fragment_size);
-
-    // Check statement
-    sscanf(buffer, "%c %lu %lu",
-           &operation_type,
-           &fork_number,
-           &block_number);
+  auto load_snapshot = (state.load_snapshot_file.empty() == false);
 
-    auto global_block_number = GetGlobalBlockNumber(fork_number, block_number);
-
-    // Block does not exist
-    if(block_list.count(global_block_number) == 0){
-      BootstrapBlock(global_block_number);
-      block_list.insert(global_block_number);
+  // PREPROCESS (the snapshot already holds the bootstrapped blocks)
+  if(load_snapshot == true){
+    // Nothing to do here!
+  }
+  else if(generator != nullptr){
+    auto page_count = generator->GetPageCount();
+    for(size_t page_itr = 0; page_itr < page_count; page_itr++){
+      BootstrapBlock(GetGlobalBlockNumber(0, page_itr));
     }
+  }
+  else {
+    while(GetNextOperation(input.get(),
+                           nullptr,
+                           operation_type,
+                           fork_number,
+                           block_number)){
+      operation_itr++;
+
+      auto global_block_number = GetGlobalBlockNumber(fork_number, block_number);
+
+      // Block does not exist
+      if(block_list.count(global_block_number) == 0){
+        BootstrapBlock(global_block_number);
+        block_list.insert(global_block_number);
+      }
 
-    if(state.operation_count != 0){
-      if(operation_itr > state.operation_count){
-        break;
+      if(state.operation_count != 0){
+        if(operation_itr > state.operation_count){
+          break;
+        }
       }
+
     }
 
+    // Reset file pointer
+    input->clear();
+    input->seekg(0, std::ios::beg);
   }
 
   // Print machine caches
   PrintMachine();
 
-  // Reset file pointer
-  input->clear();
-  input->seekg(0, std::ios::beg);
-
   // Reinit duration
   total_duration = 0;
   operation_itr = 0;
@@ -345,60 +846,196 @@ void MachineHelper() {
   // Reset stats
   machine_stats.Reset();
 
-  // RUN SIMULATION
-  while(!input->eof()){
-    operation_itr++;
+  ResetWorkloadEngines();
+
+  // RESUME FROM SNAPSHOT
+  size_t resume_itr = 0;
+  if(load_snapshot == true){
+    resume_itr = LoadSnapshot(state, state.load_snapshot_file);
+
+    // Skip the operations covered by the snapshot
+    while(operation_itr < resume_itr &&
+        GetNextOperation(input.get(),
+                         generator.get(),
+                         operation_type,
+                         fork_number,
+                         block_number)){
+      operation_itr++;
+    }
 
-    // Get a line from the input stream
-    input->getline(buffer, fragment_size);
+    PrintMachine();
+  }
+
+  // Warm-up statistics
+  Stats warmup_stats;
+  double warmup_duration = 0;
+  size_t warmup_itr = 0;
+
+  // Concurrent clients go through the event engine
+  std::unique_ptr<EventEngine> engine;
+  if(state.client_count > 1){
+    engine.reset(new EventEngine(state.client_count));
+  }
 
-    // Check statement
-    sscanf(buffer, "%c %lu %lu",
-           &operation_type,
-           &fork_number,
-           &block_number);
+  // Replay one operation, returns false at the end of the workload
+  auto replay_operation = [&]() -> bool {
+
+    if(state.operation_count != 0){
+      if(operation_itr > state.operation_count){
+        return false;
+      }
+    }
+
+    if(GetNextOperation(input.get(),
+                        generator.get(),
+                        operation_type,
+                        fork_number,
+                        block_number) == false){
+      return false;
+    }
+    operation_itr++;
 
     auto global_block_number = GetGlobalBlockNumber(fork_number, block_number);
 
-    switch(operation_type){
-      case 'r':
-        ReadBlock(global_block_number);
-        break;
+    auto operation_start = total_duration;
+    auto issue_time = GetDeviceClock();
+    auto valid_operation = ExecuteOperation(operation_type,
+                                            global_block_number);
+    if(valid_operation == false){
+      invalid_operation_itr++;
+    }
 
-      case 'w':
-        WriteBlock(global_block_number);
-        break;
+    if(rebalancer != nullptr && rebalancer->Tick() == true){
+      RebalanceTiers();
+    }
 
-      case 'f':
-        FlushBlock(global_block_number);
-        break;
+    if(flusher != nullptr && flusher->Tick() == true){
+      FlushDirtyBlocks();
+    }
+
+    if(state.checkpoint_interval != 0 &&
+        operation_itr % state.checkpoint_interval == 0){
+      Checkpoint();
+    }
 
-      default:
-        invalid_operation_itr++;
-        break;
+    // The event engine records latency when the operation completes
+    if(engine == nullptr){
+      machine_stats.RecordLatency(total_duration - operation_start);
+      checkpointer->RecordLatency(issue_time, total_duration - operation_start);
+    }
+
+    // End of warm-up: keep its numbers apart from the steady state
+    if(state.warmup_operation_count != 0 &&
+        operation_itr - resume_itr == state.warmup_operation_count){
+      warmup_stats = machine_stats;
+      warmup_itr = state.warmup_operation_count;
+      machine_stats.Reset();
+      GetNVMWear().Reset();
+      if(readahead != nullptr){
+        readahead->ResetStats();
+      }
+      promotion->ResetStats();
+      if(rebalancer != nullptr){
+        rebalancer->ResetStats();
+      }
+      if(GetMigrationQueue() != nullptr){
+        GetMigrationQueue()->ResetStats();
+      }
+      if(flusher != nullptr){
+        flusher->ResetStats();
+      }
+      checkpointer->ResetStats();
+      if(write_ahead_log != nullptr){
+        write_ahead_log->ResetStats();
+      }
+      if(engine != nullptr){
+        warmup_duration = engine->GetElapsedTime();
+        engine->ResetStats();
+      }
+      else {
+        warmup_duration = total_duration;
+        total_duration = 0;
+      }
+      std::cout << "Warm-up done after operation " << operation_itr << "\n";
+    }
+
+    if(operation_itr == state.snapshot_operation &&
+        state.save_snapshot_file.empty() == false){
+      SaveSnapshot(state, state.save_snapshot_file, operation_itr);
     }
 
     if(operation_itr % 100000 == 0){
+      auto current_duration = total_duration;
+      if(engine != nullptr){
+        current_duration = engine->GetElapsedTime();
+      }
       std::cout << "Operation " << operation_itr << " :: " <<
           operation_type << " " << global_block_number << " "
           << fork_number << " " << block_number << " :: "
-          << total_duration / (1000 * 1000) << "s \n";
+          << current_duration / (1000 * 1000) << "s \n";
     }
 
-    if(state.operation_count != 0){
-      if(operation_itr > state.operation_count){
-        break;
-      }
-    }
+    return true;
+  };
 
+  // RUN SIMULATION
+  if(engine != nullptr){
+    engine->Run(replay_operation);
+    total_duration = engine->GetElapsedTime();
+  }
+  else {
+    while(replay_operation() == true){
+      // Nothing to do here!
+    }
   }
 
-  auto throughput = (operation_itr * 1000 * 1000)/total_duration;
+  auto steady_itr = operation_itr - resume_itr - warmup_itr;
+  auto throughput = (steady_itr * 1000 * 1000)/total_duration;
 
   std::cout << "+++++++++++++++++++++++++++++++++++++++++++++++++++++\n";
+  if(warmup_itr > 0){
+    auto warmup_throughput = (warmup_itr * 1000 * 1000)/warmup_duration;
+    std::cout << "Warm-up throughput : " << warmup_throughput << " (ops/s) "
+        << "over " << warmup_itr << " ops\n";
+  }
   std::cout << "Throughput : " << throughput << " (ops/s) \n";
+
+  // Background migrations are kept out of the foreground time
+  if(rebalancer != nullptr){
+    std::cout << "Foreground time : " << total_duration << " (ns) "
+        << "Migration time : " << rebalancer->GetMigrationDuration()
+        << " (ns) \n";
+  }
+
+  // Projected NVM lifetime at this write rate
+  auto& nvm_wear = GetNVMWear();
+  if(nvm_wear.GetWriteCount() > 0){
+    auto nvm_offset = GetDeviceOffset(state.devices, DEVICE_TYPE_NVM);
+    auto nvm_capacity = state.devices[nvm_offset].device_size;
+    std::cout << "NVM lifetime (years) : "
+        << nvm_wear.GetBlockLifetime(state.nvm_endurance, total_duration)
+        << " (block) "
+        << nvm_wear.GetRegionLifetime(state.nvm_endurance, total_duration)
+        << " (region) "
+        << nvm_wear.GetLeveledLifetime(state.nvm_endurance,
+                                       total_duration,
+                                       nvm_capacity)
+        << " (leveled) \n";
+  }
   std::cout << "+++++++++++++++++++++++++++++++++++++++++++++++++++++\n";
 
+  if(engine != nullptr){
+    std::cout << *engine;
+    std::cout << "+++++++++++++++++++++++++++++++++++++++++++++++++++++\n";
+  }
+
+  if(warmup_itr > 0){
+    std::cout << "WARM-UP\n";
+    std::cout << warmup_stats;
+    std::cout << "+++++++++++++++++++++++++++++++++++++++++++++++++++++\n";
+    std::cout << "STEADY STATE\n";
+  }
+
   // Get machine size
   auto machine_size = GetMachineSize();
   std::cout << "Machine size  : " << machine_size << "\n";
@@ -0,0 +1,90 @@
+// CHECKPOINT TEST
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <vector>
+
+#include "checkpoint.h"
+#include "dirty_index.h"
+#include "storage_cache.h"
+
+namespace machine {
+
+TEST(CheckpointTest, DirtyIndex) {
+
+  DirtyIndex dirty_index;
+
+  for(size_t block_id : {130, 5, 64, 63, 5}){
+    dirty_index.Set(block_id);
+  }
+  dirty_index.Clear(64);
+  dirty_index.Clear(1000);
+
+  EXPECT_EQ(dirty_index.GetCount(), 3);
+  EXPECT_TRUE(dirty_index.Test(63));
+  EXPECT_FALSE(dirty_index.Test(64));
+
+  // Blocks come out in ascending order
+  std::vector<size_t> blocks;
+  dirty_index.GetBlocks(blocks);
+  EXPECT_EQ(blocks, std::vector<size_t>({5, 63, 130}));
+
+}
+
+TEST(CheckpointTest, CacheTracksDirtyBlocks) {
+
+  StorageCache cache(DEVICE_TYPE_DRAM, CACHING_TYPE_FIFO, 3);
+  auto cache_copy = cache;
+
+  cache.Put(1, DIRTY_BLOCK);
+  cache.Put(2, CLEAN_BLOCK);
+  cache.Put(3, DIRTY_BLOCK);
+
+  // Cleaned and evicted blocks leave the index
+  cache.Put(3, CLEAN_BLOCK);
+  cache.Put(4, DIRTY_BLOCK);
+
+  // Copies of the cache share the index
+  std::vector<size_t> blocks;
+  cache_copy.GetDirtyBlocks(blocks);
+  EXPECT_EQ(blocks, std::vector<size_t>({4}));
+
+  cache.Erase(4);
+  EXPECT_EQ(cache.GetDirtyCount(), 0);
+
+  // Rebuilt from a snapshot
+  cache.Put(5, DIRTY_BLOCK);
+  std::vector<uint64_t> buffer;
+  cache.Serialize(buffer);
+  StorageCache restored_cache(DEVICE_TYPE_DRAM, CACHING_TYPE_FIFO, 3);
+  const uint64_t* cursor = buffer.data();
+  const uint64_t* end = buffer.data() + buffer.size();
+  restored_cache.Deserialize(cursor, end);
+  EXPECT_EQ(restored_cache.GetDirtyCount(), 1);
+
+}
+
+TEST(CheckpointTest, ForegroundImpact) {
+
+  CheckpointTracker checkpointer;
+
+  checkpointer.RecordCheckpoint(1000, 5000, 40);
+  checkpointer.RecordCheckpoint(9000, 10000, 10);
+
+  // Operations issued before the checkpoint ends overlap with it
+  checkpointer.RecordLatency(4000, 300);
+  checkpointer.RecordLatency(9500, 500);
+  checkpointer.RecordLatency(12000, 100);
+
+  std::stringstream output;
+  output << checkpointer;
+  EXPECT_EQ(checkpointer.GetCheckpointCount(), 2);
+  EXPECT_NE(output.str().find("BLOCKS :: 50"), std::string::npos);
+  EXPECT_NE(output.str().find("MEAN :: 2500"), std::string::npos);
+  EXPECT_NE(output.str().find("DURING :: 2 400"), std::string::npos);
+  EXPECT_NE(output.str().find("OUTSIDE :: 1 100"), std::string::npos);
+
+}
+
+}  // End machine namespace
@@ -0,0 +1,254 @@
+// DEVICE TEST
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "configuration.h"
+#include "device.h"
+
+namespace machine {
+
+TEST(DeviceTest, ServiceModelChannels) {
+
+  configuration state;
+  state.nvm_read_latency = 4;
+  state.nvm_write_latency = 8;
+  state.ftl_overprovisioning = 0;
+  state.migration_queue_depth = 0;
+  state.inclusion_type = INCLUSION_TYPE_INCLUSIVE;
+  state.service_models[DEVICE_TYPE_SSD] = {4, 0, 0};
+  BootstrapDeviceMetrics(state);
+
+  // Four requests overlap, the fifth waits for a channel
+  for(size_t request_itr = 0; request_itr < 4; request_itr++){
+    EXPECT_DOUBLE_EQ(ServeDeviceRequest(DEVICE_TYPE_SSD, 0, 100), 100);
+  }
+  EXPECT_DOUBLE_EQ(ServeDeviceRequest(DEVICE_TYPE_SSD, 0, 100), 200);
+
+  // Idle device serves at the channel latency
+  EXPECT_DOUBLE_EQ(ServeDeviceRequest(DEVICE_TYPE_SSD, 1000, 100), 1100);
+
+}
+
+TEST(DeviceTest, ServiceModelBandwidth) {
+
+  configuration state;
+  state.nvm_read_latency = 4;
+  state.nvm_write_latency = 8;
+  state.ftl_overprovisioning = 0;
+  state.migration_queue_depth = 0;
+  state.inclusion_type = INCLUSION_TYPE_INCLUSIVE;
+
+  // 4K block at 1000 MB/s takes 4096 ns on the wire
+  state.service_models[DEVICE_TYPE_NVM] = {8, 1000, 0};
+  BootstrapDeviceMetrics(state);
+
+  EXPECT_DOUBLE_EQ(ServeDeviceRequest(DEVICE_TYPE_NVM, 0, 400), 4096);
+  EXPECT_DOUBLE_EQ(ServeDeviceRequest(DEVICE_TYPE_NVM, 0, 400), 2 * 4096);
+
+  // Serial accesses pay the transfer time when it exceeds the latency
+  ResetDeviceServiceState();
+  std::vector<Device> devices;
+  EXPECT_EQ(GetWriteLatency(devices, DEVICE_TYPE_NVM, 0), 4096);
+
+}
+
+TEST(DeviceTest, ServiceModelQueueDepth) {
+
+  configuration state;
+  state.nvm_read_latency = 4;
+  state.nvm_write_latency = 8;
+  state.ftl_overprovisioning = 0;
+  state.migration_queue_depth = 0;
+  state.inclusion_type = INCLUSION_TYPE_INCLUSIVE;
+  state.service_models[DEVICE_TYPE_SSD] = {8, 0, 2};
+  BootstrapDeviceMetrics(state);
+
+  // Only two requests are admitted although channels are free
+  EXPECT_DOUBLE_EQ(ServeDeviceRequest(DEVICE_TYPE_SSD, 0, 100), 100);
+  EXPECT_DOUBLE_EQ(ServeDeviceRequest(DEVICE_TYPE_SSD, 0, 100), 100);
+  EXPECT_DOUBLE_EQ(ServeDeviceRequest(DEVICE_TYPE_SSD, 0, 100), 200);
+
+}
+
+TEST(DeviceTest, ServiceModelChainKeepsChannel) {
+
+  configuration state;
+  state.nvm_read_latency = 4;
+  state.nvm_write_latency = 8;
+  state.ftl_overprovisioning = 0;
+  state.migration_queue_depth = 0;
+  state.inclusion_type = INCLUSION_TYPE_INCLUSIVE;
+  state.service_models[DEVICE_TYPE_SSD] = {2, 0, 0};
+  BootstrapDeviceMetrics(state);
+
+  // A chain of accesses, each issued when the last one completes
+  double chain_time = 0;
+  for(size_t request_itr = 0; request_itr < 8; request_itr++){
+    chain_time = ServeDeviceRequest(DEVICE_TYPE_SSD, chain_time, 100);
+  }
+  EXPECT_DOUBLE_EQ(chain_time, 800);
+
+  // The other channel is still idle
+  EXPECT_DOUBLE_EQ(ServeDeviceRequest(DEVICE_TYPE_SSD, 0, 100), 100);
+
+}
+
+TEST(DeviceTest, PerTierPolicy) {
+
+  configuration state;
+  state.hierarchy_type = HIERARCHY_TYPE_DRAM_NVM_SSD;
+  state.size_type = SIZE_TYPE_1;
+  state.caching_type = CACHING_TYPE_FIFO;
+  state.nvm_read_latency = 4;
+  state.nvm_write_latency = 8;
+  state.ftl_overprovisioning = 0;
+  state.migration_queue_depth = 0;
+  state.inclusion_type = INCLUSION_TYPE_INCLUSIVE;
+  state.tier_models[DEVICE_TYPE_DRAM] = {CACHING_TYPE_LRU, 1000};
+  state.tier_models[DEVICE_TYPE_NVM] = {CACHING_TYPE_ARC, 0};
+  BootstrapDeviceMetrics(state);
+  ConstructDeviceList(state);
+
+  // Tiers without an override keep the global caching type and size
+  ASSERT_EQ(state.devices.size(), 4);
+  EXPECT_EQ(state.devices[0].cache.caching_type_, CACHING_TYPE_FIFO);
+  EXPECT_EQ(state.devices[1].cache.caching_type_, CACHING_TYPE_LRU);
+  EXPECT_EQ(state.devices[1].device_size, 1000);
+  EXPECT_EQ(state.devices[2].cache.caching_type_, CACHING_TYPE_ARC);
+  EXPECT_EQ(state.devices[2].device_size, 16 * 250);
+  EXPECT_EQ(state.devices[3].cache.caching_type_, CACHING_TYPE_FIFO);
+
+}
+
+TEST(DeviceTest, TopologyTierChain) {
+
+  DeviceType cxl_device_type = DEVICE_TYPE_CUSTOM;
+  DeviceType hdd_device_type = (DeviceType) (DEVICE_TYPE_CUSTOM + 1);
+  SetDeviceTypeName(cxl_device_type, "CXL");
+  SetDeviceTypeName(hdd_device_type, "HDD");
+
+  configuration state;
+  state.nvm_read_latency = 4;
+  state.nvm_write_latency = 8;
+  state.ftl_overprovisioning = 0;
+  state.migration_queue_depth = 0;
+  state.inclusion_type = INCLUSION_TYPE_INCLUSIVE;
+  state.topology = {
+      {"DRAM", DEVICE_TYPE_DRAM, true, true, CACHING_TYPE_LRU, 100, 0, 0, 0},
+      {"CXL", cxl_device_type, true, true, CACHING_TYPE_FIFO, 200, 300, 400, 2},
+      {"NVM", DEVICE_TYPE_NVM, false, true, CACHING_TYPE_LRU, 400, 0, 0, 0},
+      {"HDD", hdd_device_type, false, false, CACHING_TYPE_FIFO, 0,
+          5000, 6000, 0}
+  };
+  state.hierarchy_type = HIERARCHY_TYPE_TOPOLOGY;
+  BootstrapDeviceMetrics(state);
+  ConstructDeviceList(state);
+
+  ASSERT_EQ(state.devices.size(), 4);
+  EXPECT_EQ(DeviceTypeToString(cxl_device_type), "CXL");
+  EXPECT_EQ(GetDeviceOffset(state.devices, cxl_device_type), 1);
+  EXPECT_EQ(state.devices[1].device_size, 200);
+
+  // Victims move down, promotions move up the declared order
+  EXPECT_EQ(GetLowerDevice(state.devices, DEVICE_TYPE_DRAM), cxl_device_type);
+  EXPECT_EQ(GetLowerDevice(state.devices, cxl_device_type), DEVICE_TYPE_NVM);
+  EXPECT_EQ(GetUpperDevice(DEVICE_TYPE_NVM), cxl_device_type);
+  EXPECT_EQ(GetUpperDevice(DEVICE_TYPE_DRAM), DEVICE_TYPE_INVALID);
+
+  // Dirty blocks of volatile tiers are written back to NVM
+  EXPECT_EQ(GetPersistentLowerDevice(DEVICE_TYPE_DRAM), DEVICE_TYPE_NVM);
+  EXPECT_EQ(GetPersistentLowerDevice(cxl_device_type), DEVICE_TYPE_NVM);
+  EXPECT_TRUE(IsVolatileTier(cxl_device_type));
+  EXPECT_FALSE(IsVolatileTier(DEVICE_TYPE_NVM));
+
+  // Declared latencies and channels
+  EXPECT_EQ(GetDeviceParallelism(cxl_device_type), 2);
+  EXPECT_DOUBLE_EQ(GetSequentialWriteLatency(hdd_device_type), 6000);
+
+}
+
+TEST(DeviceTest, ExclusiveHierarchy) {
+
+  configuration state;
+  state.hierarchy_type = HIERARCHY_TYPE_DRAM_NVM_SSD;
+  state.size_type = SIZE_TYPE_1;
+  state.caching_type = CACHING_TYPE_FIFO;
+  state.nvm_read_latency = 4;
+  state.nvm_write_latency = 8;
+  state.ftl_overprovisioning = 0;
+  state.migration_queue_depth = 0;
+  state.inclusion_type = INCLUSION_TYPE_EXCLUSIVE;
+  state.tier_models[DEVICE_TYPE_DRAM] = {CACHING_TYPE_FIFO, 2};
+  state.tier_models[DEVICE_TYPE_NVM] = {CACHING_TYPE_FIFO, 4};
+  BootstrapDeviceMetrics(state);
+  ConstructDeviceList(state);
+
+  auto& dram_cache = state.devices[1].cache;
+  auto& nvm_cache = state.devices[2].cache;
+  auto& ssd_cache = state.devices[3].cache;
+  double duration = 0;
+
+  for(size_t block_id = 1; block_id <= 3; block_id++){
+    Copy(state.devices, DEVICE_TYPE_SSD, DEVICE_TYPE_INVALID,
+         block_id, CLEAN_BLOCK, duration);
+    Copy(state.devices, DEVICE_TYPE_NVM, DEVICE_TYPE_SSD,
+         block_id, CLEAN_BLOCK, duration);
+  }
+  nvm_cache.Put(3, DIRTY_BLOCK);
+
+  // Promotions move the block out of the NVM, keeping its status
+  Copy(state.devices, DEVICE_TYPE_DRAM, DEVICE_TYPE_NVM,
+       1, CLEAN_BLOCK, duration);
+  Copy(state.devices, DEVICE_TYPE_DRAM, DEVICE_TYPE_NVM,
+       3, CLEAN_BLOCK, duration);
+  EXPECT_FALSE(IsResident(nvm_cache, 1));
+  EXPECT_FALSE(IsResident(nvm_cache, 3));
+  EXPECT_EQ(dram_cache.Get(3, false), DIRTY_BLOCK);
+
+  // The clean DRAM victim moves back into the NVM
+  Copy(state.devices, DEVICE_TYPE_DRAM, DEVICE_TYPE_NVM,
+       2, CLEAN_BLOCK, duration);
+  EXPECT_FALSE(IsResident(dram_cache, 1));
+  EXPECT_TRUE(IsResident(nvm_cache, 1));
+  EXPECT_EQ(dram_cache.CurrentCapacity() + nvm_cache.CurrentCapacity(), 3);
+
+  // The last device keeps every block
+  EXPECT_EQ(ssd_cache.CurrentCapacity(), 3);
+
+}
+
+TEST(DeviceTest, WriteBackAwareEviction) {
+
+  configuration state;
+  state.hierarchy_type = HIERARCHY_TYPE_DRAM_NVM_SSD;
+  state.size_type = SIZE_TYPE_1;
+  state.caching_type = CACHING_TYPE_LRU;
+  state.nvm_read_latency = 4;
+  state.nvm_write_latency = 8;
+  state.ftl_overprovisioning = 0;
+  state.migration_queue_depth = 0;
+  state.inclusion_type = INCLUSION_TYPE_INCLUSIVE;
+  state.tier_models[DEVICE_TYPE_DRAM] = {CACHING_TYPE_GREEDY_DUAL, 3};
+  BootstrapDeviceMetrics(state);
+  ConstructDeviceList(state);
+
+  auto& dram_cache = state.devices[1].cache;
+  dram_cache.Put(1, DIRTY_BLOCK);
+  dram_cache.Put(2, CLEAN_BLOCK);
+  dram_cache.Put(3, CLEAN_BLOCK);
+
+  // Refetching from the NVM costs 400 ns and writing back 800 ns more, so
+  // the dirty block outlives six clean victims
+  for(size_t block_id = 4; block_id <= 9; block_id++){
+    auto victim = dram_cache.Put(block_id, CLEAN_BLOCK);
+    EXPECT_EQ(victim.block_type, CLEAN_BLOCK);
+  }
+
+  auto victim = dram_cache.Put(10, CLEAN_BLOCK);
+  EXPECT_EQ(victim.block_id, 1);
+
+}
+
+}  // End machine namespace
@@ -2,6 +2,8 @@
 
 #include <gtest/gtest.h>
 
+#include <vector>
+
 #include "distribution.h"
 
 namespace machine {
@@ -26,4 +28,215 @@ TEST(DistributionTest, RangeCheck) {
 
 }
 
+// Compare the empirical frequency of the hottest ranks with the exact pmf
+template <typename Distribution>
+void CheckZipfQuality(Distribution& generator,
+                      const size_t& upper_bound,
+                      const double& theta) {
+
+  size_t sample_count = 1000 * 1000;
+  size_t checked_ranks = 10;
+  std::vector<size_t> histogram(checked_ranks + 1, 0);
+
+  for(size_t sample_itr = 0; sample_itr < sample_count; sample_itr++){
+    auto sample = generator.GetNextNumber();
+    EXPECT_TRUE(sample >= 1);
+    EXPECT_TRUE(sample <= upper_bound);
+    if(sample <= checked_ranks){
+      histogram[sample]++;
+    }
+  }
+
+  auto zeta = ComputeZeta(upper_bound, theta);
+  for(size_t rank = 1; rank <= checked_ranks; rank++){
+    double probability = pow(1.0 / rank, theta) / zeta;
+    double expected = probability * sample_count;
+    double sigma = sqrt(expected * (1 - probability));
+    EXPECT_NEAR(histogram[rank], expected, 5 * sigma) << "rank " << rank;
+  }
+
+}
+
+TEST(DistributionTest, FastZipfRangeCheck) {
+
+  size_t sample_count = 100 * 1000;
+  std::vector<double> thetas = {0, 0.5, 0.99, 1.0, 1.5};
+
+  for(auto theta : thetas){
+    for(size_t upper_bound : {1UL, 2UL, 100UL, 1000UL * 1000 * 1000}){
+      FastZipfDistribution zipf_generator(upper_bound, theta, 1);
+      for(size_t sample_itr = 0; sample_itr < sample_count; sample_itr++){
+        auto sample = zipf_generator.GetNextNumber();
+        EXPECT_TRUE(sample >= 1);
+        EXPECT_TRUE(sample <= upper_bound);
+      }
+    }
+  }
+
+}
+
+TEST(DistributionTest, FastZipfQuality) {
+
+  size_t upper_bound = 1000;
+
+  for(auto theta : {0.5, 0.99, 1.0, 1.5}){
+    FastZipfDistribution zipf_generator(upper_bound, theta, 2);
+    CheckZipfQuality(zipf_generator, upper_bound, theta);
+  }
+
+}
+
+TEST(DistributionTest, ZipfQuality) {
+
+  size_t upper_bound = 1000;
+  double theta = 0.99;
+
+  // The approximation in ZipfDistribution is exact only for ranks 1 and 2
+  ZipfDistribution zipf_generator(upper_bound, theta, 3);
+  size_t sample_count = 1000 * 1000;
+  size_t rank_1 = 0, rank_2 = 0;
+  for(size_t sample_itr = 0; sample_itr < sample_count; sample_itr++){
+    auto sample = zipf_generator.GetNextNumber();
+    rank_1 += (sample == 1);
+    rank_2 += (sample == 2);
+  }
+
+  auto zeta = ComputeZeta(upper_bound, theta);
+  double expected_1 = sample_count / zeta;
+  double expected_2 = sample_count * pow(0.5, theta) / zeta;
+  EXPECT_NEAR(rank_1, expected_1, 5 * sqrt(expected_1));
+  EXPECT_NEAR(rank_2, expected_2, 5 * sqrt(expected_2));
+
+}
+
+TEST(DistributionTest, ScrambledZipfSpreadsHotKeys) {
+
+  size_t upper_bound = 100 * 1000;
+  size_t sample_count = 100 * 1000;
+  double theta = 0.99;
+
+  FastZipfDistribution zipf_generator(upper_bound, theta, 5);
+  ScrambledZipfDistribution scrambled_generator(upper_bound, theta, 5);
+
+  // Plain zipf draws many numerically adjacent keys, scrambled zipf does not
+  size_t zipf_adjacent = 0, scrambled_adjacent = 0;
+  uint64_t zipf_previous = 0, scrambled_previous = 0;
+  for(size_t sample_itr = 0; sample_itr < sample_count; sample_itr++){
+    auto zipf_sample = zipf_generator.GetNextNumber();
+    auto scrambled_sample = scrambled_generator.GetNextNumber();
+    EXPECT_TRUE(scrambled_sample >= 1);
+    EXPECT_TRUE(scrambled_sample <= upper_bound);
+
+    zipf_adjacent += (zipf_sample == zipf_previous + 1);
+    scrambled_adjacent += (scrambled_sample == scrambled_previous + 1);
+    zipf_previous = zipf_sample;
+    scrambled_previous = scrambled_sample;
+  }
+
+  EXPECT_GT(zipf_adjacent, 10 * scrambled_adjacent);
+
+}
+
+TEST(DistributionTest, ScrambledZipfStableHotSet) {
+
+  size_t upper_bound = 1000;
+  size_t sample_count = 100 * 1000;
+
+  ScrambledZipfDistribution scrambled_generator(upper_bound, 0.99, 9);
+
+  // The hottest key before any insert
+  auto hottest_key = 1 + FNVHash64(1) % upper_bound;
+
+  for(size_t round = 0; round < 10; round++){
+    size_t hottest_count = 0;
+    std::vector<uint64_t> batch(sample_count);
+    scrambled_generator.Fill(batch.data(), sample_count);
+
+    for(auto sample : batch){
+      EXPECT_TRUE(sample >= 1);
+      EXPECT_TRUE(sample <= 1000);
+      hottest_count += (sample == hottest_key);
+    }
+
+    // Inserts do not move the hot keys
+    EXPECT_GT(hottest_count, sample_count / 20);
+
+    upper_bound += 1;
+    scrambled_generator.SetItemCount(upper_bound);
+  }
+
+}
+
+TEST(DistributionTest, HotspotFraction) {
+
+  size_t upper_bound = 1000;
+  size_t sample_count = 1000 * 1000;
+
+  HotspotDistribution hotspot_generator(upper_bound, 0.1, 0.9, 6);
+  HotspotDistribution batch_generator(upper_bound, 0.1, 0.9, 6);
+
+  std::vector<uint64_t> batch(sample_count);
+  batch_generator.Fill(batch.data(), sample_count);
+
+  size_t hot_count = 0;
+  for(size_t sample_itr = 0; sample_itr < sample_count; sample_itr++){
+    auto sample = hotspot_generator.GetNextNumber();
+    EXPECT_TRUE(sample >= 1);
+    EXPECT_TRUE(sample <= upper_bound);
+    EXPECT_EQ(sample, batch[sample_itr]);
+    hot_count += (sample <= 100);
+  }
+
+  EXPECT_NEAR(hot_count, 0.9 * sample_count, 0.01 * sample_count);
+
+}
+
+TEST(DistributionTest, LatestFollowsInserts) {
+
+  size_t upper_bound = 1000;
+  size_t sample_count = 100 * 1000;
+
+  LatestDistribution latest_generator(upper_bound, 0.99, 7);
+
+  for(size_t round = 0; round < 10; round++){
+    size_t recent_count = 0;
+    std::vector<uint64_t> batch(sample_count);
+    latest_generator.Fill(batch.data(), sample_count);
+
+    for(auto sample : batch){
+      EXPECT_TRUE(sample >= 1);
+      EXPECT_TRUE(sample <= upper_bound);
+      recent_count += (sample > upper_bound - 10);
+    }
+
+    // The ten newest keys are the ten hottest ones
+    EXPECT_GT(recent_count, sample_count / 4);
+
+    upper_bound += 100;
+    latest_generator.SetItemCount(upper_bound);
+  }
+
+}
+
+TEST(DistributionTest, FastZipfFill) {
+
+  size_t upper_bound = 1000;
+  double theta = 1.0;
+
+  FastZipfDistribution zipf_generator(upper_bound, theta, 8);
+  std::vector<uint64_t> batch(1000 * 1000);
+  zipf_generator.Fill(batch.data(), batch.size());
+
+  size_t rank_1 = 0;
+  for(auto sample : batch){
+    EXPECT_TRUE(sample >= 1);
+    EXPECT_TRUE(sample <= upper_bound);
+    rank_1 += (sample == 1);
+  }
+
+  double expected_1 = batch.size() / ComputeZeta(upper_bound, theta);
+  EXPECT_NEAR(rank_1, expected_1, 5 * sqrt(expected_1));
+
+}
+
 }  // End machine namespace
@@ -0,0 +1,110 @@
+// EVENT ENGINE TEST
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "configuration.h"
+#include "device.h"
+#include "event_engine.h"
+
+namespace machine {
+
+// Elapsed time for operation_count NVM reads issued by client_count clients
+double RunNVMReads(const size_t& client_count,
+                   const size_t& operation_count){
+
+  std::vector<Device> devices;
+  size_t operation_itr = 0;
+
+  EventEngine engine(client_count);
+  engine.Run([&]() -> bool {
+    if(operation_itr == operation_count){
+      return false;
+    }
+    operation_itr++;
+    GetReadLatency(devices, DEVICE_TYPE_NVM, operation_itr);
+    return true;
+  });
+
+  return engine.GetElapsedTime();
+}
+
+TEST(EventEngineTest, ClientScaling) {
+
+  configuration state;
+  state.nvm_read_latency = 4;
+  state.nvm_write_latency = 8;
+  state.ftl_overprovisioning = 0;
+  state.migration_queue_depth = 0;
+  state.inclusion_type = INCLUSION_TYPE_INCLUSIVE;
+  BootstrapDeviceMetrics(state);
+
+  size_t operation_count = 1024;
+  auto nvm_parallelism = GetDeviceParallelism(DEVICE_TYPE_NVM);
+
+  std::vector<Device> devices;
+  auto read_latency = GetReadLatency(devices, DEVICE_TYPE_NVM, 0);
+
+  // One client sees the bare device latency
+  auto serial_time = RunNVMReads(1, operation_count);
+  EXPECT_DOUBLE_EQ(serial_time, operation_count * read_latency);
+
+  // Clients up to the device parallelism overlap perfectly
+  auto parallel_time = RunNVMReads(nvm_parallelism, operation_count);
+  EXPECT_DOUBLE_EQ(parallel_time, serial_time / nvm_parallelism);
+
+  // Extra clients only queue up
+  auto saturated_time = RunNVMReads(4 * nvm_parallelism, operation_count);
+  EXPECT_DOUBLE_EQ(saturated_time, parallel_time);
+
+}
+
+TEST(EventEngineTest, WaitForDevice) {
+
+  configuration state;
+  state.nvm_read_latency = 4;
+  state.nvm_write_latency = 8;
+  state.ftl_overprovisioning = 0;
+  state.migration_queue_depth = 0;
+  state.inclusion_type = INCLUSION_TYPE_INCLUSIVE;
+  BootstrapDeviceMetrics(state);
+
+  // Fractional stalls are kept in the serial replay
+  EXPECT_DOUBLE_EQ(WaitForDevice(GetDeviceClock() + 0.25), 0.25);
+  EXPECT_DOUBLE_EQ(WaitForDevice(GetDeviceClock()), 0);
+
+  std::vector<Device> devices;
+  double read_latency = GetReadLatency(devices, DEVICE_TYPE_NVM, 0);
+  size_t operation_count = 16;
+
+  // A read, then a wait for a background access that completes
+  // ready_delay after the operation is issued
+  auto run_operations = [&](const double& ready_delay){
+    size_t operation_itr = 0;
+    EventEngine engine(1);
+    engine.Run([&]() -> bool {
+      if(operation_itr == operation_count){
+        return false;
+      }
+      operation_itr++;
+      auto issue_time = GetDeviceClock();
+      GetReadLatency(devices, DEVICE_TYPE_NVM, operation_itr);
+      WaitForDevice(issue_time + ready_delay);
+      return true;
+    });
+    return engine.GetElapsedTime();
+  };
+
+  // The access is ready before the read completes: no stall
+  EXPECT_DOUBLE_EQ(run_operations(read_latency / 2),
+                   operation_count * read_latency);
+
+  // Otherwise the operation waits until it is ready, not for the stall
+  // seen at issue on top of the read
+  EXPECT_DOUBLE_EQ(run_operations(1.5 * read_latency),
+                   operation_count * 1.5 * read_latency);
+
+}
+
+}  // End machine namespace
@@ -0,0 +1,62 @@
+// FLUSHER TEST
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <vector>
+
+#include "flusher.h"
+
+namespace machine {
+
+TEST(FlusherTest, Interval) {
+
+  DirtyFlusher flusher(3, 0.5, 0.25);
+
+  for(size_t operation_itr = 1; operation_itr <= 9; operation_itr++){
+    EXPECT_EQ(flusher.Tick(), operation_itr % 3 == 0);
+  }
+
+}
+
+TEST(FlusherTest, Watermarks) {
+
+  DirtyFlusher flusher(1, 0.5, 0.25);
+  std::vector<size_t> flush_blocks;
+
+  // Half dirty does not pass the high watermark
+  std::vector<size_t> dirty_blocks = {9, 3, 7, 1, 5};
+  flusher.Plan(DEVICE_TYPE_DRAM, dirty_blocks, 10, flush_blocks);
+  EXPECT_TRUE(flush_blocks.empty());
+
+  // Eight dirty blocks are cleaned down to two, in ascending order
+  dirty_blocks = {9, 3, 7, 1, 5, 2, 8, 4};
+  flusher.Plan(DEVICE_TYPE_DRAM, dirty_blocks, 10, flush_blocks);
+  EXPECT_EQ(flush_blocks, std::vector<size_t>({1, 2, 3, 4, 5, 7}));
+
+}
+
+TEST(FlusherTest, SweepAndRuns) {
+
+  DirtyFlusher flusher(1, 0.5, 0.25);
+
+  // First batch stops after block 5
+  std::vector<size_t> dirty_blocks = {1, 2, 3, 4, 5, 7, 8, 9};
+  std::vector<size_t> flush_blocks;
+  flusher.Plan(DEVICE_TYPE_DRAM, dirty_blocks, 10, flush_blocks);
+  EXPECT_EQ(flush_blocks, std::vector<size_t>({1, 2, 3, 4, 5, 7}));
+
+  // Next batch resumes at the cursor and wraps around
+  dirty_blocks = {1, 2, 3, 4, 8, 9, 10, 11};
+  flush_blocks.clear();
+  flusher.Plan(DEVICE_TYPE_DRAM, dirty_blocks, 10, flush_blocks);
+  EXPECT_EQ(flush_blocks, std::vector<size_t>({1, 2, 8, 9, 10, 11}));
+
+  // Two batches, twelve blocks in four runs
+  std::stringstream output;
+  output << flusher;
+  EXPECT_NE(output.str().find("DRAM :: 2 12 4"), std::string::npos);
+
+}
+
+}  // End machine namespace
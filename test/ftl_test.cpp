@@ -0,0 +1,148 @@
+// FLASH TRANSLATION LAYER TEST
+
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <vector>
+
+#include "ftl.h"
+
+namespace machine {
+
+const size_t ftl_test_page_count = 64 * 1024;
+const size_t ftl_test_block_pages = 64;
+
+// Write amplification of random overwrites after a full bootstrap
+double GetRandomWriteAmplification(const double& overprovisioning){
+
+  FlashTranslationLayer ftl(overprovisioning, ftl_test_block_pages, 1, 1, 1);
+  for(size_t page = 0; page < ftl_test_page_count; page++){
+    ftl.Bootstrap(page);
+  }
+
+  srand(50);
+  size_t write_count = 4 * ftl_test_page_count;
+  size_t relocated_page_count = 0;
+  for(size_t write_itr = 0; write_itr < write_count; write_itr++){
+    auto flash_write = ftl.Write(rand() % ftl_test_page_count);
+    relocated_page_count += flash_write.relocated_page_count;
+  }
+
+  return (double) (write_count + relocated_page_count) / write_count;
+}
+
+TEST(FTLTest, SequentialOverwrite) {
+
+  FlashTranslationLayer ftl(0.1, ftl_test_block_pages, 10, 20, 1000);
+  for(size_t page = 0; page < ftl_test_page_count; page++){
+    ftl.Bootstrap(page);
+  }
+  EXPECT_EQ(ftl.GetLogicalPageCount(), ftl_test_page_count);
+
+  // Whole blocks go stale, so collection never copies a page
+  size_t erased_block_count = 0;
+  for(size_t round = 0; round < 3; round++){
+    for(size_t page = 0; page < ftl_test_page_count; page++){
+      auto flash_write = ftl.Write(page);
+      EXPECT_EQ(flash_write.relocated_page_count, 0);
+      EXPECT_DOUBLE_EQ(flash_write.stall,
+                       flash_write.erased_block_count * 1000);
+      erased_block_count += flash_write.erased_block_count;
+    }
+  }
+
+  EXPECT_GT(erased_block_count, 0);
+  EXPECT_EQ(ftl.GetLogicalPageCount(), ftl_test_page_count);
+
+}
+
+TEST(FTLTest, RandomOverwrite) {
+
+  auto tight_write_amplification = GetRandomWriteAmplification(0.07);
+  auto spare_write_amplification = GetRandomWriteAmplification(0.5);
+
+  // Garbage collection copies pages, less so with more spare blocks
+  EXPECT_GT(tight_write_amplification, spare_write_amplification);
+  EXPECT_GT(spare_write_amplification, 1.0);
+
+}
+
+TEST(FTLTest, StallOnTriggeringWrite) {
+
+  // One spare block beyond the reserve
+  FlashTranslationLayer ftl(0, ftl_test_block_pages, 10, 20, 1000);
+
+  // Fill the flash, then overwrite one page per block
+  for(size_t page = 0; page < ftl_test_page_count; page++){
+    ftl.Write(page);
+  }
+  auto block_count = ftl.GetBlockCount();
+  EXPECT_GE(block_count * ftl_test_block_pages, ftl_test_page_count);
+
+  size_t stalled_write_count = 0;
+  for(size_t page = 0; page < ftl_test_page_count; page += ftl_test_block_pages){
+    auto flash_write = ftl.Write(page);
+    if(flash_write.stall > 0){
+      stalled_write_count++;
+      EXPECT_DOUBLE_EQ(flash_write.stall,
+                       flash_write.relocated_page_count * 30 +
+                       flash_write.erased_block_count * 1000);
+    }
+  }
+
+  EXPECT_GT(stalled_write_count, 0);
+  EXPECT_EQ(ftl.GetBlockCount(), block_count);
+
+}
+
+TEST(FTLTest, SnapshotValidation) {
+
+  FlashTranslationLayer ftl(0.25, 8, 10, 20, 1000);
+  for(size_t page = 0; page < 256; page++){
+    ftl.Bootstrap(page);
+  }
+  srand(50);
+  for(size_t write_itr = 0; write_itr < 1024; write_itr++){
+    ftl.Write(rand() % 256);
+  }
+
+  std::vector<uint64_t> buffer;
+  ftl.Serialize(buffer);
+  const uint64_t* end = buffer.data() + buffer.size();
+
+  // The restored flash collects garbage exactly like the original
+  FlashTranslationLayer restored_ftl(0.25, 8, 10, 20, 1000);
+  const uint64_t* cursor = buffer.data();
+  restored_ftl.Deserialize(cursor, end);
+  EXPECT_EQ(cursor, end);
+  EXPECT_EQ(restored_ftl.GetBlockCount(), ftl.GetBlockCount());
+  EXPECT_EQ(restored_ftl.GetLogicalPageCount(), 256);
+  for(size_t write_itr = 0; write_itr < 1024; write_itr++){
+    auto page = rand() % 256;
+    auto flash_write = ftl.Write(page);
+    auto restored_flash_write = restored_ftl.Write(page);
+    EXPECT_EQ(restored_flash_write.relocated_page_count,
+              flash_write.relocated_page_count);
+    EXPECT_EQ(restored_flash_write.erased_block_count,
+              flash_write.erased_block_count);
+  }
+
+  // A layout with too few blocks for the spare capacity
+  FlashTranslationLayer spare_ftl(1.0, 8, 10, 20, 1000);
+  cursor = buffer.data();
+  EXPECT_EXIT(spare_ftl.Deserialize(cursor, end),
+              ::testing::ExitedWithCode(EXIT_FAILURE), "");
+
+  // A free block past the last erase block
+  auto block_count = buffer[2];
+  auto free_block_count = buffer[3 + block_count];
+  ASSERT_GT(free_block_count, 0);
+  buffer[4 + block_count] = block_count;
+  FlashTranslationLayer corrupt_ftl(0.25, 8, 10, 20, 1000);
+  cursor = buffer.data();
+  EXPECT_EXIT(corrupt_ftl.Deserialize(cursor, end),
+              ::testing::ExitedWithCode(EXIT_FAILURE), "");
+
+}
+
+}  // End machine namespace
@@ -0,0 +1,97 @@
+// MIGRATION TEST
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "configuration.h"
+#include "device.h"
+#include "migration.h"
+
+namespace machine {
+
+TEST(MigrationTest, QueueDepth) {
+
+  MigrationQueue migration_queue(2, 0, 4096);
+
+  // Two jobs are admitted right away
+  for(size_t job_itr = 0; job_itr < 2; job_itr++){
+    auto admission_time = migration_queue.Admit(0);
+    EXPECT_DOUBLE_EQ(admission_time, 0);
+    auto start_time = migration_queue.GetStartTime(admission_time);
+    migration_queue.Complete(job_itr, start_time, 100 * (job_itr + 1));
+  }
+
+  // The third waits for the first to finish
+  EXPECT_DOUBLE_EQ(migration_queue.Admit(0), 100);
+
+  // Finished jobs free their slots
+  EXPECT_DOUBLE_EQ(migration_queue.Admit(500), 500);
+
+}
+
+TEST(MigrationTest, BandwidthBudget) {
+
+  // 4K block at 1000 MB/s takes 4096 ns
+  MigrationQueue migration_queue(16, 1000, 4096);
+
+  auto start_time = migration_queue.GetStartTime(0);
+  EXPECT_DOUBLE_EQ(migration_queue.Complete(1, start_time, 100), 4096);
+
+  // The next job is paced behind the first one
+  start_time = migration_queue.GetStartTime(0);
+  EXPECT_DOUBLE_EQ(start_time, 4096);
+  EXPECT_DOUBLE_EQ(migration_queue.Complete(2, start_time, start_time + 100),
+                   2 * 4096);
+
+}
+
+TEST(MigrationTest, BlockInFlight) {
+
+  MigrationQueue migration_queue(4, 0, 4096);
+  migration_queue.Complete(7, 0, 300);
+
+  double ready_time = 0;
+  EXPECT_TRUE(migration_queue.IsInFlight(7, 100, ready_time));
+  EXPECT_DOUBLE_EQ(ready_time, 300);
+  EXPECT_FALSE(migration_queue.IsInFlight(8, 100, ready_time));
+
+  // Done once the job completes
+  EXPECT_FALSE(migration_queue.IsInFlight(7, 300, ready_time));
+
+}
+
+TEST(MigrationTest, WriteBackOffCriticalPath) {
+
+  configuration state;
+  state.nvm_read_latency = 4;
+  state.nvm_write_latency = 8;
+  state.ftl_overprovisioning = 0;
+  state.migration_queue_depth = 1;
+  state.inclusion_type = INCLUSION_TYPE_INCLUSIVE;
+  state.migration_bandwidth = 0;
+  BootstrapDeviceMetrics(state);
+
+  std::vector<Device> devices;
+  double total_duration = 0;
+
+  // The job is served in the background and not charged
+  EXPECT_TRUE(BeginMigration(total_duration));
+  EXPECT_EQ(GetWriteLatency(devices, DEVICE_TYPE_NVM, 5), 0);
+  EndMigration(5);
+  EXPECT_DOUBLE_EQ(total_duration, 0);
+
+  // A second job waits for the only slot
+  auto write_latency = 100 * state.nvm_write_latency;
+  EXPECT_TRUE(BeginMigration(total_duration));
+  GetWriteLatency(devices, DEVICE_TYPE_NVM, 6);
+  EndMigration(6);
+  EXPECT_DOUBLE_EQ(total_duration, write_latency);
+
+  // The foreground waits only for the block in flight
+  EXPECT_EQ(WaitForMigration(5), 0);
+  EXPECT_EQ(WaitForMigration(6), write_latency);
+
+}
+
+}  // End machine namespace
@@ -0,0 +1,177 @@
+// 2Q TEST
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "policy_2q.h"
+#include "cache.h"
+
+namespace machine {
+
+template <typename Key, typename Value>
+using two_q_cache_t = Cache<Key, Value, TwoQCachePolicy<Key>>;
+
+template <typename Key, typename Value>
+using lru_cache_t = Cache<Key, Value, LRUCachePolicy<Key>>;
+
+// Access a hot set, then a scan of new keys, round after round, and
+// count the hot keys left in the cache
+template <typename CacheType>
+size_t GetResidentHotKeys(CacheType& cache,
+                          const int& hot_count,
+                          const int& scan_length,
+                          const int& round_count) {
+  int scan_key = 1000;
+  for (int round = 0; round < round_count; ++round) {
+    for (int i = 0; i < hot_count; ++i) {
+      cache.Put(i, i);
+    }
+    for (int i = 0; i < scan_length; ++i, ++scan_key) {
+      cache.Put(scan_key, scan_key);
+    }
+  }
+
+  std::vector<int> keys;
+  cache.GetKeys(keys);
+  return std::count_if(keys.begin(), keys.end(),
+                       [&](int key) { return key < hot_count; });
+}
+
+TEST(TwoQCache, SimplePut) {
+  size_t cache_capacity = 1;
+  two_q_cache_t<int, int> cache(cache_capacity);
+
+  cache.Put(1, 666);
+
+  EXPECT_EQ(cache.Get(1), 666);
+}
+
+TEST(TwoQCache, MissingValue) {
+  size_t cache_capacity = 1;
+  two_q_cache_t<int, int> cache(cache_capacity);
+
+  EXPECT_THROW(cache.Get(0), std::range_error);
+}
+
+TEST(TwoQCache, SecondMissEntersAm) {
+  size_t cache_capacity = 4;
+  two_q_cache_t<int, int> cache(cache_capacity);
+
+  cache.Put(1, 1);
+  cache.Put(2, 2);
+  cache.Put(3, 3);
+  cache.Put(4, 4);
+
+  // A hit in A1in does not protect key 1
+  cache.Put(1, 1);
+  auto victim = cache.Put(5, 5);
+  EXPECT_EQ(victim.block_id, 1);
+
+  // Missed again while in A1out, key 1 enters Am
+  victim = cache.Put(1, 1);
+  EXPECT_EQ(victim.block_id, 2);
+
+  // A1in keeps losing its oldest keys while it is over its share
+  victim = cache.Put(6, 6);
+  EXPECT_EQ(victim.block_id, 3);
+  victim = cache.Put(7, 7);
+  EXPECT_EQ(victim.block_id, 4);
+
+  std::vector<int> keys;
+  cache.GetKeys(keys);
+  std::sort(keys.begin(), keys.end());
+  EXPECT_EQ(keys, std::vector<int>({1, 5, 6, 7}));
+}
+
+TEST(TwoQCache, EraseAnyKey) {
+  size_t cache_capacity = 4;
+  two_q_cache_t<int, int> cache(cache_capacity);
+
+  cache.Put(1, 1);
+  cache.Put(2, 2);
+  cache.Put(3, 3);
+  cache.Put(4, 4);
+
+  // Drop a block that is not the victim
+  cache.Erase(2);
+  EXPECT_EQ(cache.CurrentCapacity(), 3);
+  EXPECT_THROW(cache.Get(2), std::range_error);
+
+  // The freed slot is reused before anything is evicted
+  auto victim = cache.Put(5, 5);
+  EXPECT_EQ(victim.block_id, INVALID_KEY);
+
+  // The erased key is remembered in A1out like an evicted one, so it
+  // comes back into Am
+  victim = cache.Put(2, 2);
+  EXPECT_EQ(victim.block_id, 1);
+  victim = cache.Put(6, 6);
+  EXPECT_EQ(victim.block_id, 3);
+  victim = cache.Put(7, 7);
+  EXPECT_EQ(victim.block_id, 4);
+
+  std::vector<int> keys;
+  cache.GetKeys(keys);
+  std::sort(keys.begin(), keys.end());
+  EXPECT_EQ(keys, std::vector<int>({2, 5, 6, 7}));
+}
+
+TEST(TwoQCache, ScanResistance) {
+  size_t cache_capacity = 100;
+  two_q_cache_t<int, int> cache(cache_capacity);
+  lru_cache_t<int, int> lru_cache(cache_capacity);
+
+  // Hot keys reused within the reach of A1out move to Am, where the
+  // scans cannot reach them
+  EXPECT_EQ(GetResidentHotKeys(cache, 20, 90, 20), 20);
+  EXPECT_EQ(GetResidentHotKeys(lru_cache, 20, 90, 20), 10);
+}
+
+TEST(TwoQCache, BoundedGhosts) {
+  size_t cache_capacity = 100;
+  two_q_cache_t<int, int> cache(cache_capacity);
+  two_q_cache_t<int, int> long_cache(cache_capacity);
+
+  // A1out stops growing at half of the capacity
+  GetResidentHotKeys(cache, 0, 1000, 1);
+  GetResidentHotKeys(long_cache, 0, 10000, 1);
+
+  std::vector<uint64_t> buffer;
+  std::vector<uint64_t> long_buffer;
+  cache.Serialize(buffer);
+  long_cache.Serialize(long_buffer);
+  EXPECT_EQ(buffer.size(), long_buffer.size());
+}
+
+TEST(TwoQCache, SnapshotRoundTrip) {
+  constexpr int CACHE_CAPACITY = 5;
+  const int TEST_RECORDS = 20;
+  two_q_cache_t<int, int> cache(CACHE_CAPACITY);
+  two_q_cache_t<int, int> restored_cache(CACHE_CAPACITY);
+
+  for (int i = 0; i < TEST_RECORDS; ++i) {
+    cache.Put(i % 7, i);
+    cache.Put(i % 3, i);
+  }
+
+  std::vector<uint64_t> buffer;
+  cache.Serialize(buffer);
+  const uint64_t* cursor = buffer.data();
+  const uint64_t* end = buffer.data() + buffer.size();
+  restored_cache.Deserialize(cursor, end);
+  EXPECT_EQ(cursor, end);
+
+  // Both caches evict the same blocks from now on
+  for (int i = TEST_RECORDS; i < 2 * TEST_RECORDS; ++i) {
+    auto victim = cache.Put(i % 11, i);
+    auto restored_victim = restored_cache.Put(i % 11, i);
+    EXPECT_EQ(victim.block_id, restored_victim.block_id);
+    EXPECT_EQ(victim.block_type, restored_victim.block_type);
+  }
+
+  EXPECT_EQ(cache.CurrentCapacity(), restored_cache.CurrentCapacity());
+}
+
+}  // End machine namespace
@@ -139,4 +139,50 @@ TEST(ARCCache, KeepsAllValuesWithinCapacity) {
   }
 }
 
+TEST(ARCCache, VictimIsResident) {
+  constexpr int CACHE_CAPACITY = 10;
+  arc_cache_t<int, int> cache(CACHE_CAPACITY);
+
+  // Random reuse hits the ghost lists and moves the target p. The victim
+  // must be decided with the same p as the insertion, or the policy picks
+  // a key that is no longer cached.
+  uint64_t seed = 1;
+  for (int i = 0; i < 10000; ++i) {
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    int key = (seed >> 33) % 30;
+    EXPECT_NO_THROW(cache.Put(key, key));
+  }
+
+  EXPECT_EQ(cache.CurrentCapacity(), CACHE_CAPACITY);
+}
+
+TEST(ARCCache, SnapshotRoundTrip) {
+  constexpr int CACHE_CAPACITY = 5;
+  const int TEST_RECORDS = 20;
+  arc_cache_t<int, int> cache(CACHE_CAPACITY);
+  arc_cache_t<int, int> restored_cache(CACHE_CAPACITY);
+
+  for (int i = 0; i < TEST_RECORDS; ++i) {
+    cache.Put(i, i);
+    cache.Put(i, i);
+  }
+
+  std::vector<uint64_t> buffer;
+  cache.Serialize(buffer);
+  const uint64_t* cursor = buffer.data();
+  const uint64_t* end = buffer.data() + buffer.size();
+  restored_cache.Deserialize(cursor, end);
+  EXPECT_EQ(cursor, end);
+
+  // Both caches evict the same blocks from now on
+  for (int i = TEST_RECORDS; i < 2 * TEST_RECORDS; ++i) {
+    auto victim = cache.Put(i, i);
+    auto restored_victim = restored_cache.Put(i, i);
+    EXPECT_EQ(victim.block_id, restored_victim.block_id);
+    EXPECT_EQ(victim.block_type, restored_victim.block_type);
+  }
+
+  EXPECT_EQ(cache.CurrentCapacity(), restored_cache.CurrentCapacity());
+}
+
 }  // End machine namespace
@@ -0,0 +1,187 @@
+// POLICY BENCHMARK
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "configuration.h"
+#include "distribution.h"
+#include "cache.h"
+
+namespace machine {
+
+configuration state;
+
+// Cache capacity as a fraction of the key space
+const double bench_cache_ratio = 0.1;
+
+// Default number of accesses in each synthetic trace
+const size_t bench_access_count = 1000 * 1000;
+
+enum TraceType {
+  TRACE_TYPE_INVALID = 0,
+
+  TRACE_TYPE_ZIPF = 1,
+  TRACE_TYPE_SCAN = 2,
+  TRACE_TYPE_LOOP = 3
+
+};
+
+std::string TraceTypeToString(const TraceType& trace_type){
+
+  switch (trace_type){
+    case TRACE_TYPE_ZIPF:
+      return "ZIPF";
+    case TRACE_TYPE_SCAN:
+      return "SCAN";
+    case TRACE_TYPE_LOOP:
+      return "LOOP";
+    default:
+      return "INVALID";
+  }
+
+}
+
+// Skewed accesses over the key space
+void GenerateZipfTrace(std::vector<int>& trace,
+                       const size_t& access_count){
+
+  ScrambledZipfDistribution zipf_generator(state.key_count,
+                                           state.zipf_theta,
+                                           generator_seed);
+
+  while(trace.size() < access_count){
+    trace.push_back(zipf_generator.GetNextNumber() - 1);
+  }
+
+}
+
+// Skewed accesses interrupted by one-time scans twice the cache size
+void GenerateScanTrace(std::vector<int>& trace,
+                       const size_t& access_count,
+                       const size_t& capacity){
+
+  ScrambledZipfDistribution zipf_generator(state.key_count,
+                                           state.zipf_theta,
+                                           generator_seed);
+
+  // Scanned keys lie past the key space and are never reused
+  int scan_key = state.key_count;
+  while(trace.size() < access_count){
+    for(size_t access_itr = 0; access_itr < 4 * capacity; access_itr++){
+      trace.push_back(zipf_generator.GetNextNumber() - 1);
+    }
+    for(size_t access_itr = 0; access_itr < 2 * capacity; access_itr++){
+      trace.push_back(scan_key++);
+    }
+  }
+
+  trace.resize(access_count);
+
+}
+
+// Repeated sequential loop over one and a half times the cache size
+void GenerateLoopTrace(std::vector<int>& trace,
+                       const size_t& access_count,
+                       const size_t& capacity){
+
+  size_t loop_length = capacity + capacity/2;
+  while(trace.size() < access_count){
+    trace.push_back(trace.size() % loop_length);
+  }
+
+}
+
+// Replay the trace as the tiers do: a put of a resident key is a hit
+template <typename Policy>
+void ReplayTrace(const std::string& policy_name,
+                 const TraceType& trace_type,
+                 const std::vector<int>& trace,
+                 const size_t& capacity){
+
+  Cache<int, int, Policy> cache(capacity);
+  size_t hit_count = 0;
+
+  auto start = std::chrono::steady_clock::now();
+
+  for(auto key : trace){
+    auto resident_count = cache.CurrentCapacity();
+    auto victim = cache.Put(key, CLEAN_BLOCK);
+    if(victim.block_id == INVALID_KEY &&
+        cache.CurrentCapacity() == resident_count){
+      hit_count++;
+    }
+  }
+
+  auto end = std::chrono::steady_clock::now();
+  std::chrono::duration<double, std::nano> elapsed = end - start;
+
+  printf("%-10s %-6s %10lu %10lu %10.2f %10.1f\n",
+         policy_name.c_str(),
+         TraceTypeToString(trace_type).c_str(),
+         trace.size(),
+         capacity,
+         (100.0 * hit_count)/trace.size(),
+         elapsed.count()/trace.size());
+
+}
+
+void RunPolicyBenchmark(){
+
+  auto access_count = state.operation_count;
+  if(access_count == 0){
+    access_count = bench_access_count;
+  }
+  size_t capacity = std::max<size_t>(1, state.key_count * bench_cache_ratio);
+
+  std::vector<TraceType> trace_types = {
+      TRACE_TYPE_ZIPF,
+      TRACE_TYPE_SCAN,
+      TRACE_TYPE_LOOP
+  };
+
+  std::vector<std::vector<int>> traces(trace_types.size());
+  for(auto& trace : traces){
+    trace.reserve(access_count);
+  }
+  GenerateZipfTrace(traces[0], access_count);
+  GenerateScanTrace(traces[1], access_count, capacity);
+  GenerateLoopTrace(traces[2], access_count, capacity);
+
+  printf("%-10s %-6s %10s %10s %10s %10s\n",
+         "policy", "trace", "accesses", "capacity", "hit (%)", "ns/access");
+
+  for(size_t trace_itr = 0; trace_itr < trace_types.size(); trace_itr++){
+    auto trace_type = trace_types[trace_itr];
+    auto& trace = traces[trace_itr];
+    ReplayTrace<FIFOCachePolicy<int>>("FIFO", trace_type, trace, capacity);
+    ReplayTrace<LRUCachePolicy<int>>("LRU", trace_type, trace, capacity);
+    ReplayTrace<LFUCachePolicy<int>>("LFU", trace_type, trace, capacity);
+    ReplayTrace<ARCCachePolicy<int>>("ARC", trace_type, trace, capacity);
+    ReplayTrace<CLOCKCachePolicy<int>>("CLOCK", trace_type, trace, capacity);
+    ReplayTrace<CLOCKProCachePolicy<int>>("CLOCK-PRO", trace_type, trace,
+                                          capacity);
+    ReplayTrace<WTinyLFUCachePolicy<int>>("W-TINYLFU", trace_type, trace,
+                                          capacity);
+    ReplayTrace<LIRSCachePolicy<int>>("LIRS", trace_type, trace, capacity);
+    ReplayTrace<TwoQCachePolicy<int>>("2Q", trace_type, trace, capacity);
+  }
+
+}
+
+}  // namespace machine
+
+int main(int argc, char **argv) {
+
+  // Initialize Google's logging library.
+  google::InitGoogleLogging(argv[0]);
+
+  machine::ParseArguments(
+      argc, argv, machine::state);
+
+  machine::RunPolicyBenchmark();
+
+  return 0;
+}
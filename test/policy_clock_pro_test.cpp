@@ -0,0 +1,147 @@
+// CLOCK-PRO TEST
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "policy_clock_pro.h"
+#include "cache.h"
+
+namespace machine {
+
+template <typename Key, typename Value>
+using clock_pro_cache_t = Cache<Key, Value, CLOCKProCachePolicy<Key>>;
+
+TEST(CLOCKProCache, SimplePut) {
+  size_t cache_capacity = 1;
+  clock_pro_cache_t<int, int> cache(cache_capacity);
+
+  cache.Put(1, 666);
+
+  EXPECT_EQ(cache.Get(1), 666);
+}
+
+TEST(CLOCKProCache, MissingValue) {
+  size_t cache_capacity = 1;
+  clock_pro_cache_t<int, int> cache(cache_capacity);
+
+  EXPECT_THROW(cache.Get(0), std::range_error);
+}
+
+TEST(CLOCKProCache, KeepsAllValuesWithinCapacity) {
+  constexpr int CACHE_CAPACITY = 50;
+  const int TEST_RECORDS = 100;
+  clock_pro_cache_t<int, int> cache(CACHE_CAPACITY);
+
+  for (int i = 0; i < TEST_RECORDS; ++i) {
+    cache.Put(i, i);
+  }
+
+  for (int i = 0; i < TEST_RECORDS - CACHE_CAPACITY; ++i) {
+    EXPECT_THROW(cache.Get(i), std::range_error);
+  }
+
+  for (int i = TEST_RECORDS - CACHE_CAPACITY; i < TEST_RECORDS; ++i) {
+    EXPECT_EQ(i, cache.Get(i));
+  }
+
+}
+
+TEST(CLOCKProCache, EraseAnyKey) {
+  size_t cache_capacity = 3;
+  clock_pro_cache_t<int, int> cache(cache_capacity);
+
+  cache.Put(1, 1);
+  cache.Put(2, 2);
+  cache.Put(3, 3);
+
+  // Drop a block that is not the victim
+  cache.Erase(2);
+  EXPECT_EQ(cache.CurrentCapacity(), 2);
+  EXPECT_THROW(cache.Get(2), std::range_error);
+
+  // The freed slot is reused before anything is evicted
+  auto victim = cache.Put(4, 4);
+  EXPECT_EQ(victim.block_id, INVALID_KEY);
+
+  victim = cache.Put(5, 5);
+  EXPECT_EQ(victim.block_id, 1);
+
+  std::vector<int> keys;
+  cache.GetKeys(keys);
+  std::sort(keys.begin(), keys.end());
+  EXPECT_EQ(keys, std::vector<int>({3, 4, 5}));
+
+}
+
+TEST(CLOCKProCache, ScanResistance) {
+  size_t cache_capacity = 10;
+  clock_pro_cache_t<int, int> cache(cache_capacity);
+
+  // Keys reused during their test period become hot
+  for (int i = 0; i < 5; ++i) {
+    cache.Put(i, i);
+    cache.Get(i);
+  }
+
+  // A one-time scan only goes through the cold keys
+  for (int i = 100; i < 200; ++i) {
+    cache.Put(i, i);
+  }
+
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_EQ(i, cache.Get(i));
+  }
+
+}
+
+TEST(CLOCKProCache, ReusedTestKeyComesBackHot) {
+  size_t cache_capacity = 4;
+  clock_pro_cache_t<int, int> cache(cache_capacity);
+
+  for (int i = 1; i <= 5; ++i) {
+    cache.Put(i, i);
+  }
+  EXPECT_THROW(cache.Get(1), std::range_error);
+
+  // Missed during its non-resident test period
+  cache.Put(1, 1);
+
+  for (int i = 6; i < 20; ++i) {
+    cache.Put(i, i);
+  }
+  EXPECT_EQ(1, cache.Get(1));
+
+}
+
+TEST(CLOCKProCache, SnapshotRoundTrip) {
+  constexpr int CACHE_CAPACITY = 5;
+  const int TEST_RECORDS = 20;
+  clock_pro_cache_t<int, int> cache(CACHE_CAPACITY);
+  clock_pro_cache_t<int, int> restored_cache(CACHE_CAPACITY);
+
+  for (int i = 0; i < TEST_RECORDS; ++i) {
+    cache.Put(i % 7, i);
+    cache.Put(i % 3, i);
+  }
+
+  std::vector<uint64_t> buffer;
+  cache.Serialize(buffer);
+  const uint64_t* cursor = buffer.data();
+  const uint64_t* end = buffer.data() + buffer.size();
+  restored_cache.Deserialize(cursor, end);
+  EXPECT_EQ(cursor, end);
+
+  // Both caches evict the same blocks from now on
+  for (int i = TEST_RECORDS; i < 2 * TEST_RECORDS; ++i) {
+    auto victim = cache.Put(i % 11, i);
+    auto restored_victim = restored_cache.Put(i % 11, i);
+    EXPECT_EQ(victim.block_id, restored_victim.block_id);
+    EXPECT_EQ(victim.block_type, restored_victim.block_type);
+  }
+
+  EXPECT_EQ(cache.CurrentCapacity(), restored_cache.CurrentCapacity());
+}
+
+}  // End machine namespace
@@ -0,0 +1,128 @@
+// CLOCK TEST
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "policy_clock.h"
+#include "cache.h"
+
+namespace machine {
+
+template <typename Key, typename Value>
+using clock_cache_t = Cache<Key, Value, CLOCKCachePolicy<Key>>;
+
+TEST(CLOCKCache, SimplePut) {
+  size_t cache_capacity = 1;
+  clock_cache_t<int, int> cache(cache_capacity);
+
+  cache.Put(1, 666);
+
+  EXPECT_EQ(cache.Get(1), 666);
+}
+
+TEST(CLOCKCache, MissingValue) {
+  size_t cache_capacity = 1;
+  clock_cache_t<int, int> cache(cache_capacity);
+
+  EXPECT_THROW(cache.Get(0), std::range_error);
+}
+
+TEST(CLOCKCache, KeepsAllValuesWithinCapacity) {
+  constexpr int CACHE_CAPACITY = 50;
+  const int TEST_RECORDS = 100;
+  clock_cache_t<int, int> cache(CACHE_CAPACITY);
+
+  for (int i = 0; i < TEST_RECORDS; ++i) {
+    cache.Put(i, i);
+  }
+
+  for (int i = 0; i < TEST_RECORDS - CACHE_CAPACITY; ++i) {
+    EXPECT_THROW(cache.Get(i), std::range_error);
+  }
+
+  for (int i = TEST_RECORDS - CACHE_CAPACITY; i < TEST_RECORDS; ++i) {
+    EXPECT_EQ(i, cache.Get(i));
+  }
+
+}
+
+TEST(CLOCKCache, EraseAnyKey) {
+  size_t cache_capacity = 3;
+  clock_cache_t<int, int> cache(cache_capacity);
+
+  cache.Put(1, 1);
+  cache.Put(2, 2);
+  cache.Put(3, 3);
+
+  // Drop a block that is not the victim
+  cache.Erase(2);
+  EXPECT_EQ(cache.CurrentCapacity(), 2);
+  EXPECT_THROW(cache.Get(2), std::range_error);
+
+  // The freed slot is reused before anything is evicted
+  auto victim = cache.Put(4, 4);
+  EXPECT_EQ(victim.block_id, INVALID_KEY);
+
+  victim = cache.Put(5, 5);
+  EXPECT_EQ(victim.block_id, 1);
+
+  std::vector<int> keys;
+  cache.GetKeys(keys);
+  std::sort(keys.begin(), keys.end());
+  EXPECT_EQ(keys, std::vector<int>({3, 4, 5}));
+
+}
+
+TEST(CLOCKCache, SecondChance) {
+  size_t cache_capacity = 3;
+  clock_cache_t<int, int> cache(cache_capacity);
+
+  cache.Put(1, 1);
+  cache.Put(2, 2);
+  cache.Put(3, 3);
+
+  // A hit sets the reference bit, so the hand passes over the key once
+  cache.Get(1);
+  auto victim = cache.Put(4, 4);
+  EXPECT_EQ(victim.block_id, 2);
+
+  victim = cache.Put(5, 5);
+  EXPECT_EQ(victim.block_id, 3);
+
+  victim = cache.Put(6, 6);
+  EXPECT_EQ(victim.block_id, 1);
+
+}
+
+TEST(CLOCKCache, SnapshotRoundTrip) {
+  constexpr int CACHE_CAPACITY = 5;
+  const int TEST_RECORDS = 20;
+  clock_cache_t<int, int> cache(CACHE_CAPACITY);
+  clock_cache_t<int, int> restored_cache(CACHE_CAPACITY);
+
+  for (int i = 0; i < TEST_RECORDS; ++i) {
+    cache.Put(i % 7, i);
+    cache.Put(i % 3, i);
+  }
+
+  std::vector<uint64_t> buffer;
+  cache.Serialize(buffer);
+  const uint64_t* cursor = buffer.data();
+  const uint64_t* end = buffer.data() + buffer.size();
+  restored_cache.Deserialize(cursor, end);
+  EXPECT_EQ(cursor, end);
+
+  // Both caches evict the same blocks from now on
+  for (int i = TEST_RECORDS; i < 2 * TEST_RECORDS; ++i) {
+    auto victim = cache.Put(i % 11, i);
+    auto restored_victim = restored_cache.Put(i % 11, i);
+    EXPECT_EQ(victim.block_id, restored_victim.block_id);
+    EXPECT_EQ(victim.block_type, restored_victim.block_type);
+  }
+
+  EXPECT_EQ(cache.CurrentCapacity(), restored_cache.CurrentCapacity());
+}
+
+}  // End machine namespace
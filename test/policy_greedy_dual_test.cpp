@@ -0,0 +1,166 @@
+// GREEDY-DUAL TEST
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "policy_greedy_dual.h"
+#include "cache.h"
+
+namespace machine {
+
+template <typename Key, typename Value>
+using greedy_dual_cache_t = Cache<Key, Value, GreedyDualCachePolicy<Key>>;
+
+TEST(GreedyDualCache, SimplePut) {
+  size_t cache_capacity = 1;
+  greedy_dual_cache_t<int, int> cache(cache_capacity);
+
+  cache.Put(1, DIRTY_BLOCK);
+
+  EXPECT_EQ(cache.Get(1), DIRTY_BLOCK);
+}
+
+TEST(GreedyDualCache, MissingValue) {
+  size_t cache_capacity = 1;
+  greedy_dual_cache_t<int, int> cache(cache_capacity);
+
+  EXPECT_THROW(cache.Get(0), std::range_error);
+}
+
+TEST(GreedyDualCache, EqualCostsAreLRU) {
+  size_t cache_capacity = 3;
+  greedy_dual_cache_t<int, int> cache(cache_capacity);
+
+  cache.Put(1, DIRTY_BLOCK);
+  cache.Put(2, CLEAN_BLOCK);
+  cache.Put(3, CLEAN_BLOCK);
+  cache.Get(1);
+
+  auto victim = cache.Put(4, CLEAN_BLOCK);
+  EXPECT_EQ(victim.block_id, 2);
+}
+
+TEST(GreedyDualCache, CleanFirst) {
+  size_t cache_capacity = 3;
+  greedy_dual_cache_t<int, int> cache(cache_capacity);
+  cache.SetEvictionCost(100, 300);
+
+  cache.Put(1, DIRTY_BLOCK);
+  cache.Put(2, CLEAN_BLOCK);
+  cache.Put(3, CLEAN_BLOCK);
+
+  // The older dirty block outlives clean blocks until the inflation
+  // catches up with its write-back cost
+  std::vector<size_t> victims;
+  for (int i = 4; i <= 9; ++i) {
+    victims.push_back(cache.Put(i, CLEAN_BLOCK).block_id);
+  }
+  EXPECT_EQ(victims, std::vector<size_t>({2, 3, 4, 5, 6, 7}));
+
+  auto victim = cache.Put(10, CLEAN_BLOCK);
+  EXPECT_EQ(victim.block_id, 1);
+  EXPECT_EQ(victim.block_type, DIRTY_BLOCK);
+}
+
+TEST(GreedyDualCache, StatusChange) {
+  size_t cache_capacity = 2;
+  greedy_dual_cache_t<int, int> cache(cache_capacity);
+  cache.SetEvictionCost(100, 1000);
+
+  cache.Put(1, CLEAN_BLOCK);
+  cache.Put(2, CLEAN_BLOCK);
+
+  // A write makes the block costly to evict
+  cache.Put(1, DIRTY_BLOCK);
+  auto victim = cache.Put(3, CLEAN_BLOCK);
+  EXPECT_EQ(victim.block_id, 2);
+
+  // Once flushed, it is as cheap to evict as the others
+  cache.Put(1, CLEAN_BLOCK);
+  cache.Get(3);
+  victim = cache.Put(4, CLEAN_BLOCK);
+  EXPECT_EQ(victim.block_id, 1);
+}
+
+TEST(GreedyDualCache, EraseAnyKey) {
+  size_t cache_capacity = 3;
+  greedy_dual_cache_t<int, int> cache(cache_capacity);
+  cache.SetEvictionCost(100, 300);
+
+  cache.Put(1, CLEAN_BLOCK);
+  cache.Put(2, DIRTY_BLOCK);
+  cache.Put(3, CLEAN_BLOCK);
+
+  // Dropping a block other than the victim does not inflate priorities
+  cache.Erase(2);
+  EXPECT_EQ(cache.CurrentCapacity(), 2);
+  EXPECT_THROW(cache.Get(2), std::range_error);
+
+  auto victim = cache.Put(4, DIRTY_BLOCK);
+  EXPECT_EQ(victim.block_id, INVALID_KEY);
+
+  victim = cache.Put(5, CLEAN_BLOCK);
+  EXPECT_EQ(victim.block_id, 1);
+
+  std::vector<int> keys;
+  cache.GetKeys(keys);
+  std::sort(keys.begin(), keys.end());
+  EXPECT_EQ(keys, std::vector<int>({3, 4, 5}));
+}
+
+TEST(GreedyDualCache, EraseVictimKey) {
+  size_t cache_capacity = 3;
+  greedy_dual_cache_t<int, int> cache(cache_capacity);
+  cache.SetEvictionCost(100, 300);
+
+  cache.Put(1, CLEAN_BLOCK);
+  cache.Put(2, DIRTY_BLOCK);
+
+  // Dropping the lowest priority block outside an eviction (e.g. after a
+  // migration) does not inflate priorities either
+  cache.Erase(1);
+  cache.Put(3, CLEAN_BLOCK);
+  cache.Put(4, CLEAN_BLOCK);
+
+  std::vector<size_t> victims;
+  for (int i = 5; i <= 11; ++i) {
+    victims.push_back(cache.Put(i, CLEAN_BLOCK).block_id);
+  }
+  EXPECT_EQ(victims, std::vector<size_t>({3, 4, 5, 6, 7, 8, 2}));
+}
+
+TEST(GreedyDualCache, SnapshotRoundTrip) {
+  constexpr int CACHE_CAPACITY = 5;
+  const int TEST_RECORDS = 20;
+  greedy_dual_cache_t<int, int> cache(CACHE_CAPACITY);
+  greedy_dual_cache_t<int, int> restored_cache(CACHE_CAPACITY);
+  cache.SetEvictionCost(100, 300);
+  restored_cache.SetEvictionCost(100, 300);
+
+  for (int i = 0; i < TEST_RECORDS; ++i) {
+    cache.Put(i % 7, (i % 2) ? DIRTY_BLOCK : CLEAN_BLOCK);
+    cache.Put(i % 3, CLEAN_BLOCK);
+  }
+
+  std::vector<uint64_t> buffer;
+  cache.Serialize(buffer);
+  const uint64_t* cursor = buffer.data();
+  const uint64_t* end = buffer.data() + buffer.size();
+  restored_cache.Deserialize(cursor, end);
+  EXPECT_EQ(cursor, end);
+
+  // Both caches evict the same blocks from now on
+  for (int i = TEST_RECORDS; i < 2 * TEST_RECORDS; ++i) {
+    auto status = (i % 3) ? DIRTY_BLOCK : CLEAN_BLOCK;
+    auto victim = cache.Put(i % 11, status);
+    auto restored_victim = restored_cache.Put(i % 11, status);
+    EXPECT_EQ(victim.block_id, restored_victim.block_id);
+    EXPECT_EQ(victim.block_type, restored_victim.block_type);
+  }
+
+  EXPECT_EQ(cache.CurrentCapacity(), restored_cache.CurrentCapacity());
+}
+
+}  // End machine namespace
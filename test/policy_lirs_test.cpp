@@ -0,0 +1,177 @@
+// LIRS TEST
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "policy_lirs.h"
+#include "cache.h"
+
+namespace machine {
+
+template <typename Key, typename Value>
+using lirs_cache_t = Cache<Key, Value, LIRSCachePolicy<Key>>;
+
+template <typename Key, typename Value>
+using lru_cache_t = Cache<Key, Value, LRUCachePolicy<Key>>;
+
+// Access a hot set, then a scan of new keys, round after round, and
+// count the hot keys left in the cache
+template <typename CacheType>
+size_t GetResidentHotKeys(CacheType& cache,
+                          const int& hot_count,
+                          const int& scan_length,
+                          const int& round_count) {
+  int scan_key = 1000;
+  for (int round = 0; round < round_count; ++round) {
+    for (int i = 0; i < hot_count; ++i) {
+      cache.Put(i, i);
+    }
+    for (int i = 0; i < scan_length; ++i, ++scan_key) {
+      cache.Put(scan_key, scan_key);
+    }
+  }
+
+  std::vector<int> keys;
+  cache.GetKeys(keys);
+  return std::count_if(keys.begin(), keys.end(),
+                       [&](int key) { return key < hot_count; });
+}
+
+TEST(LIRSCache, SimplePut) {
+  size_t cache_capacity = 1;
+  lirs_cache_t<int, int> cache(cache_capacity);
+
+  cache.Put(1, 666);
+
+  EXPECT_EQ(cache.Get(1), 666);
+}
+
+TEST(LIRSCache, MissingValue) {
+  size_t cache_capacity = 1;
+  lirs_cache_t<int, int> cache(cache_capacity);
+
+  EXPECT_THROW(cache.Get(0), std::range_error);
+}
+
+TEST(LIRSCache, SingleSlot) {
+  size_t cache_capacity = 1;
+  lirs_cache_t<int, int> cache(cache_capacity);
+
+  for (int i = 0; i < 10; ++i) {
+    cache.Put(i % 3, i);
+  }
+
+  EXPECT_EQ(cache.CurrentCapacity(), 1);
+  EXPECT_EQ(cache.Get(0), 9);
+}
+
+TEST(LIRSCache, EraseAnyKey) {
+  size_t cache_capacity = 4;
+  lirs_cache_t<int, int> cache(cache_capacity);
+
+  // Keys 1 to 3 fill the LIR set and key 4 is HIR
+  cache.Put(1, 1);
+  cache.Put(2, 2);
+  cache.Put(3, 3);
+  cache.Put(4, 4);
+
+  // Drop a LIR key that is not the victim
+  cache.Erase(2);
+  EXPECT_EQ(cache.CurrentCapacity(), 3);
+  EXPECT_THROW(cache.Get(2), std::range_error);
+
+  // The freed slot is reused before anything is evicted
+  auto victim = cache.Put(5, 5);
+  EXPECT_EQ(victim.block_id, INVALID_KEY);
+
+  // The oldest HIR key goes first
+  victim = cache.Put(6, 6);
+  EXPECT_EQ(victim.block_id, 4);
+
+  std::vector<int> keys;
+  cache.GetKeys(keys);
+  std::sort(keys.begin(), keys.end());
+  EXPECT_EQ(keys, std::vector<int>({1, 3, 5, 6}));
+
+}
+
+TEST(LIRSCache, GhostPromotion) {
+  size_t cache_capacity = 4;
+  lirs_cache_t<int, int> cache(cache_capacity);
+
+  cache.Put(1, 1);
+  cache.Put(2, 2);
+  cache.Put(3, 3);
+  cache.Put(4, 4);
+
+  // Key 4 is evicted but stays in the stack
+  cache.Put(5, 5);
+  EXPECT_THROW(cache.Get(4), std::range_error);
+
+  // Its reuse distance beats the oldest LIR key (1), which is demoted and
+  // evicted next
+  cache.Put(4, 4);
+  auto victim = cache.Put(6, 6);
+  EXPECT_EQ(victim.block_id, 1);
+}
+
+TEST(LIRSCache, ScanResistance) {
+  size_t cache_capacity = 100;
+  lirs_cache_t<int, int> cache(cache_capacity);
+  lru_cache_t<int, int> lru_cache(cache_capacity);
+
+  // Scans longer than the cache flush LRU, but not the LIR keys
+  EXPECT_EQ(GetResidentHotKeys(cache, 20, 150, 20), 20);
+  EXPECT_EQ(GetResidentHotKeys(lru_cache, 20, 150, 20), 0);
+}
+
+TEST(LIRSCache, BoundedGhosts) {
+  size_t cache_capacity = 100;
+  lirs_cache_t<int, int> cache(cache_capacity);
+  lirs_cache_t<int, int> long_cache(cache_capacity);
+
+  // Alternate between the hot set and new keys. The LIR keys filled in
+  // first are never reused, so the stack is never pruned and the evicted
+  // keys pile up in it as ghosts, until there are as many as the capacity.
+  GetResidentHotKeys(cache, 20, 1, 1000);
+  GetResidentHotKeys(long_cache, 20, 1, 10000);
+
+  std::vector<uint64_t> buffer;
+  std::vector<uint64_t> long_buffer;
+  cache.Serialize(buffer);
+  long_cache.Serialize(long_buffer);
+  EXPECT_EQ(buffer.size(), long_buffer.size());
+}
+
+TEST(LIRSCache, SnapshotRoundTrip) {
+  constexpr int CACHE_CAPACITY = 5;
+  const int TEST_RECORDS = 20;
+  lirs_cache_t<int, int> cache(CACHE_CAPACITY);
+  lirs_cache_t<int, int> restored_cache(CACHE_CAPACITY);
+
+  for (int i = 0; i < TEST_RECORDS; ++i) {
+    cache.Put(i % 7, i);
+    cache.Put(i % 3, i);
+  }
+
+  std::vector<uint64_t> buffer;
+  cache.Serialize(buffer);
+  const uint64_t* cursor = buffer.data();
+  const uint64_t* end = buffer.data() + buffer.size();
+  restored_cache.Deserialize(cursor, end);
+  EXPECT_EQ(cursor, end);
+
+  // Both caches evict the same blocks from now on
+  for (int i = TEST_RECORDS; i < 2 * TEST_RECORDS; ++i) {
+    auto victim = cache.Put(i % 11, i);
+    auto restored_victim = restored_cache.Put(i % 11, i);
+    EXPECT_EQ(victim.block_id, restored_victim.block_id);
+    EXPECT_EQ(victim.block_type, restored_victim.block_type);
+  }
+
+  EXPECT_EQ(cache.CurrentCapacity(), restored_cache.CurrentCapacity());
+}
+
+}  // End machine namespace
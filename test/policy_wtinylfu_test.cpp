@@ -0,0 +1,150 @@
+// W-TINYLFU TEST
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "policy_wtinylfu.h"
+#include "cache.h"
+#include "sketch.h"
+
+namespace machine {
+
+template <typename Key, typename Value>
+using wtinylfu_cache_t = Cache<Key, Value, WTinyLFUCachePolicy<Key>>;
+
+TEST(WTinyLFUCache, SimplePut) {
+  size_t cache_capacity = 1;
+  wtinylfu_cache_t<int, int> cache(cache_capacity);
+
+  cache.Put(1, 666);
+
+  EXPECT_EQ(cache.Get(1), 666);
+}
+
+TEST(WTinyLFUCache, MissingValue) {
+  size_t cache_capacity = 1;
+  wtinylfu_cache_t<int, int> cache(cache_capacity);
+
+  EXPECT_THROW(cache.Get(0), std::range_error);
+}
+
+TEST(WTinyLFUCache, EraseAnyKey) {
+  size_t cache_capacity = 3;
+  wtinylfu_cache_t<int, int> cache(cache_capacity);
+
+  cache.Put(1, 1);
+  cache.Put(2, 2);
+  cache.Put(3, 3);
+
+  // Drop a block that is not the victim
+  cache.Erase(2);
+  EXPECT_EQ(cache.CurrentCapacity(), 2);
+  EXPECT_THROW(cache.Get(2), std::range_error);
+
+  // The freed slot is reused before anything is evicted
+  auto victim = cache.Put(4, 4);
+  EXPECT_EQ(victim.block_id, INVALID_KEY);
+
+  // As frequent as the probation victim, the window candidate is dropped
+  victim = cache.Put(5, 5);
+  EXPECT_EQ(victim.block_id, 4);
+
+  std::vector<int> keys;
+  cache.GetKeys(keys);
+  std::sort(keys.begin(), keys.end());
+  EXPECT_EQ(keys, std::vector<int>({1, 3, 5}));
+
+}
+
+TEST(WTinyLFUCache, ScanResistance) {
+  size_t cache_capacity = 100;
+  wtinylfu_cache_t<int, int> cache(cache_capacity);
+
+  // Hot set accessed a few times
+  for (int round = 0; round < 4; ++round) {
+    for (int i = 0; i < 50; ++i) {
+      cache.Put(i, i);
+    }
+  }
+
+  // One-time keys fail the admission check, unless the sketch
+  // overestimates one of them
+  for (int i = 1000; i < 2000; ++i) {
+    cache.Put(i, i);
+  }
+
+  std::vector<int> keys;
+  cache.GetKeys(keys);
+  auto hot_count = std::count_if(keys.begin(), keys.end(),
+                                 [](int key) { return key < 50; });
+  EXPECT_GE(hot_count, 45);
+
+}
+
+TEST(WTinyLFUCache, SnapshotRoundTrip) {
+  constexpr int CACHE_CAPACITY = 5;
+  const int TEST_RECORDS = 20;
+  wtinylfu_cache_t<int, int> cache(CACHE_CAPACITY);
+  wtinylfu_cache_t<int, int> restored_cache(CACHE_CAPACITY);
+
+  for (int i = 0; i < TEST_RECORDS; ++i) {
+    cache.Put(i % 7, i);
+    cache.Put(i % 3, i);
+  }
+
+  std::vector<uint64_t> buffer;
+  cache.Serialize(buffer);
+  const uint64_t* cursor = buffer.data();
+  const uint64_t* end = buffer.data() + buffer.size();
+  restored_cache.Deserialize(cursor, end);
+  EXPECT_EQ(cursor, end);
+
+  // Both caches evict the same blocks from now on
+  for (int i = TEST_RECORDS; i < 2 * TEST_RECORDS; ++i) {
+    auto victim = cache.Put(i % 11, i);
+    auto restored_victim = restored_cache.Put(i % 11, i);
+    EXPECT_EQ(victim.block_id, restored_victim.block_id);
+    EXPECT_EQ(victim.block_type, restored_victim.block_type);
+  }
+
+  EXPECT_EQ(cache.CurrentCapacity(), restored_cache.CurrentCapacity());
+}
+
+TEST(FrequencySketch, CountersSaturate) {
+  FrequencySketch sketch(50);
+  sketch.EnsureCapacity(1024);
+
+  for (int i = 0; i < 10; ++i) {
+    sketch.Increment(1);
+  }
+  EXPECT_GE(sketch.Estimate(1), 10);
+
+  for (int i = 0; i < 100; ++i) {
+    sketch.Increment(1);
+  }
+  EXPECT_EQ(sketch.Estimate(1), 15);
+
+  sketch.Age();
+  EXPECT_EQ(sketch.Estimate(1), 7);
+}
+
+TEST(FrequencySketch, NeverUndercounts) {
+  FrequencySketch sketch(50);
+  sketch.EnsureCapacity(256);
+
+  // Few enough increments that no aging happens
+  std::vector<uint32_t> exact_counts(512, 0);
+  for (size_t i = 0; i < 2000; ++i) {
+    auto key = (i * i) % exact_counts.size();
+    sketch.Increment(key);
+    exact_counts[key]++;
+  }
+
+  for (size_t key = 0; key < exact_counts.size(); ++key) {
+    EXPECT_GE(sketch.Estimate(key), std::min<uint32_t>(exact_counts[key], 15));
+  }
+}
+
+}  // End machine namespace
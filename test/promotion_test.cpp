@@ -0,0 +1,106 @@
+// PROMOTION TEST
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <vector>
+
+#include "promotion.h"
+#include "distribution.h"
+
+namespace machine {
+
+TEST(PromotionTest, SketchNeverUndercounts) {
+
+  CountMinSketch sketch(1024, 4, 50);
+  std::map<uint64_t, uint32_t> exact_counts;
+
+  // Skewed stream that overloads the sketch
+  ZipfDistribution zipf_generator(10000, 0.9, 50);
+  for(size_t access_itr = 0; access_itr < 50000; access_itr++){
+    auto key = zipf_generator.GetNextNumber();
+    sketch.Increment(key);
+    exact_counts[key]++;
+  }
+
+  for(auto& entry : exact_counts){
+    EXPECT_GE(sketch.Estimate(entry.first), entry.second);
+  }
+
+  // Hot keys are estimated closely
+  for(uint64_t key = 1; key <= 10; key++){
+    EXPECT_LE(sketch.Estimate(key), exact_counts[key] * 1.05);
+  }
+
+  // Aging halves the counts
+  auto estimate = sketch.Estimate(1);
+  sketch.Age();
+  EXPECT_EQ(sketch.Estimate(1), estimate / 2);
+
+}
+
+TEST(PromotionTest, PromoteOnKthAccess) {
+
+  std::map<DeviceType, size_t> thresholds;
+  thresholds[DEVICE_TYPE_DRAM] = 3;
+  thresholds[DEVICE_TYPE_CACHE] = 5;
+  PromotionEngine promotion(1000, thresholds, 50);
+
+  for(size_t access_itr = 1; access_itr <= 6; access_itr++){
+    promotion.Access(42);
+    EXPECT_EQ(promotion.ShouldPromote(42, DEVICE_TYPE_DRAM), access_itr >= 3);
+    EXPECT_EQ(promotion.ShouldPromote(42, DEVICE_TYPE_CACHE), access_itr >= 5);
+  }
+
+  // Cold block stays put
+  promotion.Access(7);
+  EXPECT_FALSE(promotion.ShouldPromote(7, DEVICE_TYPE_DRAM));
+
+}
+
+TEST(PromotionTest, WindowAging) {
+
+  std::map<DeviceType, size_t> thresholds;
+  thresholds[DEVICE_TYPE_DRAM] = 4;
+  size_t window = 10;
+  PromotionEngine promotion(window, thresholds, 50);
+
+  // Three accesses, then the window ends and halves the count to one
+  for(size_t access_itr = 0; access_itr < 3; access_itr++){
+    promotion.Access(42);
+  }
+  for(size_t access_itr = 3; access_itr < window; access_itr++){
+    promotion.Access(1000 + access_itr);
+  }
+
+  promotion.Access(42);
+  EXPECT_FALSE(promotion.ShouldPromote(42, DEVICE_TYPE_DRAM));
+  promotion.Access(42);
+  promotion.Access(42);
+  EXPECT_TRUE(promotion.ShouldPromote(42, DEVICE_TYPE_DRAM));
+
+}
+
+TEST(PromotionTest, DeterministicForSeed) {
+
+  std::map<DeviceType, size_t> thresholds;
+  thresholds[DEVICE_TYPE_DRAM] = 2;
+
+  // Two engines with the same seed make the same decisions
+  std::vector<bool> decisions[2];
+  for(size_t engine_itr = 0; engine_itr < 2; engine_itr++){
+    PromotionEngine promotion(512, thresholds, 50);
+    ZipfDistribution zipf_generator(100000, 0.9, 7);
+    for(size_t access_itr = 0; access_itr < 20000; access_itr++){
+      auto block_id = zipf_generator.GetNextNumber();
+      promotion.Access(block_id);
+      decisions[engine_itr].push_back(
+          promotion.ShouldPromote(block_id, DEVICE_TYPE_DRAM));
+    }
+  }
+
+  EXPECT_EQ(decisions[0], decisions[1]);
+
+}
+
+}  // End machine namespace
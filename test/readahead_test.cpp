@@ -0,0 +1,91 @@
+// READAHEAD TEST
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "readahead.h"
+
+namespace machine {
+
+TEST(ReadaheadTest, WindowRamp) {
+
+  size_t max_window = 32;
+  ReadaheadEngine readahead(max_window);
+  std::vector<size_t> prefetch_blocks;
+
+  // Random misses do not prefetch
+  readahead.Access(100, true, prefetch_blocks);
+  readahead.Access(7, true, prefetch_blocks);
+  EXPECT_TRUE(prefetch_blocks.empty());
+
+  // Sequential miss opens the first window
+  readahead.Access(8, true, prefetch_blocks);
+  EXPECT_EQ(prefetch_blocks.size(), readahead_initial_window);
+  EXPECT_EQ(prefetch_blocks.front(), 9);
+
+  // Reaching each window's marker issues the next, twice as large
+  size_t expected_window = readahead_initial_window;
+  size_t next_block = 9;
+  size_t prefetch_end = 9 + readahead_initial_window;
+  for(size_t round = 0; round < 6; round++){
+    auto marker = prefetch_end - expected_window;
+    while(next_block < marker){
+      prefetch_blocks.clear();
+      readahead.Access(next_block++, false, prefetch_blocks);
+      EXPECT_TRUE(prefetch_blocks.empty());
+    }
+
+    prefetch_blocks.clear();
+    readahead.Access(next_block++, false, prefetch_blocks);
+    expected_window = std::min(expected_window * 2, max_window);
+    ASSERT_EQ(prefetch_blocks.size(), expected_window);
+    EXPECT_EQ(prefetch_blocks.front(), prefetch_end);
+    prefetch_end += expected_window;
+  }
+
+  EXPECT_EQ(expected_window, max_window);
+
+}
+
+TEST(ReadaheadTest, PrefetchUse) {
+
+  ReadaheadEngine readahead(8);
+  double ready_time = 0;
+
+  readahead.RecordPrefetch(10, 500);
+  readahead.RecordPrefetch(10, 900);
+
+  EXPECT_FALSE(readahead.UsePrefetch(11, ready_time));
+  EXPECT_TRUE(readahead.UsePrefetch(10, ready_time));
+  EXPECT_DOUBLE_EQ(ready_time, 900);
+
+  // Each prefetch is used once
+  EXPECT_FALSE(readahead.UsePrefetch(10, ready_time));
+
+}
+
+TEST(ReadaheadTest, PendingBound) {
+
+  size_t max_window = 8;
+  ReadaheadEngine readahead(max_window);
+  auto pending_limit = readahead_pending_windows * max_window *
+      stream_table_size;
+
+  // Prefetches that are never read
+  size_t prefetch_count = 100 * pending_limit;
+  for(size_t block_id = 0; block_id < prefetch_count; block_id++){
+    readahead.RecordPrefetch(block_id, block_id);
+  }
+  EXPECT_LE(readahead.GetPendingCount(), 2 * pending_limit);
+  EXPECT_GE(readahead.GetPendingCount(), pending_limit);
+
+  // The latest prefetches are kept, the oldest dropped
+  double ready_time = 0;
+  EXPECT_TRUE(readahead.UsePrefetch(prefetch_count - 1, ready_time));
+  EXPECT_DOUBLE_EQ(ready_time, prefetch_count - 1);
+  EXPECT_FALSE(readahead.UsePrefetch(0, ready_time));
+
+}
+
+}  // End machine namespace
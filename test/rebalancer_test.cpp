@@ -0,0 +1,109 @@
+// REBALANCER TEST
+
+#include <gtest/gtest.h>
+
+#include <set>
+#include <vector>
+
+#include "rebalancer.h"
+
+namespace machine {
+
+TEST(RebalancerTest, EpochBoundary) {
+
+  EpochRebalancer rebalancer(4, 8);
+
+  for(size_t operation_itr = 1; operation_itr <= 12; operation_itr++){
+    EXPECT_EQ(rebalancer.Tick(), operation_itr % 4 == 0);
+  }
+
+}
+
+TEST(RebalancerTest, SwapHotAndCold) {
+
+  EpochRebalancer rebalancer(100, 8);
+
+  // Fast tier holds 1..4, slow tier holds 10..13
+  std::vector<int> fast_blocks = {1, 2, 3, 4};
+  std::set<size_t> slow_blocks = {10, 11, 12, 13};
+  auto in_slow_tier = [&](const size_t& block_id){
+    return (slow_blocks.count(block_id) != 0);
+  };
+
+  // 10 and 11 are hot, 12 is lukewarm, 1 and 2 are warm
+  for(size_t access_itr = 0; access_itr < 8; access_itr++){
+    rebalancer.Access(10);
+    rebalancer.Access(11);
+  }
+  rebalancer.Access(12);
+  rebalancer.Access(12);
+  rebalancer.Access(1);
+  rebalancer.Access(2);
+
+  std::vector<size_t> promote_blocks;
+  std::vector<size_t> demote_blocks;
+  rebalancer.Plan(fast_blocks, 0, in_slow_tier,
+                  promote_blocks, demote_blocks);
+
+  // The idle fast blocks make room for the hot ones; 12 is not
+  // hot enough to displace a warm block
+  EXPECT_EQ(promote_blocks, std::vector<size_t>({11, 10}));
+  EXPECT_EQ(demote_blocks, std::vector<size_t>({3, 4}));
+
+}
+
+TEST(RebalancerTest, BudgetAndFreeSlots) {
+
+  EpochRebalancer rebalancer(100, 3);
+
+  std::vector<int> fast_blocks = {1, 2};
+  auto in_slow_tier = [](const size_t& block_id){
+    return (block_id >= 10);
+  };
+
+  for(size_t block_id = 10; block_id < 20; block_id++){
+    for(size_t access_itr = 0; access_itr < block_id; access_itr++){
+      rebalancer.Access(block_id);
+    }
+  }
+
+  // Two free slots are filled first, then one swap fits the budget
+  std::vector<size_t> promote_blocks;
+  std::vector<size_t> demote_blocks;
+  rebalancer.Plan(fast_blocks, 2, in_slow_tier,
+                  promote_blocks, demote_blocks);
+
+  EXPECT_EQ(promote_blocks, std::vector<size_t>({19, 18, 17}));
+  EXPECT_EQ(demote_blocks, std::vector<size_t>({1}));
+
+}
+
+TEST(RebalancerTest, CountersAge) {
+
+  EpochRebalancer rebalancer(100, 8);
+
+  std::vector<int> fast_blocks = {1};
+  auto in_slow_tier = [](const size_t& block_id){
+    return (block_id == 10);
+  };
+
+  for(size_t access_itr = 0; access_itr < 4; access_itr++){
+    rebalancer.Access(10);
+  }
+
+  // Without new accesses the block cools down (4, 2, 1)
+  std::vector<size_t> promote_blocks;
+  std::vector<size_t> demote_blocks;
+  for(size_t epoch_itr = 0; epoch_itr < 3; epoch_itr++){
+    promote_blocks.clear();
+    demote_blocks.clear();
+    rebalancer.Plan(fast_blocks, 0, in_slow_tier,
+                    promote_blocks, demote_blocks);
+  }
+
+  EXPECT_TRUE(promote_blocks.empty());
+  EXPECT_TRUE(demote_blocks.empty());
+
+}
+
+}  // End machine namespace
@@ -0,0 +1,269 @@
+// REPLAY BENCHMARK
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "configuration.h"
+#include "workload.h"
+#include "distribution.h"
+#include "device.h"
+#include "stats.h"
+
+namespace machine {
+
+configuration state;
+
+extern Stats machine_stats;
+
+// Number of distinct blocks touched by the synthetic traces (4K blocks)
+const size_t bench_block_count = 64 * 1024;
+
+// Default number of operations in each synthetic trace
+const size_t bench_operation_count = 200 * 1000;
+
+enum TraceType {
+  TRACE_TYPE_INVALID = 0,
+
+  TRACE_TYPE_OLTP = 1,
+  TRACE_TYPE_SCAN = 2,
+  TRACE_TYPE_LOG = 3
+
+};
+
+struct TraceOperation {
+  char operation_type;
+  size_t block_id;
+};
+
+std::string TraceTypeToString(const TraceType& trace_type){
+
+  switch (trace_type){
+    case TRACE_TYPE_OLTP:
+      return "OLTP";
+    case TRACE_TYPE_SCAN:
+      return "SCAN";
+    case TRACE_TYPE_LOG:
+      return "LOG";
+    default:
+      return "INVALID";
+  }
+
+}
+
+// Zipfian point reads and updates with occasional flushes
+void GenerateOLTPTrace(std::vector<TraceOperation>& trace,
+                       const size_t& operation_count){
+
+  ZipfDistribution zipf_generator(bench_block_count, 0.9);
+  UniformDistribution uniform_generator(generator_seed);
+
+  while(trace.size() < operation_count){
+    auto block_id = zipf_generator.GetNextNumber() - 1;
+    auto coin = uniform_generator.NextUniform();
+
+    if(coin < 0.70){
+      trace.push_back({'r', block_id});
+    }
+    else if(coin < 0.95){
+      trace.push_back({'w', block_id});
+    }
+    else {
+      trace.push_back({'f', block_id});
+    }
+  }
+
+}
+
+// Long sequential read scans interleaved with a few point updates
+void GenerateScanTrace(std::vector<TraceOperation>& trace,
+                       const size_t& operation_count){
+
+  ZipfDistribution zipf_generator(bench_block_count, 0.9);
+  UniformDistribution uniform_generator(generator_seed);
+
+  while(trace.size() < operation_count){
+    size_t scan_length = 32 + uniform_generator.next_u32() % 224;
+    size_t scan_start = uniform_generator.next_u32() % bench_block_count;
+
+    for(size_t scan_itr = 0; scan_itr < scan_length; scan_itr++){
+      auto block_id = (scan_start + scan_itr) % bench_block_count;
+      trace.push_back({'r', block_id});
+
+      // Point update every twenty operations
+      if(scan_itr % 20 == 0){
+        trace.push_back({'w', zipf_generator.GetNextNumber() - 1});
+      }
+    }
+  }
+
+  trace.resize(operation_count);
+
+}
+
+// Sequential log appends with flushes and a skewed data access stream
+void GenerateLogTrace(std::vector<TraceOperation>& trace,
+                      const size_t& operation_count){
+
+  // Last quarter of the block space holds the log
+  size_t data_block_count = (bench_block_count * 3)/4;
+  size_t log_block_count = bench_block_count - data_block_count;
+  size_t log_tail = 0;
+
+  ZipfDistribution zipf_generator(data_block_count, 0.9);
+  UniformDistribution uniform_generator(generator_seed);
+
+  while(trace.size() < operation_count){
+    auto coin = uniform_generator.NextUniform();
+
+    if(coin < 0.60){
+      log_tail = (log_tail + 1) % log_block_count;
+      trace.push_back({'w', data_block_count + log_tail});
+    }
+    else if(coin < 0.70){
+      trace.push_back({'f', data_block_count + log_tail});
+    }
+    else if(coin < 0.85){
+      trace.push_back({'w', zipf_generator.GetNextNumber() - 1});
+    }
+    else {
+      trace.push_back({'r', zipf_generator.GetNextNumber() - 1});
+    }
+  }
+
+}
+
+void GenerateTrace(const TraceType& trace_type,
+                   std::vector<TraceOperation>& trace,
+                   const size_t& operation_count){
+
+  // Same seed for every trace keeps the benchmark deterministic
+  srand(generator_seed);
+  trace.reserve(operation_count);
+
+  switch(trace_type){
+    case TRACE_TYPE_OLTP:
+      GenerateOLTPTrace(trace, operation_count);
+      break;
+
+    case TRACE_TYPE_SCAN:
+      GenerateScanTrace(trace, operation_count);
+      break;
+
+    case TRACE_TYPE_LOG:
+      GenerateLogTrace(trace, operation_count);
+      break;
+
+    case TRACE_TYPE_INVALID:
+    default:
+      std::cout << "Invalid trace type: " << trace_type << "\n";
+      exit(EXIT_FAILURE);
+  }
+
+}
+
+void ReplayTrace(const HierarchyType& hierarchy_type,
+                 const TraceType& trace_type,
+                 const std::vector<TraceOperation>& trace){
+
+  state.hierarchy_type = hierarchy_type;
+  ConstructDeviceList(state);
+
+  // Bootstrap blocks in the order they first appear
+  std::vector<bool> block_list(bench_block_count, false);
+  for(auto& operation : trace){
+    if(block_list[operation.block_id] == false){
+      BootstrapBlock(operation.block_id);
+      block_list[operation.block_id] = true;
+    }
+  }
+
+  // Start from idle devices and fresh engines, so that the results do not
+  // depend on the hierarchies replayed before
+  ResetDeviceServiceState();
+  ResetWorkloadEngines();
+  total_duration = 0;
+  machine_stats.Reset();
+
+  auto start = std::chrono::steady_clock::now();
+
+  for(auto& operation : trace){
+    ExecuteOperation(operation.operation_type, operation.block_id);
+  }
+
+  auto end = std::chrono::steady_clock::now();
+  std::chrono::duration<double, std::nano> elapsed = end - start;
+
+  auto operation_count = trace.size();
+  auto nanoseconds_per_op = elapsed.count()/operation_count;
+  auto ops_per_second = (operation_count * 1e9)/elapsed.count();
+  auto throughput = (operation_count * 1000 * 1000)/total_duration;
+
+  printf("%-20s %-6s %10lu %14.0f %12.1f %18.2f\n",
+         HierarchyTypeToString(hierarchy_type).c_str(),
+         TraceTypeToString(trace_type).c_str(),
+         operation_count,
+         ops_per_second,
+         nanoseconds_per_op,
+         throughput);
+
+}
+
+void RunReplayBenchmark(){
+
+  auto operation_count = state.operation_count;
+  if(operation_count == 0){
+    operation_count = bench_operation_count;
+  }
+
+  std::vector<TraceType> trace_types = {
+      TRACE_TYPE_OLTP,
+      TRACE_TYPE_SCAN,
+      TRACE_TYPE_LOG
+  };
+
+  std::vector<HierarchyType> hierarchy_types = {
+      HIERARCHY_TYPE_NVM,
+      HIERARCHY_TYPE_DRAM_NVM,
+      HIERARCHY_TYPE_DRAM_SSD,
+      HIERARCHY_TYPE_DRAM_NVM_SSD
+  };
+
+  std::vector<std::vector<TraceOperation>> traces(trace_types.size());
+  for(size_t trace_itr = 0; trace_itr < trace_types.size(); trace_itr++){
+    GenerateTrace(trace_types[trace_itr],
+                  traces[trace_itr],
+                  operation_count);
+  }
+
+  printf("%-20s %-6s %10s %14s %12s %18s\n",
+         "hierarchy", "trace", "ops", "sim ops/s", "ns/op",
+         "throughput (ops/s)");
+
+  for(auto hierarchy_type : hierarchy_types){
+    for(size_t trace_itr = 0; trace_itr < trace_types.size(); trace_itr++){
+      ReplayTrace(hierarchy_type,
+                  trace_types[trace_itr],
+                  traces[trace_itr]);
+    }
+  }
+
+}
+
+}  // namespace machine
+
+int main(int argc, char **argv) {
+
+  // Initialize Google's logging library.
+  google::InitGoogleLogging(argv[0]);
+
+  machine::ParseArguments(
+      argc, argv, machine::state);
+
+  machine::BootstrapDeviceMetrics(machine::state);
+
+  machine::RunReplayBenchmark();
+
+  return 0;
+}
@@ -0,0 +1,129 @@
+// STREAM TABLE TEST
+
+#include <gtest/gtest.h>
+
+#include "stream_table.h"
+
+namespace machine {
+
+// Sequential accesses seen when two scans interleave with random blocks
+size_t CountInterleavedSequential(const size_t& stream_count){
+
+  StreamTable stream_table(stream_count);
+  size_t sequential_count = 0;
+
+  for(size_t block_itr = 0; block_itr < 100; block_itr++){
+    bool sequential = false;
+    stream_table.Access(1000 + block_itr, sequential);
+    sequential_count += sequential;
+    stream_table.Access(5000 - block_itr, sequential);
+    sequential_count += sequential;
+    stream_table.Access(100000 + block_itr * 37, sequential);
+    sequential_count += sequential;
+  }
+
+  return sequential_count;
+}
+
+TEST(StreamTableTest, InterleavedStreams) {
+
+  // A single stream sees every access as random
+  EXPECT_EQ(CountInterleavedSequential(1), 0);
+
+  // Enough streams follow both scans (first block of each starts a stream)
+  EXPECT_EQ(CountInterleavedSequential(4), 198);
+
+}
+
+TEST(StreamTableTest, ForwardOnly) {
+
+  StreamTable stream_table(2, true);
+  bool sequential = false;
+
+  stream_table.Access(10, sequential);
+  stream_table.Access(9, sequential);
+  EXPECT_FALSE(sequential);
+  stream_table.Access(11, sequential);
+  EXPECT_TRUE(sequential);
+
+}
+
+TEST(StreamTableTest, LRUReplacement) {
+
+  StreamTable stream_table(2);
+  bool sequential = false;
+
+  auto first_slot = stream_table.Access(10, sequential);
+  stream_table.Access(20, sequential);
+  stream_table.Access(11, sequential);
+
+  // Stream at 20 is the least recently used
+  auto slot = stream_table.Access(30, sequential);
+  EXPECT_FALSE(sequential);
+  EXPECT_NE(slot, first_slot);
+
+  stream_table.Access(12, sequential);
+  EXPECT_TRUE(sequential);
+  stream_table.Access(21, sequential);
+  EXPECT_FALSE(sequential);
+
+}
+
+TEST(StreamTableTest, RepeatedBlocks) {
+
+  // Two scans that read then write every block
+  StreamTable stream_table(2);
+  bool sequential = false;
+  size_t sequential_count = 0;
+
+  std::vector<size_t> slots(2);
+  for(size_t block_itr = 0; block_itr < 50; block_itr++){
+    for(size_t stream_itr = 0; stream_itr < 2; stream_itr++){
+      auto block_id = stream_itr * 1000 + block_itr;
+      auto slot = stream_table.Access(block_id, sequential);
+      sequential_count += sequential;
+      EXPECT_EQ(stream_table.Access(block_id, sequential), slot);
+      sequential_count += sequential;
+      if(block_itr > 0){
+        EXPECT_EQ(slot, slots[stream_itr]);
+      }
+      slots[stream_itr] = slot;
+    }
+  }
+  EXPECT_NE(slots[0], slots[1]);
+
+  // Only the first read and write of each scan are random
+  EXPECT_EQ(sequential_count, 196);
+
+  // A repeat does not make a new stream sequential
+  stream_table.Access(7000, sequential);
+  stream_table.Access(7000, sequential);
+  EXPECT_FALSE(sequential);
+
+}
+
+TEST(StreamTableTest, SnapshotRoundTrip) {
+
+  StreamTable stream_table(4);
+  bool sequential = false;
+  stream_table.Access(10, sequential);
+  stream_table.Access(50, sequential);
+
+  std::vector<uint64_t> buffer;
+  stream_table.Serialize(buffer);
+
+  StreamTable restored_table(1);
+  const uint64_t* cursor = buffer.data();
+  const uint64_t* end = buffer.data() + buffer.size();
+  restored_table.Deserialize(cursor, end);
+  EXPECT_EQ(cursor, end);
+  EXPECT_EQ(restored_table.GetStreamCount(), 4);
+
+  restored_table.Access(51, sequential);
+  EXPECT_TRUE(sequential);
+  restored_table.Access(11, sequential);
+  EXPECT_TRUE(sequential);
+
+}
+
+}  // End machine namespace
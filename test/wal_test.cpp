@@ -0,0 +1,79 @@
+// WAL TEST
+
+#include <gtest/gtest.h>
+
+#include "wal.h"
+
+namespace machine {
+
+TEST(WALTest, CommitFlushesTail) {
+
+  // 1000 ns per log page, no group commit delay
+  WriteAheadLog write_ahead_log(DEVICE_TYPE_SSD, 1000, 0, 256);
+
+  write_ahead_log.Append();
+  EXPECT_DOUBLE_EQ(write_ahead_log.Commit(0), 1000);
+
+  // Nothing new: the commit waits for the flush that covers it
+  EXPECT_DOUBLE_EQ(write_ahead_log.Commit(500), 1000);
+  EXPECT_DOUBLE_EQ(write_ahead_log.Commit(2000), 2000);
+
+  // The partial tail page is written again
+  write_ahead_log.Append();
+  EXPECT_DOUBLE_EQ(write_ahead_log.Commit(2000), 3000);
+
+}
+
+TEST(WALTest, GroupCommit) {
+
+  WriteAheadLog write_ahead_log(DEVICE_TYPE_NVM, 100, 500, 256);
+
+  // Commits within the interval share one flush
+  write_ahead_log.Append();
+  EXPECT_DOUBLE_EQ(write_ahead_log.Commit(0), 600);
+  write_ahead_log.Append();
+  EXPECT_DOUBLE_EQ(write_ahead_log.Commit(200), 600);
+  write_ahead_log.Append();
+  EXPECT_DOUBLE_EQ(write_ahead_log.Commit(499), 600);
+
+  // A commit after the flush is issued opens the next group
+  write_ahead_log.Append();
+  EXPECT_DOUBLE_EQ(write_ahead_log.Commit(550), 1150);
+
+}
+
+TEST(WALTest, BusyLogDevice) {
+
+  WriteAheadLog write_ahead_log(DEVICE_TYPE_SSD, 1000, 0, 256);
+
+  write_ahead_log.Append();
+  EXPECT_DOUBLE_EQ(write_ahead_log.Commit(0), 1000);
+
+  // The next group is issued once the device is free, and commits that
+  // arrive before then join it
+  write_ahead_log.Append();
+  EXPECT_DOUBLE_EQ(write_ahead_log.Commit(100), 2000);
+  write_ahead_log.Append();
+  EXPECT_DOUBLE_EQ(write_ahead_log.Commit(900), 2000);
+
+}
+
+TEST(WALTest, SequentialPages) {
+
+  WriteAheadLog write_ahead_log(DEVICE_TYPE_SSD, 1000, 0, 1024);
+
+  // Ten records span three pages
+  for(size_t record_itr = 0; record_itr < 10; record_itr++){
+    write_ahead_log.Append();
+  }
+  EXPECT_DOUBLE_EQ(write_ahead_log.Commit(0), 3000);
+
+  // The next flush starts at the partial third page
+  for(size_t record_itr = 0; record_itr < 2; record_itr++){
+    write_ahead_log.Append();
+  }
+  EXPECT_DOUBLE_EQ(write_ahead_log.Commit(3000), 4000);
+
+}
+
+}  // End machine namespace
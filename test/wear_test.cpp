@@ -0,0 +1,55 @@
+// WEAR TEST
+
+#include <gtest/gtest.h>
+
+#include "wear.h"
+
+namespace machine {
+
+TEST(WearTest, WriteCounts) {
+
+  WearTracker wear_tracker;
+
+  // Skewed writes: block 0 is hot, one region gets everything
+  for(size_t write_itr = 0; write_itr < 100; write_itr++){
+    wear_tracker.RecordWrite(0);
+    wear_tracker.RecordWrite(1 + write_itr % 10);
+  }
+
+  EXPECT_EQ(wear_tracker.GetWriteCount(), 200);
+  EXPECT_EQ(wear_tracker.GetBlockWriteCount(0), 100);
+  EXPECT_EQ(wear_tracker.GetBlockWriteCount(5), 10);
+  EXPECT_EQ(wear_tracker.GetBlockWriteCount(wear_region_block_count), 0);
+
+  wear_tracker.Reset();
+  EXPECT_EQ(wear_tracker.GetWriteCount(), 0);
+  EXPECT_EQ(wear_tracker.GetBlockWriteCount(0), 0);
+
+}
+
+TEST(WearTest, ProjectedLifetime) {
+
+  WearTracker wear_tracker;
+  const double seconds_per_year = 365.0 * 24 * 60 * 60;
+
+  // 100 writes per second to block 0 over one second
+  for(size_t write_itr = 0; write_itr < 100; write_itr++){
+    wear_tracker.RecordWrite(0);
+  }
+  double duration = 1e9;
+  double endurance = 1e6;
+
+  EXPECT_DOUBLE_EQ(wear_tracker.GetBlockLifetime(endurance, duration),
+                   endurance / 100 / seconds_per_year);
+
+  // The region levels wear over its blocks
+  EXPECT_DOUBLE_EQ(wear_tracker.GetRegionLifetime(endurance, duration),
+                   wear_region_block_count * endurance / 100 / seconds_per_year);
+
+  // Ideal leveling over the whole device
+  EXPECT_DOUBLE_EQ(wear_tracker.GetLeveledLifetime(endurance, duration, 4096),
+                   4096 * endurance / 100 / seconds_per_year);
+
+}
+
+}  // End machine namespace
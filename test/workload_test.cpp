@@ -0,0 +1,170 @@
+// WORKLOAD TEST
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "configuration.h"
+#include "workload.h"
+#include "device.h"
+#include "stats.h"
+#include "snapshot.h"
+#include "wear.h"
+
+namespace machine {
+
+configuration state;
+
+extern Stats machine_stats;
+
+// Parse the options as on the command line and build the hierarchy
+void ConfigureMachine(std::vector<std::string> arguments){
+
+  arguments.insert(arguments.begin(), "workload_test");
+  std::vector<char*> argument_list;
+  for(auto& argument : arguments){
+    argument_list.push_back(&argument[0]);
+  }
+  argument_list.push_back(nullptr);
+
+  // Parse from the first option again
+  optind = 0;
+  ParseArguments(arguments.size(), argument_list.data(), state);
+  BootstrapDeviceMetrics(state);
+  ConstructDeviceList(state);
+  ResetWorkloadEngines();
+  machine_stats.Reset();
+
+}
+
+TEST(WorkloadTest, MemoryHierarchyHits) {
+
+  // CACHE over NVM: the last device is a memory device
+  ConfigureMachine({"-a", "1", "-m", "1"});
+  for(size_t block_id = 0; block_id < 4; block_id++){
+    BootstrapBlock(block_id);
+  }
+
+  // Served by the NVM, then promoted into the CACHE
+  ReadBlock(1);
+  EXPECT_EQ(machine_stats.GetTierAccessCount(), 1);
+  EXPECT_EQ(machine_stats.GetTierHitCount(), 0);
+
+  ReadBlock(1);
+  EXPECT_EQ(machine_stats.GetTierAccessCount(), 2);
+  EXPECT_EQ(machine_stats.GetTierHitCount(), 1);
+
+  // Same in CACHE-DRAM-NVM
+  ConfigureMachine({"-a", "2", "-m", "1"});
+  for(size_t block_id = 0; block_id < 4; block_id++){
+    BootstrapBlock(block_id);
+  }
+
+  ReadBlock(2);
+  ReadBlock(2);
+  ReadBlock(3);
+  EXPECT_EQ(machine_stats.GetTierAccessCount(), 3);
+  EXPECT_EQ(machine_stats.GetTierHitCount(), 1);
+
+}
+
+// Overwrite blocks in a fixed random order
+void WriteBlocks(const size_t& first_write, const size_t& write_count,
+                 const size_t& block_count){
+  for(uint64_t write_itr = first_write;
+      write_itr < first_write + write_count; write_itr++){
+    auto block_id = write_itr * 0x9E3779B97F4A7C15ULL;
+    block_id ^= block_id >> 31;
+    block_id *= 0xBF58476D1CE4E5B9ULL;
+    block_id ^= block_id >> 29;
+    WriteBlock(block_id % block_count);
+  }
+}
+
+TEST(WorkloadTest, SnapshotResumeFlash) {
+
+  const std::vector<std::string> arguments = {"-a", "4", "-m", "1",
+                                              "--ftl_block_pages", "8"};
+  const size_t block_count = 8000;
+  const size_t write_count = 16000;
+  const std::string snapshot_file = "workload_test.snap";
+
+  // Uninterrupted run, snapshot halfway
+  ConfigureMachine(arguments);
+  for(size_t block_id = 0; block_id < block_count; block_id++){
+    BootstrapBlock(block_id);
+  }
+  WriteBlocks(0, write_count, block_count);
+  SaveSnapshot(state, snapshot_file, write_count);
+  machine_stats.Reset();
+  WriteBlocks(write_count, write_count, block_count);
+  auto uninterrupted_stats = machine_stats;
+  auto uninterrupted_wear_count = GetNVMWear().GetWriteCount();
+
+
+  EXPECT_GT(uninterrupted_stats.GetFlashRelocatedPageCount(), 0);
+  EXPECT_GT(uninterrupted_wear_count, 0);
+
+  // Resumed run
+  ConfigureMachine(arguments);
+  EXPECT_EQ(LoadSnapshot(state, snapshot_file), write_count);
+  WriteBlocks(write_count, write_count, block_count);
+  std::remove(snapshot_file.c_str());
+
+  EXPECT_EQ(machine_stats.GetFlashHostWriteCount(),
+            uninterrupted_stats.GetFlashHostWriteCount());
+  EXPECT_EQ(machine_stats.GetFlashRelocatedPageCount(),
+            uninterrupted_stats.GetFlashRelocatedPageCount());
+  EXPECT_EQ(machine_stats.GetFlashErasedBlockCount(),
+            uninterrupted_stats.GetFlashErasedBlockCount());
+  EXPECT_DOUBLE_EQ(machine_stats.GetFlashStall(),
+                   uninterrupted_stats.GetFlashStall());
+  EXPECT_EQ(GetNVMWear().GetWriteCount(), uninterrupted_wear_count);
+
+}
+
+TEST(WorkloadTest, SnapshotTruncated) {
+
+  const std::vector<std::string> arguments = {"-a", "4", "-m", "1",
+                                              "--ftl_block_pages", "8"};
+  const std::string snapshot_file = "workload_test.snap";
+
+  ConfigureMachine(arguments);
+  for(size_t block_id = 0; block_id < 1000; block_id++){
+    BootstrapBlock(block_id);
+  }
+  WriteBlocks(0, 2000, 1000);
+  SaveSnapshot(state, snapshot_file, 2000);
+
+  std::ifstream input(snapshot_file, std::ios::binary);
+  std::string snapshot((std::istreambuf_iterator<char>(input)),
+                       std::istreambuf_iterator<char>());
+  input.close();
+
+  // Cut inside the header, the tiers and the last word, and a partial word
+  auto word_count = snapshot.size() / sizeof(uint64_t);
+  std::vector<size_t> file_sizes = {3 * sizeof(uint64_t),
+                                    word_count / 2 * sizeof(uint64_t),
+                                    (word_count - 1) * sizeof(uint64_t),
+                                    snapshot.size() - 1};
+  for(auto file_size : file_sizes){
+    std::ofstream output(snapshot_file, std::ios::binary | std::ios::trunc);
+    output.write(snapshot.data(), file_size);
+    output.close();
+
+    // Fails cleanly instead of reading past the mapping
+    ConfigureMachine(arguments);
+    EXPECT_EXIT(LoadSnapshot(state, snapshot_file),
+                ::testing::ExitedWithCode(EXIT_FAILURE), "");
+  }
+  std::remove(snapshot_file.c_str());
+
+}
+
+}  // End machine namespace